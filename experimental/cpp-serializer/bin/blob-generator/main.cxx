@@ -0,0 +1,147 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "amqp/encoder/Synthetic.h"
+
+/******************************************************************************/
+
+/**
+ * Writes a corpus of synthetic blobs of a given shape, for measuring
+ * throughput and memory against blobs far bigger, deeper and wider than
+ * any we have checked in. The same options and seed always write the
+ * same corpus.
+ */
+
+namespace {
+
+    void
+    usage (const char * exe_) {
+        std::cerr << "usage: " << exe_ << " [options] <directory | ->" << std::endl
+                  << std::endl
+                  << "  --fields <n>   scalar fields per composite (4)" << std::endl
+                  << "  --depth <n>    nested composites (1)" << std::endl
+                  << "  --list <n>     ints in a list per composite (0)" << std::endl
+                  << "  --map <n>      entries in a map per composite (0)" << std::endl
+                  << "  --array <n>    ints in an array per composite (0)" << std::endl
+                  << "  --choices <n>  constants of an enum per composite (0)" << std::endl
+                  << "  --types <n>    pad the schema out to this many types (0)" << std::endl
+                  << "  --string <n>   length of each string (8)" << std::endl
+                  << "  --count <n>    blobs to write (1)" << std::endl
+                  << "  --seed <n>     seed of the first blob, each after adds one (0)" << std::endl
+                  << std::endl
+                  << "Blobs are written to the directory as blob-000000 and so"
+                  << " on, or a single blob to stdout given -" << std::endl;
+    }
+
+    bool
+    number (const char * arg_, size_t & value_) {
+        char * end;
+        value_ = std::strtoull (arg_, &end, 10);
+
+        return *arg_ != '\0' && *end == '\0';
+    }
+
+    std::string
+    name (size_t index_) {
+        std::stringstream ss;
+        ss << "blob-" << std::setw (6) << std::setfill ('0') << index_;
+        return ss.str();
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char ** argv) {
+    amqp::internal::encoder::Shape shape;
+    size_t count { 1 };
+    size_t seed { 0 };
+    std::string out;
+
+    const std::pair<const char *, size_t *> options[] = {
+        { "--fields", &shape.m_fields },
+        { "--depth", &shape.m_depth },
+        { "--list", &shape.m_list },
+        { "--map", &shape.m_map },
+        { "--array", &shape.m_array },
+        { "--choices", &shape.m_choices },
+        { "--types", &shape.m_types },
+        { "--string", &shape.m_string },
+        { "--count", &count },
+        { "--seed", &seed }
+    };
+
+    for (int i { 1 } ; i < argc ; ++i) {
+        bool matched { false };
+
+        for (const auto & option : options) {
+            if (strcmp (argv[i], option.first) == 0 && i + 1 < argc) {
+                matched = number (argv[++i], *option.second);
+
+                if (!matched) break;
+            }
+        }
+
+        if (!matched) {
+            if (out.empty() && (argv[i][0] != '-' || strcmp (argv[i], "-") == 0)) {
+                out = argv[i];
+            } else {
+                usage (argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (out.empty() || (out == "-" && count != 1)) {
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        amqp::internal::encoder::Synthetic synthetic (shape);
+
+        std::string blob;
+        size_t written { 0 };
+
+        for (size_t i { 0 } ; i < count ; ++i) {
+            blob.clear();
+            synthetic.write (blob, seed + i);
+
+            if (out == "-") {
+                std::cout.write (blob.data(), blob.size());
+            } else {
+                if (i == 0) {
+                    ::mkdir (out.c_str(), 0755);
+                }
+
+                std::ofstream file (out + "/" + name (i), std::ios::binary);
+                file.write (blob.data(), blob.size());
+
+                if (!file) {
+                    throw std::runtime_error ("Failed to write " + out + "/" + name (i));
+                }
+            }
+
+            written += blob.size();
+        }
+
+        std::cerr << count << " blobs, " << written << " bytes, "
+                  << synthetic.types() << " types" << std::endl;
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
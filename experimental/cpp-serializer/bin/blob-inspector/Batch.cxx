@@ -0,0 +1,253 @@
+#include "Batch.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <stdexcept>
+
+#include "amqp/AMQPSectionId.h"
+#include "amqp/reader/Json.h"
+#include "amqp/reader/Sink.h"
+#include "amqp/reader/JsonVisitor.h"
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+#include "WorkStealingPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * How many blobs per thread may be decoded but not yet written, enough
+     * to keep every thread busy behind a slow blob without holding more
+     * than a handful of records
+     */
+    constexpr size_t IN_FLIGHT = 4;
+
+}
+
+/******************************************************************************/
+
+std::vector<std::string>
+Batch::paths (const std::string & source_) {
+    if (source_ == "-") {
+        return paths (std::cin);
+    }
+
+    namespace fs = std::filesystem;
+
+    if (fs::is_directory (source_)) {
+        std::vector<std::string> rtn;
+
+        for (const auto & entry : fs::directory_iterator (source_)) {
+            if (entry.is_regular_file()) {
+                rtn.emplace_back (entry.path().string());
+            }
+        }
+
+        std::sort (rtn.begin(), rtn.end());
+
+        return rtn;
+    }
+
+    std::ifstream list { source_ };
+
+    if (!list) {
+        throw std::runtime_error ("Cannot open " + source_);
+    }
+
+    return paths (list);
+}
+
+/******************************************************************************/
+
+/**
+ * One path per line, blank lines are skipped
+ */
+std::vector<std::string>
+Batch::paths (std::istream & in_) {
+    std::vector<std::string> rtn;
+    std::string line;
+
+    while (std::getline (in_, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (!line.empty()) {
+            rtn.emplace_back (std::move (line));
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+Batch::Batch (
+    std::vector<std::string> paths_,
+    std::vector<std::string> select_
+) : m_paths (std::move (paths_))
+  , m_select (std::move (select_))
+{
+}
+
+/******************************************************************************/
+
+/**
+ * Writes a single line of output, a blob that can't be decoded produces an
+ * Error record rather than stopping the batch
+ *
+ * @return true if the blob was decoded
+ */
+bool
+Batch::record (const std::string & path_, std::ostream & out_) const {
+    std::string parsed;
+    std::string error;
+    bool decoded { true };
+
+    try {
+        CordaBytes cb (path_);
+
+        amqp::internal::reader::StringSink sink (parsed);
+        BlobInspector inspector (cb);
+
+        if (m_select.empty()) {
+            inspector.dump ("Parsed", sink);
+        } else {
+            for (const auto & path : m_select) {
+                if (!parsed.empty()) sink << ", ";
+
+                amqp::internal::reader::JsonVisitor visitor (sink);
+                inspector.select (path, visitor);
+            }
+        }
+    } catch (const std::exception & e) {
+        error = e.what();
+        decoded = false;
+    }
+
+    out_ << "{ File : " << amqp::internal::reader::json::quote (path_) << ", ";
+
+    if (decoded) {
+        out_ << parsed;
+    } else {
+        out_ << "Error : " << amqp::internal::reader::json::quote (error);
+    }
+
+    out_ << " }\n";
+
+    return decoded;
+}
+
+/******************************************************************************/
+
+/**
+ * @return the number of blobs that failed to decode
+ */
+size_t
+Batch::run (std::ostream & out_) const {
+    size_t failures { 0 };
+
+    for (const auto & path : m_paths) {
+        if (!record (path, out_)) {
+            ++failures;
+        }
+    }
+
+    out_.flush();
+
+    return failures;
+}
+
+/******************************************************************************/
+
+/**
+ * Decode across a pool of threads. Records are still written in the
+ * order the blobs were supplied, each one as soon as it and everything
+ * before it has been decoded, so output is identical to a serial run.
+ *
+ * Only IN_FLIGHT blobs a thread are submitted ahead of the last record
+ * written, the rest as records are written, so memory is bounded by
+ * the pool rather than the batch and the first record isn't held up
+ * behind the whole batch. Records wait in a ring of that many slots.
+ *
+ * @return the number of blobs that failed to decode
+ */
+size_t
+Batch::run (std::ostream & out_, size_t threads_) const {
+    if (threads_ <= 1) {
+        return run (out_);
+    }
+
+    const size_t window = threads_ * IN_FLIGHT;
+
+    std::vector<std::string> records (window);
+    std::vector<bool> ready (window, false);
+    size_t next { 0 };
+    std::mutex lock;
+    std::condition_variable written;
+
+    std::atomic<size_t> failures { 0 };
+
+    /*
+     * Every slot must be filled, even by a task that throws, or nothing
+     * after it would ever be written nor the loop below move on
+     */
+    auto deliver = [&](size_t i_, std::string record_) {
+        std::lock_guard<std::mutex> l (lock);
+
+        records[i_ % window] = std::move (record_);
+        ready[i_ % window] = true;
+
+        const auto from = next;
+
+        for ( ; next < m_paths.size() && ready[next % window] ; ++next) {
+            out_ << records[next % window];
+            std::string().swap (records[next % window]);
+            ready[next % window] = false;
+        }
+
+        if (next != from) {
+            written.notify_one();
+        }
+    };
+
+    WorkStealingPool pool (threads_);
+
+    for (size_t i { 0 } ; i < m_paths.size() ; ++i) {
+        {
+            std::unique_lock<std::mutex> l (lock);
+            written.wait (l, [&] { return i - next < window; });
+        }
+
+        pool.submit ([&, i]() {
+            std::stringstream ss;
+
+            try {
+                if (!record (m_paths[i], ss)) {
+                    ++failures;
+                }
+            } catch (...) {
+                deliver (i, { });
+                throw;
+            }
+
+            deliver (i, ss.str());
+        });
+    }
+
+    pool.wait();
+
+    out_.flush();
+
+    return failures;
+}
+
+/******************************************************************************/
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/******************************************************************************/
+
+/**
+ * Decodes a set of blobs in a single process, writing one record per
+ * blob per line (newline delimited JSON) so a large vault extract can be
+ * inspected without paying process start up and descriptor registry set
+ * up for every file.
+ *
+ * Records are emitted in the order the blobs were supplied, directories
+ * are walked in lexicographic order so the output is deterministic.
+ *
+ * Given a set of dotted field paths each record holds just those fields
+ * rather than the whole blob, see BlobInspector::select.
+ */
+class Batch {
+    private :
+        std::vector<std::string> m_paths;
+        std::vector<std::string> m_select;
+
+    public :
+        /**
+         * A directory is expanded to the regular files within it, "-"
+         * reads paths from stdin, anything else is treated as a file
+         * holding one path per line
+         */
+        static std::vector<std::string> paths (const std::string &);
+        static std::vector<std::string> paths (std::istream &);
+
+        explicit Batch (
+            std::vector<std::string>,
+            std::vector<std::string> = { });
+
+        bool record (const std::string &, std::ostream &) const;
+
+        size_t run (std::ostream &) const;
+        size_t run (std::ostream &, size_t) const;
+
+        const std::vector<std::string> & blobs() const { return m_paths; }
+};
+
+/******************************************************************************/
@@ -1,73 +1,328 @@
 #include "BlobInspector.h"
 #include "CordaBytes.h"
 
+#include <optional>
 #include <iostream>
 #include <sstream>
+#include <cassert>
+#include <stdexcept>
 
 #include "proton/codec.h"
 #include "proton/proton_wrapper.h"
 
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 
-#include "amqp/CompositeFactory.h"
-#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/SchemaCache.h"
+#include "amqp/reader/Sink.h"
+#include "amqp/reader/Profile.h"
+#include "amqp/reader/Recorder.h"
+#include "amqp/reader/JsonVisitor.h"
+#include "amqp/schema/Descriptors.h"
 
 /******************************************************************************/
 
-BlobInspector::BlobInspector (CordaBytes & cb_)
-    : m_data { pn_data (cb_.size()) }
+BlobInspector::BlobInspector (const CordaBytes & cb_)
+    : m_bytes { cb_.payload() }
+    , m_data { nullptr }
+    , m_references { amqp::internal::decoder::mayReference (m_bytes) }
+    , m_cursor { m_bytes }
+    , m_entry { nullptr }
+    , m_program { nullptr }
 {
-    // returns how many bytes we processed which right now we don't care
-    // about but I assume there is a case where it doesn't process the
-    // entire file
-    auto rtn = pn_data_decode (m_data, cb_.bytes(), cb_.size());
-    assert (rtn == cb_.size());
+}
+
+/******************************************************************************/
+
+BlobInspector::~BlobInspector() {
+    if (m_data) {
+        pn_data_free (m_data);
+    }
 }
 
 /******************************************************************************/
 
 std::string
 BlobInspector::dump() {
-    std::unique_ptr<amqp::internal::schema::Envelope> envelope;
+    std::string rtn;
+    amqp::internal::reader::StringSink sink (rtn);
 
-    if (pn_data_is_described (m_data)) {
-        proton::auto_enter p (m_data);
+    dump (sink);
 
-        auto a = pn_data_get_ulong(m_data);
+    return rtn;
+}
 
-        envelope.reset (
-                dynamic_cast<amqp::internal::schema::Envelope *> (
-                        amqp::internal::AMQPDescriptorRegistory[a]->build(m_data).release()));
+/******************************************************************************/
+
+/**
+ * We wrap our output in an object to make sure it's valid JSON to
+ * facilitate easy pretty printing
+ */
+void
+BlobInspector::dump (amqp::reader::ISink & sink_) {
+    amqp::internal::reader::JsonVisitor visitor (sink_);
+
+    visit (visitor);
+}
+
+/******************************************************************************/
+
+std::string
+BlobInspector::dump (const std::string & name_) {
+    std::string rtn;
+    amqp::internal::reader::StringSink sink (rtn);
+
+    dump (name_, sink);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * Decode the blob as a single name : value pair, callers are responsible
+ * for wrapping it in whatever they're emitting
+ */
+void
+BlobInspector::dump (const std::string & name_, amqp::reader::ISink & sink_) {
+    amqp::internal::reader::JsonVisitor visitor (sink_);
+
+    visit (name_, visitor);
+}
+
+/******************************************************************************/
+
+/**
+ * The envelope is a list of the blob itself, the schema and the
+ * transforms. We want the blob's descriptor and the readers for the
+ * schema, the latter coming from the cache whenever we've seen an
+ * identical schema before so we skip building it altogether
+ */
+void
+BlobInspector::resolve() {
+    if (m_reader) {
+        return;
     }
 
-    amqp::internal::CompositeFactory cf;
+    namespace decoder = amqp::internal::decoder;
 
-    cf.process (envelope->schema());
+    decoder::Cursor cursor (m_bytes);
+    cursor.next();
 
-    auto reader = cf.byDescriptor (envelope->descriptor());
-    assert (reader);
+    if (cursor.type() != decoder::Type::described_t) {
+        throw std::runtime_error ("Blob is not a described envelope");
+    }
 
     {
-        // move to the actual blob entry in the tree - ideally we'd have
-        // saved this on the Envelope but that's not easily doable as we
-        // can't grab an actual copy of our data pointer
-        proton::auto_enter p (m_data);
-        pn_data_next (m_data);
-        proton::is_list (m_data);
-        assert (pn_data_get_list (m_data) == 3);
-        {
-            proton::auto_enter p (m_data);
+        decoder::auto_enter p (cursor);
 
-            std::stringstream ss;
+        if (amqp::stripCorda (cursor.getUlong())
+                != amqp::schema::descriptors::ENVELOPE)
+        {
+            throw std::runtime_error ("Blob is not a described envelope");
+        }
 
-            // We wrap our output like this to make sure it's valid JSON to
-            // facilitate easy pretty printing
-            ss << reader->dump ("{ Parsed", m_data, envelope->schema())->dump()
-               << " }";
+        cursor.next();
+        decoder::is_list (cursor);
+        assert (cursor.listCount() == 3);
 
-            return ss.str();
+        decoder::auto_list_enter ale (cursor, true);
+        {
+            decoder::is_described (cursor);
+            decoder::auto_enter p2 (cursor);
+            decoder::is_symbol (cursor);
+            m_descriptor = cursor.getSymbol();
         }
+
+        cursor.next();
+
+        m_entry = &amqp::internal::SchemaCache::instance().fetch (cursor);
     }
+
+    m_reader = m_entry->byDescriptor (m_descriptor);
+
+    if (!m_reader) {
+        throw std::runtime_error ("No reader for " + m_descriptor);
+    }
+
+    m_program = &m_entry->program (m_descriptor);
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::visit (amqp::reader::IVisitor & visitor_) {
+    visitor_.startObject();
+    visit ("Parsed", visitor_);
+    visitor_.endObject();
+}
+
+/******************************************************************************/
+
+/**
+ * Name the blob as a field and then walk it, the descriptor and schema
+ * were dealt with by resolve so this touches nothing but the payload.
+ *
+ * Programs flatten the readers away so when profiling, which times each
+ * reader, we walk the readers instead.
+ */
+void
+BlobInspector::visit (const std::string & name_, amqp::reader::IVisitor & visitor_) {
+    resolve();
+
+    visitor_.field (name_);
+
+    payload();
+
+    std::optional<amqp::internal::reader::Recorder> recorder;
+    auto & visitor = m_references ? recorder.emplace (visitor_) : visitor_;
+
+    if (amqp::internal::reader::Profile::enabled()) {
+        m_reader->visit (m_cursor, m_entry->schema(), visitor);
+    } else {
+        m_program->run (m_cursor, m_entry->schema(), visitor);
+    }
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::walk (amqp::reader::IVisitor & visitor_) {
+    resolve();
+
+    visitor_.startObject();
+    visitor_.field ("Parsed");
+
+    payload();
+
+    std::optional<amqp::internal::reader::Recorder> recorder;
+    auto & visitor = m_references ? recorder.emplace (visitor_) : visitor_;
+
+    m_reader->visit (m_cursor, m_entry->schema(), visitor);
+
+    visitor_.endObject();
+}
+
+/******************************************************************************/
+
+/**
+ * The envelope is described so rewinding and entering twice puts us on
+ * the first element of its list. Nothing needs undoing afterwards as
+ * the next walk rewinds first anyway.
+ */
+void
+BlobInspector::payload() {
+    m_cursor.rewind();
+    m_cursor.next();
+    m_cursor.enter();
+    m_cursor.next();
+    m_cursor.next();
+    m_cursor.enter();
+    m_cursor.next();
+}
+
+/******************************************************************************/
+
+std::string
+BlobInspector::select (const std::vector<std::string> & paths_) {
+    std::string rtn;
+    amqp::internal::reader::StringSink sink (rtn);
+    amqp::internal::reader::JsonVisitor visitor (sink);
+
+    select (paths_, visitor);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::select (
+    const std::vector<std::string> & paths_,
+    amqp::reader::IVisitor & visitor_
+) {
+    visitor_.startObject();
+    for (const auto & path : paths_) {
+        select (path, visitor_);
+    }
+    visitor_.endObject();
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::select (const std::string & path_, amqp::reader::IVisitor & visitor_) {
+    resolve();
+
+    const auto & projection = m_entry->select (m_descriptor, path_);
+
+    visitor_.field (path_);
+
+    payload();
+
+    projection.visit (m_cursor, m_entry->schema(), visitor_);
+}
+
+/******************************************************************************/
+
+/**
+ * Decode the blob into a tree of values rather than walking it, this
+ * is the one path that still needs the whole blob as a proton tree
+ */
+std::unique_ptr<amqp::reader::IValue>
+BlobInspector::value (const std::string & name_) {
+    resolve();
+
+    if (!m_data) {
+        m_data = pn_data (m_bytes.size());
+
+        // returns how many bytes we processed which right now we don't care
+        // about but I assume there is a case where it doesn't process the
+        // entire file
+        auto rtn = pn_data_decode (m_data, m_bytes.data(), m_bytes.size());
+        assert (rtn == static_cast<ssize_t>(m_bytes.size()));
+    } else {
+        pn_data_rewind (m_data);
+        pn_data_next (m_data);
+    }
+
+    proton::auto_enter p (m_data);
+    pn_data_next (m_data);
+    {
+        proton::auto_enter p (m_data);
+
+        return m_reader->dump (name_, m_data, m_entry->schema());
+    }
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::generate (amqp::internal::codegen::Generator & generator_) {
+    resolve();
+
+    generator_.add (*m_entry, m_descriptor);
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::columns (amqp::internal::columnar::Columns & columns_) {
+    resolve();
+
+    columns_.type (*m_reader, m_descriptor);
+
+    visit ("Parsed", columns_);
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Pull
+BlobInspector::pull() {
+    resolve();
+
+    payload();
+
+    return amqp::internal::reader::Pull (*m_reader, m_cursor);
 }
 
 /******************************************************************************/
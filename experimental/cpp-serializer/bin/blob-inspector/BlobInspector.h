@@ -1,22 +1,119 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
 #include "CordaBytes.h"
 
+#include "amqp/SchemaCache.h"
+#include "amqp/codegen/Generator.h"
+#include "amqp/columnar/Columns.h"
+#include "amqp/decoder/Cursor.h"
+#include "amqp/reader/ISink.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/reader/Pull.h"
+
 /******************************************************************************/
 
 struct pn_data_t;
 
 /******************************************************************************/
 
+/**
+ * Walks the blob's encoded bytes in place, so the CordaBytes it's built
+ * from must outlive it. A proton tree is only decoded if the blob is
+ * asked for as a tree of values.
+ */
 class BlobInspector {
     private :
+        std::string_view m_bytes;
         pn_data_t * m_data;
 
+        /**
+         * Whether the blob might refer back to objects within it, walks
+         * record what they visit so those can be replayed if so
+         */
+        bool m_references;
+
+        /**
+         * Kept between walks so its stack is only ever allocated once
+         */
+        amqp::internal::decoder::Cursor m_cursor;
+
+        /**
+         * Resolved from the envelope the first time we're asked to decode
+         * the blob, after which we can walk it again for free
+         */
+        amqp::internal::SchemaCache::Entry * m_entry;
+        std::shared_ptr<amqp::internal::CompositeFactory::ReaderType> m_reader;
+        const amqp::internal::reader::Program * m_program;
+        std::string m_descriptor;
+
+        /**
+         * Position the cursor on the blob itself within the envelope
+         */
+        void payload();
+
     public :
-        BlobInspector (CordaBytes &);
+        BlobInspector (const CordaBytes &);
+
+        BlobInspector (const BlobInspector &) = delete;
+        BlobInspector & operator = (const BlobInspector &) = delete;
+
+        ~BlobInspector();
+
+        /**
+         * Find the blob's type and the readers for it, putting its schema
+         * in the cache if it's not there already. Done the first time the
+         * blob's decoded but also of use to prime the cache ahead of
+         * streaming blobs of the same type.
+         */
+        void resolve();
 
         std::string dump();
+        std::string dump (const std::string &);
+
+        void dump (amqp::reader::ISink &);
+        void dump (const std::string &, amqp::reader::ISink &);
+
+        void visit (amqp::reader::IVisitor &);
+        void visit (const std::string &, amqp::reader::IVisitor &);
+
+        /**
+         * As visit but walking the graph of readers rather than running
+         * the program compiled from them, the reference the programs
+         * are checked and measured against
+         */
+        void walk (amqp::reader::IVisitor &);
+
+        /**
+         * Visit just the fields at the given dotted paths, each named by
+         * its path, decoding nothing else
+         */
+        std::string select (const std::vector<std::string> &);
+        void select (const std::vector<std::string> &, amqp::reader::IVisitor &);
+        void select (const std::string &, amqp::reader::IVisitor &);
+
+        std::unique_ptr<amqp::reader::IValue> value (const std::string &);
+
+        /**
+         * Add the blob's type, and everything it uses, to the generator
+         */
+        void generate (amqp::internal::codegen::Generator &);
+
+        /**
+         * Append the blob as a row of the columns, laying them out for
+         * its type if it's the first
+         */
+        void columns (amqp::internal::columnar::Columns &);
+
+        /**
+         * Pull the payload's values straight off the blob, the returned
+         * Pull being finished with before anything else is asked of us
+         */
+        amqp::internal::reader::Pull pull();
 
 };
 
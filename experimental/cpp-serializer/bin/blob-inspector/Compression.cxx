@@ -0,0 +1,338 @@
+#include "Compression.h"
+
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include <zlib.h>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Output buffers start at a guess of how well things compress and
+     * double from there
+     */
+    constexpr size_t EXPANSION = 4;
+    constexpr size_t MIN_OUTPUT = 4096;
+
+    /**
+     * One per thread, set up the first time a thread inflates anything
+     */
+    class Inflater {
+        private :
+            z_stream m_stream;
+
+        public :
+            Inflater() : m_stream { } {
+                if (inflateInit (&m_stream) != Z_OK) {
+                    throw std::runtime_error ("Failed to initialise zlib");
+                }
+            }
+
+            Inflater (const Inflater &) = delete;
+            Inflater & operator = (const Inflater &) = delete;
+
+            ~Inflater() {
+                inflateEnd (&m_stream);
+            }
+
+            static Inflater & local() {
+                thread_local Inflater inflater;
+                return inflater;
+            }
+
+            void inflate (std::string_view, std::string &);
+    };
+
+    /**
+     * zlib counts in 32 bits so anything bigger is handed over in pieces
+     */
+    uInt
+    clamp (size_t size_) {
+        return static_cast<uInt>(std::min<size_t> (
+                size_, std::numeric_limits<uInt>::max()));
+    }
+
+}
+
+/******************************************************************************/
+
+void
+Inflater::inflate (std::string_view in_, std::string & out_) {
+    if (inflateReset (&m_stream) != Z_OK) {
+        throw std::runtime_error ("Failed to reset zlib");
+    }
+
+    out_.resize (std::max (in_.size() * EXPANSION, MIN_OUTPUT));
+
+    const auto * in = reinterpret_cast<const Bytef *>(in_.data());
+    size_t consumed { 0 };
+    size_t produced { 0 };
+
+    for (;;) {
+        if (produced == out_.size()) {
+            out_.resize (out_.size() * 2);
+        }
+
+        m_stream.next_in = const_cast<Bytef *>(in + consumed);
+        m_stream.avail_in = clamp (in_.size() - consumed);
+        m_stream.next_out = reinterpret_cast<Bytef *>(&out_[produced]);
+        m_stream.avail_out = clamp (out_.size() - produced);
+
+        const auto availIn = m_stream.avail_in;
+        const auto availOut = m_stream.avail_out;
+
+        const auto rtn = ::inflate (&m_stream, Z_NO_FLUSH);
+
+        consumed += availIn - m_stream.avail_in;
+        produced += availOut - m_stream.avail_out;
+
+        if (rtn == Z_STREAM_END) {
+            break;
+        }
+
+        if (rtn == Z_BUF_ERROR && consumed == in_.size()) {
+            throw std::runtime_error ("Truncated DEFLATE stream");
+        }
+
+        if (rtn != Z_OK && rtn != Z_BUF_ERROR) {
+            throw std::runtime_error ("Corrupt DEFLATE stream");
+        }
+    }
+
+    out_.resize (produced);
+}
+
+/******************************************************************************
+ *
+ * Snappy
+ *
+ ******************************************************************************/
+
+namespace {
+
+    const std::string_view SNAPPY_MAGIC { "sNaPpY" };
+
+    /**
+     * The framing format caps what a chunk holds once uncompressed
+     */
+    constexpr size_t SNAPPY_CHUNK = 65536;
+
+    /**
+     * Reads within a chunk, throwing rather than running off its end
+     */
+    class Reader {
+        private :
+            const uint8_t * m_next;
+            const uint8_t * m_end;
+
+        public :
+            explicit Reader (std::string_view bytes_)
+                : m_next (reinterpret_cast<const uint8_t *>(bytes_.data()))
+                , m_end (m_next + bytes_.size())
+            { }
+
+            size_t remaining() const { return m_end - m_next; }
+
+            const uint8_t * take (size_t size_) {
+                if (size_ > remaining()) {
+                    throw std::runtime_error ("Truncated snappy stream");
+                }
+
+                auto rtn = m_next;
+                m_next += size_;
+                return rtn;
+            }
+
+            /**
+             * Little endian, [size_] bytes
+             */
+            size_t le (size_t size_) {
+                auto bytes = take (size_);
+                size_t rtn { 0 };
+
+                for (size_t i { 0 } ; i < size_ ; ++i) {
+                    rtn |= static_cast<size_t>(bytes[i]) << (8 * i);
+                }
+
+                return rtn;
+            }
+
+            size_t varint() {
+                size_t rtn { 0 };
+
+                for (size_t shift { 0 } ; shift < 35 ; shift += 7) {
+                    auto byte = *take (1);
+                    rtn |= static_cast<size_t>(byte & 0x7f) << shift;
+
+                    if (!(byte & 0x80)) {
+                        return rtn;
+                    }
+                }
+
+                throw std::runtime_error ("Malformed snappy length");
+            }
+    };
+
+    /**
+     * A raw snappy block. It leads with its uncompressed length so the
+     * output is sized once, up front, and each literal and copy written
+     * straight to where it belongs. The length is checked against what
+     * a chunk can hold before anything is sized by it.
+     */
+    void
+    unsnappy (std::string_view block_, std::string & out_) {
+        Reader block (block_);
+
+        const auto length = block.varint();
+
+        if (length > SNAPPY_CHUNK) {
+            throw std::runtime_error ("Malformed snappy length");
+        }
+
+        const auto start = out_.size();
+
+        out_.resize (start + length);
+
+        auto * out = reinterpret_cast<uint8_t *>(&out_[start]);
+        size_t produced { 0 };
+
+        while (block.remaining()) {
+            const auto tag = *block.take (1);
+
+            size_t size;
+            size_t offset;
+
+            switch (tag & 0x03) {
+                case 0x00 : {
+                    size = tag >> 2u;
+                    if (size >= 60) {
+                        size = block.le (size - 59);
+                    }
+                    ++size;
+
+                    if (size > length - produced) {
+                        throw std::runtime_error ("Malformed snappy literal");
+                    }
+
+                    std::memcpy (out + produced, block.take (size), size);
+                    produced += size;
+                    continue;
+                }
+                case 0x01 :
+                    size = 4 + ((tag >> 2u) & 0x07);
+                    offset = (static_cast<size_t>(tag >> 5u) << 8u) | block.le (1);
+                    break;
+                case 0x02 :
+                    size = 1 + (tag >> 2u);
+                    offset = block.le (2);
+                    break;
+                default :
+                    size = 1 + (tag >> 2u);
+                    offset = block.le (4);
+                    break;
+            }
+
+            if (offset == 0 || offset > produced || size > length - produced) {
+                throw std::runtime_error ("Malformed snappy copy");
+            }
+
+            // copies may overlap what they're writing, so byte by byte
+            for (size_t i { 0 } ; i < size ; ++i, ++produced) {
+                out[produced] = out[produced - offset];
+            }
+        }
+
+        if (produced != length) {
+            throw std::runtime_error ("Truncated snappy block");
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * compression
+ *
+ ******************************************************************************/
+
+void
+compression::deflate (std::string_view in_, std::string & out_) {
+    Inflater::local().inflate (in_, out_);
+}
+
+/******************************************************************************/
+
+/**
+ * A sequence of chunks, each a type byte and a 3 byte length. We care
+ * about the stream identifier and the compressed and uncompressed data
+ * chunks, both of which lead with a 4 byte checksum. Anything else is
+ * padding or reserved as skippable.
+ */
+void
+compression::snappy (std::string_view in_, std::string & out_) {
+    Reader stream (in_);
+
+    out_.clear();
+    out_.reserve (in_.size() * EXPANSION);
+
+    bool identified { false };
+
+    while (stream.remaining()) {
+        const auto type = *stream.take (1);
+        const auto size = stream.le (3);
+        const auto * chunk = reinterpret_cast<const char *>(stream.take (size));
+
+        if (type == 0xff) {
+            if (std::string_view (chunk, size) != SNAPPY_MAGIC) {
+                throw std::runtime_error ("Not a snappy stream");
+            }
+
+            identified = true;
+            continue;
+        }
+
+        if (!identified) {
+            throw std::runtime_error ("Not a snappy stream");
+        }
+
+        if (type == 0x00 || type == 0x01) {
+            if (size < 4) {
+                throw std::runtime_error ("Truncated snappy chunk");
+            }
+
+            std::string_view data { chunk + 4, size - 4 };
+
+            if (type == 0x00) {
+                unsnappy (data, out_);
+            } else {
+                out_.append (data);
+            }
+        } else if (type < 0x80) {
+            throw std::runtime_error ("Unknown snappy chunk");
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+compression::decompress (
+    amqp::corda_encoding_t encoding_,
+    std::string_view in_,
+    std::string & out_
+) {
+    switch (encoding_) {
+        case amqp::DEFLATE : deflate (in_, out_); break;
+        case amqp::SNAPPY  : snappy (in_, out_); break;
+        default :
+            throw std::runtime_error (
+                    "Unknown encoding " + std::to_string (encoding_));
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "amqp/AMQPSectionId.h"
+
+/******************************************************************************/
+
+/**
+ * Undoes the compression Corda applies to everything following an
+ * ENCODING section. What's decompressed is the rest of the stream, so
+ * starts with the section id of the data it holds.
+ *
+ * Output is written straight into [out_], grown as needed and trimmed to
+ * what was written, so it can be handed to the decoder as is. Nothing is
+ * decompressed into a scratch buffer first.
+ */
+namespace compression {
+
+    /**
+     * A zlib stream as java.util.zip's InflaterInputStream reads it. The
+     * inflater is kept per thread and reset between blobs rather than set
+     * up and torn down for each.
+     */
+    void deflate (std::string_view, std::string & out_);
+
+    /**
+     * The framed format org.iq80.snappy's SnappyFramedOutputStream writes
+     * and SnappyFramedInputStream reads. Corda doesn't have it verify the
+     * checksums so neither do we.
+     */
+    void snappy (std::string_view, std::string & out_);
+
+    void decompress (amqp::corda_encoding_t, std::string_view, std::string & out_);
+
+}
+
+/******************************************************************************/
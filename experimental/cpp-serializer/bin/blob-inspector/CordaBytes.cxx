@@ -1,38 +1,177 @@
 #include "CordaBytes.h"
 
 #include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+
+#include "Compression.h"
+
 #include "amqp/AMQPHeader.h"
 
 /******************************************************************************/
 
+namespace {
+
+    /**
+     * Closes the file descriptor once we've mapped (or failed to map) it,
+     * the mapping itself keeps the file alive
+     */
+    struct AutoClose {
+        int m_fd;
+
+        explicit AutoClose (int fd_) : m_fd (fd_) { }
+
+        ~AutoClose() {
+            if (m_fd >= 0) ::close (m_fd);
+        }
+    };
+
+}
+
+/******************************************************************************/
+
 CordaBytes::CordaBytes (const std::string & file_)
-    : m_blob { nullptr }
+    : m_encoding { amqp::DATA_AND_STOP }
+    , m_size { 0 }
+    , m_blob { nullptr }
+    , m_mapping { nullptr }
+    , m_mappingSize { 0 }
+    , m_compressed { false }
 {
-    std::ifstream file { file_, std::ios::in | std::ios::binary };
+    AutoClose fd { ::open (file_.c_str(), O_RDONLY) };
     struct stat results { };
 
-    if (::stat(file_.c_str(), &results) != 0) {
+    if (fd.m_fd < 0 || ::fstat (fd.m_fd, &results) != 0) {
         throw std::runtime_error ("Not a file");
     }
 
-    // Disregard the Corda header
-    m_size = results.st_size - (amqp::AMQP_HEADER.size() + 1);
+    if (!S_ISREG(results.st_mode)
+        || static_cast<size_t>(results.st_size) < amqp::AMQP_HEADER.size() + 1)
+    {
+        throw std::runtime_error ("Not a Corda stream");
+    }
 
-    std::array<char, 7> header { };
-    file.read (header.data(), 7);
+    m_mappingSize = results.st_size;
 
-    if (header != amqp::AMQP_HEADER) {
-        throw std::runtime_error ("Not a Corda stream");
+    m_mapping = ::mmap (nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, fd.m_fd, 0);
+
+    if (m_mapping == MAP_FAILED) {
+        m_mapping = nullptr;
+        throw std::runtime_error ("Failed to map " + file_);
     }
 
-    file.read (reinterpret_cast<char *>(&m_encoding), 1);
+    // we walk blobs front to back exactly once
+    ::madvise (m_mapping, m_mappingSize, MADV_SEQUENTIAL);
 
-    m_blob = new char[m_size];
+    try {
+        parseHeader (static_cast<const char *>(m_mapping), m_mappingSize);
+    } catch (...) {
+        ::munmap (m_mapping, m_mappingSize);
+        throw;
+    }
+}
 
-    memset (m_blob, 0, m_size);
-    file.read (m_blob, m_size);
+/******************************************************************************/
+
+CordaBytes::CordaBytes (const char * bytes_, size_t size_)
+    : m_encoding { amqp::DATA_AND_STOP }
+    , m_size { 0 }
+    , m_blob { nullptr }
+    , m_mapping { nullptr }
+    , m_mappingSize { 0 }
+    , m_compressed { false }
+{
+    parseHeader (bytes_, size_);
 }
 
 /******************************************************************************/
 
+CordaBytes::CordaBytes (CordaBytes && other_) noexcept
+    : m_encoding { other_.m_encoding }
+    , m_size { other_.m_size }
+    , m_blob { other_.m_blob }
+    , m_mapping { other_.m_mapping }
+    , m_mappingSize { other_.m_mappingSize }
+    , m_compressed { other_.m_compressed }
+{
+    // a short enough string is moved by copying, so repoint into ours
+    if (m_compressed) {
+        auto offset = other_.m_blob - other_.m_inflated.data();
+        m_inflated = std::move (other_.m_inflated);
+        m_blob = m_inflated.data() + offset;
+    }
+
+    other_.m_mapping = nullptr;
+    other_.m_blob = nullptr;
+    other_.m_size = 0;
+}
+
+/******************************************************************************/
+
+CordaBytes::~CordaBytes() {
+    if (m_mapping) {
+        ::munmap (m_mapping, m_mappingSize);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The 7 byte Corda magic is followed by a single byte section id, what's
+ * left is the payload.
+ *
+ * Unless the section is an ENCODING, in which case the next byte says how
+ * everything after it was compressed. Decompressed that starts again with
+ * a section id, followed by the payload.
+ */
+void
+CordaBytes::parseHeader (const char * bytes_, size_t size_) {
+    const auto headerSize = amqp::AMQP_HEADER.size();
+
+    if (size_ < headerSize + 1) {
+        throw std::runtime_error ("Not a Corda stream");
+    }
+
+    if (std::memcmp (bytes_, amqp::AMQP_HEADER.data(), headerSize) != 0) {
+        throw std::runtime_error ("Not a Corda stream");
+    }
+
+    m_encoding = static_cast<amqp::amqp_section_id_t>(bytes_[headerSize]);
+
+    // Disregard the Corda header
+    m_blob = bytes_ + headerSize + 1;
+    m_size = size_ - (headerSize + 1);
+
+    if (m_encoding == amqp::ENCODING) {
+        if (m_size < 1) {
+            throw std::runtime_error ("Not a Corda stream");
+        }
+
+        compression::decompress (
+                static_cast<amqp::corda_encoding_t>(m_blob[0]),
+                { m_blob + 1, m_size - 1 },
+                m_inflated);
+
+        m_compressed = true;
+
+        if (m_inflated.empty()) {
+            throw std::runtime_error ("Not a Corda stream");
+        }
+
+        m_encoding = static_cast<amqp::amqp_section_id_t>(m_inflated[0]);
+        m_blob = m_inflated.data() + 1;
+        m_size = m_inflated.size() - 1;
+    }
+
+    if (m_encoding != amqp::DATA_AND_STOP && m_encoding != amqp::ALT_DATA_AND_STOP) {
+        throw std::runtime_error (
+                "Unsupported section " + std::to_string (m_encoding));
+    }
+}
+
+/******************************************************************************/
@@ -1,23 +1,57 @@
 #pragma once
 
-#include "string"
-#include <fstream>
+#include <string>
+#include <string_view>
+
 #include "amqp/AMQPSectionId.h"
 
 /******************************************************************************/
 
+/**
+ * A read only view of a Corda serialised blob with the Corda header
+ * stripped off. Files are memory mapped rather than read so the payload
+ * handed to the decoder is never copied onto the heap. Bytes already held
+ * in memory by the caller can be wrapped directly, in which case the
+ * caller must keep them alive for the lifetime of this object.
+ *
+ * A compressed blob, one with an ENCODING section, is decompressed as
+ * it's opened into a buffer we own, and the payload is a view of that.
+ * Either way encoding() is then the section the payload was found in,
+ * DATA_AND_STOP or ALT_DATA_AND_STOP, anything else having been rejected.
+ */
 class CordaBytes {
     private :
         amqp::amqp_section_id_t m_encoding;
         size_t m_size;
-        char * m_blob;
+        const char * m_blob;
+
+        /**
+         * Set when we own a mapping of a file, the mapping covers the
+         * Corda header as well as the payload
+         */
+        void * m_mapping;
+        size_t m_mappingSize;
+
+        /**
+         * Set when the blob was compressed, holds the decompressed stream
+         * the payload is a view of
+         */
+        std::string m_inflated;
+        bool m_compressed;
+
+        void parseHeader (const char *, size_t);
 
     public :
         explicit CordaBytes (const std::string &);
 
-        ~CordaBytes() {
-            delete [] m_blob;
-        }
+        CordaBytes (const char *, size_t);
+
+        CordaBytes (const CordaBytes &) = delete;
+        CordaBytes & operator = (const CordaBytes &) = delete;
+
+        CordaBytes (CordaBytes &&) noexcept;
+
+        ~CordaBytes();
 
         const decltype (m_encoding) & encoding() const {
             return m_encoding;
@@ -25,7 +59,11 @@ class CordaBytes {
 
         decltype (m_size) size() const { return m_size; }
 
-        const char * const bytes() const { return m_blob; }
+        bool compressed() const { return m_compressed; }
+
+        const char * bytes() const { return m_blob; }
+
+        std::string_view payload() const { return { m_blob, m_size }; }
 };
 
 /******************************************************************************/
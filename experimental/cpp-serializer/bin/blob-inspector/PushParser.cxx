@@ -0,0 +1,342 @@
+#include "PushParser.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/decoder/Cursor.h"
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    size_t
+    be (std::string_view bytes_, size_t width_) {
+        size_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < width_ ; ++i) {
+            rtn = (rtn << 8u) | static_cast<uint8_t>(bytes_[i]);
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+PushParser::PushParser (amqp::reader::IVisitor & visitor_, size_t capacity_)
+    : m_visitor (visitor_)
+    , m_window (capacity_)
+    , m_capacity (capacity_)
+    , m_state (State::header)
+    , m_wanted (0)
+    , m_end (0)
+    , m_entry (nullptr)
+{
+}
+
+/******************************************************************************/
+
+/**
+ * Never take more of the chunk than the window has room for, parsing
+ * between helpings, so a big chunk doesn't grow the window any more
+ * than lots of little ones would.
+ *
+ * A stream holds one blob, so anything after its end, whether it came
+ * in the same chunk or a later one, is an error.
+ */
+void
+PushParser::feed (std::string_view chunk_) {
+    while (!chunk_.empty()) {
+        if (done()) {
+            throw std::runtime_error ("Bytes after the end of the blob");
+        }
+
+        const auto room = std::max (m_capacity, m_wanted) - m_window.size();
+        const auto take = std::min (room, chunk_.size());
+
+        m_window.append (chunk_.substr (0, take));
+        chunk_.remove_prefix (take);
+
+        if (parse() && m_window.size() != 0) {
+            throw std::runtime_error ("Bytes after the end of the blob");
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+PushParser::finish() {
+    if (!done()) {
+        throw std::runtime_error ("Blob ended early");
+    }
+
+    if (m_window.size() != 0) {
+        throw std::runtime_error ("Bytes after the end of the blob");
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Each state either moves us on or notes what it's waiting for in
+ * m_wanted, by which time the window can't hold it
+ */
+bool
+PushParser::parse() {
+    for (;;) {
+        bool more;
+
+        switch (m_state) {
+            case State::header     : more = header(); break;
+            case State::envelope   : more = envelope(); break;
+            case State::descriptor : more = descriptor(); break;
+            case State::streaming  : more = streaming(); break;
+            case State::buffering  : more = buffering(); break;
+            case State::trailer    : more = trailer(); break;
+            case State::done       : return true;
+        }
+
+        if (!more) {
+            return false;
+        }
+    }
+}
+
+/******************************************************************************/
+
+bool
+PushParser::header() {
+    const auto size = amqp::AMQP_HEADER.size() + 1;
+    auto bytes = m_window.bytes();
+
+    if (bytes.size() < size) {
+        m_wanted = size;
+        return false;
+    }
+
+    if (!std::equal (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end(), bytes.begin())) {
+        throw std::runtime_error ("Not a Corda stream");
+    }
+
+    const auto section = static_cast<uint8_t>(bytes[amqp::AMQP_HEADER.size()]);
+
+    if (section == amqp::ENCODING) {
+        throw std::runtime_error ("Compressed blobs can't be streamed");
+    }
+
+    if (section != amqp::DATA_AND_STOP && section != amqp::ALT_DATA_AND_STOP) {
+        throw std::runtime_error ("Unsupported section " + std::to_string (section));
+    }
+
+    m_window.consume (size);
+    m_state = State::envelope;
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Step into the envelope's list, noting where it ends so whatever follows
+ * the payload and schema can be skipped
+ */
+bool
+PushParser::envelope() {
+    auto bytes = m_window.bytes();
+
+    if (bytes.empty()) {
+        m_wanted = 1;
+        return false;
+    }
+
+    if (bytes[0] != 0x00) {
+        throw std::runtime_error ("Blob is not a described envelope");
+    }
+
+    auto descriptor = decoder::Window::extent (bytes.substr (1));
+
+    if (!descriptor || 1 + *descriptor >= bytes.size()) {
+        m_wanted = bytes.size() + 1;
+        return false;
+    }
+
+    {
+        decoder::Cursor cursor (bytes.substr (1, *descriptor));
+        cursor.next();
+
+        if (cursor.type() != decoder::Type::ulong_t
+            || amqp::stripCorda (cursor.getUlong()) != amqp::schema::descriptors::ENVELOPE)
+        {
+            throw std::runtime_error ("Blob is not a described envelope");
+        }
+    }
+
+    const auto offset = 1 + *descriptor;
+
+    size_t width;
+    switch (static_cast<uint8_t>(bytes[offset])) {
+        case 0xc0 : width = 1; break;
+        case 0xd0 : width = 4; break;
+        default : throw std::runtime_error ("Expected a list");
+    }
+
+    const auto size = offset + 1 + 2 * width;
+
+    if (bytes.size() < size) {
+        m_wanted = size;
+        return false;
+    }
+
+    // the size prefix counts the count
+    const auto body = be (bytes.substr (offset + 1), width) - width;
+
+    m_window.consume (size);
+    m_end = m_window.position() + body;
+    m_state = State::descriptor;
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Peek at the payload's descriptor, streaming it if we already know
+ * the schema and buffering it if we don't
+ */
+bool
+PushParser::descriptor() {
+    auto bytes = m_window.bytes();
+
+    if (bytes.empty()) {
+        m_wanted = 1;
+        return false;
+    }
+
+    if (bytes[0] != 0x00) {
+        throw std::runtime_error ("Expected a described type");
+    }
+
+    auto descriptor = decoder::Window::extent (bytes.substr (1));
+
+    if (!descriptor || 1 + *descriptor > bytes.size()) {
+        m_wanted = descriptor ? 1 + *descriptor : bytes.size() + 1;
+        return false;
+    }
+
+    {
+        decoder::Cursor cursor (bytes.substr (1, *descriptor));
+        cursor.next();
+        decoder::is_symbol (cursor);
+        m_descriptor = cursor.getSymbol();
+    }
+
+    m_entry = amqp::internal::SchemaCache::instance().find (m_descriptor);
+
+    if (!m_entry) {
+        m_state = State::buffering;
+        return true;
+    }
+
+    m_resumable = std::make_unique<amqp::internal::reader::Program::Resumable> (
+            m_entry->program (m_descriptor), m_entry->schema(), m_visitor);
+
+    m_visitor.startObject();
+    m_visitor.field ("Parsed");
+
+    m_state = State::streaming;
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+PushParser::streaming() {
+    if (!m_resumable->resume (m_window)) {
+        m_wanted = m_resumable->wanted();
+        return false;
+    }
+
+    m_state = State::trailer;
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Hold the payload and the schema after it until both are here, then
+ * decode the payload in one go exactly as if we had the whole blob
+ */
+bool
+PushParser::buffering() {
+    auto bytes = m_window.bytes();
+
+    auto payload = decoder::Window::extent (bytes);
+
+    if (!payload || *payload >= bytes.size()) {
+        m_wanted = std::max (bytes.size() + 1, payload.value_or (0) + 1);
+        return false;
+    }
+
+    auto schema = decoder::Window::extent (bytes.substr (*payload));
+
+    if (!schema || *payload + *schema > bytes.size()) {
+        m_wanted = schema ? *payload + *schema : bytes.size() + 1;
+        return false;
+    }
+
+    decoder::Cursor cursor (bytes.substr (*payload, *schema));
+    cursor.next();
+
+    m_entry = &amqp::internal::SchemaCache::instance().fetch (cursor);
+
+    const auto & program = m_entry->program (m_descriptor);
+
+    m_visitor.startObject();
+    m_visitor.field ("Parsed");
+
+    decoder::Cursor value (bytes.substr (0, *payload));
+    value.next();
+
+    program.run (value, m_entry->schema(), m_visitor);
+
+    m_window.consume (*payload + *schema);
+    m_state = State::trailer;
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Skip the rest of the envelope, its schema and transforms, without
+ * holding any of it
+ */
+bool
+PushParser::trailer() {
+    const auto remaining = m_end - m_window.position();
+    const auto available = std::min<uint64_t> (remaining, m_window.size());
+
+    m_window.consume (available);
+
+    if (available < remaining) {
+        m_wanted = 1;
+        return false;
+    }
+
+    m_visitor.endObject();
+    m_state = State::done;
+
+    return true;
+}
+
+/******************************************************************************/
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+#include "amqp/SchemaCache.h"
+#include "amqp/decoder/Window.h"
+#include "amqp/reader/Program.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+/**
+ * Decodes a blob handed to us a chunk at a time, as it comes off a pipe
+ * or socket, rather than all at once. Whatever can be decoded from what's
+ * arrived is passed on to the visitor straight away and the rest waits for
+ * the next chunk, so output starts before the blob's finished arriving.
+ *
+ * The schema follows the payload in the envelope so streaming depends on
+ * the cache already holding a schema for the payload's type, primed by
+ * having decoded a blob of that type before. When it doesn't the payload
+ * and schema are held until both have arrived and decoded as BlobInspector
+ * would.
+ *
+ * Streamed, what's held is bounded by the window's capacity or the largest
+ * single scalar, whichever is bigger, however big the blob. Compressed
+ * blobs and back references need the whole blob so can't be streamed.
+ */
+class PushParser {
+    public :
+        static constexpr size_t CAPACITY = 64 * 1024;
+
+    private :
+        enum class State {
+            header,
+            envelope,
+            descriptor,
+            streaming,
+            buffering,
+            trailer,
+            done
+        };
+
+        amqp::reader::IVisitor & m_visitor;
+        amqp::internal::decoder::Window m_window;
+        size_t m_capacity;
+
+        State m_state;
+
+        /**
+         * How much the window must hold before we can move on, past the
+         * capacity if a single value needs it
+         */
+        size_t m_wanted;
+
+        /**
+         * Where in the stream the envelope ends
+         */
+        uint64_t m_end;
+
+        std::string m_descriptor;
+        amqp::internal::SchemaCache::Entry * m_entry;
+        std::unique_ptr<amqp::internal::reader::Program::Resumable> m_resumable;
+
+        bool parse();
+
+        bool header();
+        bool envelope();
+        bool descriptor();
+        bool streaming();
+        bool buffering();
+        bool trailer();
+
+    public :
+        explicit PushParser (amqp::reader::IVisitor &, size_t capacity_ = CAPACITY);
+
+        PushParser (const PushParser &) = delete;
+        PushParser & operator = (const PushParser &) = delete;
+
+        /**
+         * Decode as much as we can with [chunk_] added to what we had
+         */
+        void feed (std::string_view chunk_);
+
+        /**
+         * Throws if the blob hasn't been read in full or anything followed it
+         */
+        void finish();
+
+        bool done() const { return m_state == State::done; }
+
+        /**
+         * Whether the payload was decoded as it arrived, rather than held
+         * until its schema was available
+         */
+        bool streamed() const { return m_resumable != nullptr; }
+
+        /**
+         * The most bytes held at once
+         */
+        size_t peak() const { return m_window.peak(); }
+};
+
+/******************************************************************************/
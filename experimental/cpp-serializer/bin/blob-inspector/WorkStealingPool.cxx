@@ -0,0 +1,188 @@
+#include "WorkStealingPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Index of the worker running on this thread, or -1 for threads that
+     * aren't part of a pool
+     */
+    thread_local long t_worker = -1;
+
+    thread_local const void * t_pool = nullptr;
+
+}
+
+/******************************************************************************/
+
+WorkStealingPool::WorkStealingPool (size_t threads_)
+    : m_queued { 0 }
+    , m_pending { 0 }
+    , m_stop { false }
+{
+    if (threads_ == 0) {
+        threads_ = 1;
+    }
+
+    m_queues.reserve (threads_);
+    for (size_t i { 0 } ; i < threads_ ; ++i) {
+        m_queues.emplace_back (std::make_unique<Queue>());
+    }
+
+    m_workers.reserve (threads_);
+    for (size_t i { 0 } ; i < threads_ ; ++i) {
+        m_workers.emplace_back (&WorkStealingPool::worker, this, i);
+    }
+}
+
+/******************************************************************************/
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> l (m_idleLock);
+        m_stop = true;
+    }
+
+    m_wake.notify_all();
+
+    for (auto & worker : m_workers) {
+        worker.join();
+    }
+}
+
+/******************************************************************************/
+
+void
+WorkStealingPool::submit (Task task_) {
+    auto & queue = (t_pool == this)
+        ? *m_queues[static_cast<size_t>(t_worker)]
+        : m_external;
+
+    /*
+     * Count it before it becomes visible so a worker that grabs it
+     * straight away can never take the count below zero
+     */
+    {
+        std::lock_guard<std::mutex> l (m_idleLock);
+        ++m_pending;
+        ++m_queued;
+    }
+
+    {
+        std::lock_guard<std::mutex> l (queue.m_lock);
+        queue.m_tasks.emplace_back (std::move (task_));
+    }
+
+    m_wake.notify_one();
+}
+
+/******************************************************************************/
+
+/**
+ * Our own queue is worked LIFO as that's where whatever we last pushed is
+ * still warm in cache. The shared queue and victims are worked FIFO, to
+ * start outside work in order and to rob victims of their oldest work.
+ */
+bool
+WorkStealingPool::take (size_t self_, Task & task_) {
+    {
+        auto & own = *m_queues[self_];
+        std::lock_guard<std::mutex> l (own.m_lock);
+
+        if (!own.m_tasks.empty()) {
+            task_ = std::move (own.m_tasks.back());
+            own.m_tasks.pop_back();
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> l (m_external.m_lock);
+
+        if (!m_external.m_tasks.empty()) {
+            task_ = std::move (m_external.m_tasks.front());
+            m_external.m_tasks.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t i { 1 } ; i < m_queues.size() ; ++i) {
+        auto & victim = *m_queues[(self_ + i) % m_queues.size()];
+        std::lock_guard<std::mutex> l (victim.m_lock);
+
+        if (!victim.m_tasks.empty()) {
+            task_ = std::move (victim.m_tasks.front());
+            victim.m_tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+
+void
+WorkStealingPool::finished() {
+    std::lock_guard<std::mutex> l (m_idleLock);
+
+    if (--m_pending == 0) {
+        m_done.notify_all();
+    }
+}
+
+/******************************************************************************/
+
+void
+WorkStealingPool::worker (size_t self_) {
+    t_worker = static_cast<long>(self_);
+    t_pool = this;
+
+    for (;;) {
+        Task task;
+
+        if (take (self_, task)) {
+            {
+                std::lock_guard<std::mutex> l (m_idleLock);
+                --m_queued;
+            }
+
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> l (m_idleLock);
+                if (!m_error) m_error = std::current_exception();
+            }
+
+            finished();
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> l (m_idleLock);
+
+        m_wake.wait (l, [this] { return m_stop || m_queued > 0; });
+
+        if (m_stop && m_queued == 0) {
+            return;
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> l (m_idleLock);
+
+    m_done.wait (l, [this] { return m_pending == 0; });
+
+    if (m_error) {
+        auto error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception (error);
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+/******************************************************************************/
+
+/**
+ * A fixed size pool of threads, each with its own queue of work. A worker
+ * takes from the back of its own queue and, once that's empty, steals
+ * from the front of everyone else's so uneven blob sizes still keep
+ * every core busy.
+ *
+ * Tasks submitted from a worker go onto that worker's queue. Anything
+ * else goes onto a shared queue that's drained oldest first, once a
+ * worker's own queue is empty and before it steals, so work handed in
+ * from outside starts in the order it was submitted.
+ */
+class WorkStealingPool {
+    public :
+        using Task = std::function<void()>;
+
+    private :
+        struct Queue {
+            std::mutex m_lock;
+            std::deque<Task> m_tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        Queue m_external;
+        std::vector<std::thread> m_workers;
+
+        /**
+         * Guards sleeping and waking, m_queued is only changed whilst
+         * holding it so a submit can never slip between a worker deciding
+         * to sleep and actually sleeping
+         */
+        std::mutex m_idleLock;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+
+        size_t m_queued;
+        size_t m_pending;
+        bool m_stop;
+
+        std::exception_ptr m_error;
+
+        bool take (size_t, Task &);
+        void finished();
+        void worker (size_t);
+
+    public :
+        explicit WorkStealingPool (
+            size_t threads_ = std::thread::hardware_concurrency());
+
+        WorkStealingPool (const WorkStealingPool &) = delete;
+        WorkStealingPool & operator = (const WorkStealingPool &) = delete;
+
+        ~WorkStealingPool();
+
+        void submit (Task);
+
+        /**
+         * Block until every submitted task, including any they submitted
+         * themselves, has run. Rethrows the first exception a task threw.
+         */
+        void wait();
+
+        size_t threads() const { return m_workers.size(); }
+};
+
+/******************************************************************************/
@@ -0,0 +1,27 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+
+#include "amqp/reader/ISink.h"
+
+/******************************************************************************/
+
+/**
+ * Counts what would have been written so the output can't be optimised
+ * away without paying for a terminal or a string
+ */
+class CountingSink : public amqp::reader::ISink {
+    private :
+        size_t m_written { 0 };
+
+    public :
+        void write (const char *, size_t size_) override {
+            m_written += size_;
+        }
+
+        size_t written() const { return m_written; }
+};
+
+/******************************************************************************/
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <ostream>
+#include <streambuf>
+
+#include "Batch.h"
+#include "amqp/SchemaCache.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Swallows everything so we measure decoding rather than the terminal
+     */
+    class NullBuf : public std::streambuf {
+        protected :
+            int_type overflow (int_type c_) override { return c_; }
+
+            std::streamsize xsputn (const char *, std::streamsize n_) override {
+                return n_;
+            }
+    };
+
+    /**
+     * The checked in test blobs repeated until we've enough work to spread
+     * across a reasonable number of threads
+     */
+    std::vector<std::string>
+    corpus() {
+        auto files = Batch::paths (TEST_FILES);
+        std::vector<std::string> rtn;
+
+        for (int i { 0 } ; i < 200 ; ++i) {
+            rtn.insert (rtn.end(), files.begin(), files.end());
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Throughput of a batch decode against the number of pool threads, the
+ * items per second should scale close to linearly up to the core count
+ */
+static void
+BM_BatchThreads (benchmark::State & state_) {
+    Batch batch (corpus());
+    NullBuf buf;
+    std::ostream out (&buf);
+
+    // warm the schema cache so every iteration does the same work
+    batch.run (out);
+
+    for (auto _ : state_) {
+        batch.run (out, state_.range (0));
+    }
+
+    state_.SetItemsProcessed (state_.iterations() * batch.blobs().size());
+    state_.counters["cache_hits"] = amqp::internal::SchemaCache::instance().hits();
+}
+
+BENCHMARK (BM_BatchThreads) // NOLINT
+    ->RangeMultiplier (2)
+    ->Range (1, 64)
+    ->UseRealTime()
+    ->Unit (benchmark::kMillisecond);
+
+/******************************************************************************/
+
+BENCHMARK_MAIN(); // NOLINT
+
+/******************************************************************************/
@@ -0,0 +1,205 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "proton/codec.h"
+
+#include "Batch.h"
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+#include "CountingSink.h"
+
+#include "amqp/reader/IReader.h"
+#include "amqp/reader/Sink.h"
+#include "amqp/reader/JsonVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Every checked in blob [decode_] can decode, held in memory so we
+     * measure decoding rather than the file system. Each benchmark
+     * filters through the path it measures, the proton tree for one
+     * still can't follow back references where the cursor can.
+     */
+    template<class F>
+    std::vector<CordaBytes>
+    blobs (F && decode_) {
+        std::vector<CordaBytes> rtn;
+
+        for (const auto & path : Batch::paths (TEST_FILES)) {
+            CordaBytes cb (path);
+
+            try {
+                decode_ (cb);
+            } catch (const std::exception &) {
+                continue;
+            }
+
+            rtn.emplace_back (std::move (cb));
+        }
+
+        return rtn;
+    }
+
+    std::vector<CordaBytes>
+    blobs() {
+        return blobs ([](const CordaBytes & cb_) { BlobInspector (cb_).dump(); });
+    }
+
+    void
+    protonDump (const CordaBytes & cb_, amqp::reader::ISink & sink_) {
+        BlobInspector (cb_).value ("Parsed")->dump (sink_);
+    }
+
+    size_t
+    bytes (const std::vector<CordaBytes> & blobs_) {
+        size_t rtn { 0 };
+        for (const auto & cb : blobs_) rtn += cb.size();
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * The floor for anything going through proton, just building the tree
+ */
+static void
+BM_ProtonDecode (benchmark::State & state_) {
+    auto corpus = blobs();
+    auto data = pn_data (0);
+
+    for (auto _ : state_) {
+        for (const auto & cb : corpus) {
+            pn_data_clear (data);
+            benchmark::DoNotOptimize (pn_data_decode (data, cb.bytes(), cb.size()));
+        }
+    }
+
+    pn_data_free (data);
+
+    state_.SetItemsProcessed (state_.iterations() * corpus.size());
+    state_.SetBytesProcessed (state_.iterations() * bytes (corpus));
+}
+
+BENCHMARK (BM_ProtonDecode); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * Decode each blob into a proton tree and dump it through the IValue
+ * readers
+ */
+static void
+BM_ProtonDump (benchmark::State & state_) {
+    CountingSink sink;
+    auto corpus = blobs ([&sink](const CordaBytes & cb_) { protonDump (cb_, sink); });
+
+    for (auto _ : state_) {
+        for (const auto & cb : corpus) {
+            protonDump (cb, sink);
+        }
+    }
+
+    benchmark::DoNotOptimize (sink.written());
+
+    state_.SetItemsProcessed (state_.iterations() * corpus.size());
+    state_.SetBytesProcessed (state_.iterations() * bytes (corpus));
+}
+
+BENCHMARK (BM_ProtonDump); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * The same blobs walked in place by the cursor straight into JSON,
+ * running the programs compiled from each schema's readers
+ */
+static void
+BM_CursorDump (benchmark::State & state_) {
+    auto corpus = blobs();
+    CountingSink sink;
+
+    for (auto _ : state_) {
+        for (const auto & cb : corpus) {
+            BlobInspector (cb).dump (sink);
+        }
+    }
+
+    benchmark::DoNotOptimize (sink.written());
+
+    state_.SetItemsProcessed (state_.iterations() * corpus.size());
+    state_.SetBytesProcessed (state_.iterations() * bytes (corpus));
+}
+
+BENCHMARK (BM_CursorDump); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * As above but walking the graph of readers the programs are compiled
+ * from, a virtual call and weak_ptr lock per value
+ */
+static void
+BM_WalkDump (benchmark::State & state_) {
+    auto corpus = blobs();
+    CountingSink sink;
+    amqp::internal::reader::JsonVisitor visitor (sink);
+
+    for (auto _ : state_) {
+        for (const auto & cb : corpus) {
+            BlobInspector (cb).walk (visitor);
+        }
+    }
+
+    benchmark::DoNotOptimize (sink.written());
+
+    state_.SetItemsProcessed (state_.iterations() * corpus.size());
+    state_.SetBytesProcessed (state_.iterations() * bytes (corpus));
+}
+
+BENCHMARK (BM_WalkDump); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * Resolving is a one off per blob and dominates the above for blobs as
+ * small as ours, so this isolates the walk itself by reusing one
+ * inspector per blob
+ */
+template<bool Compiled>
+static void
+BM_Walk (benchmark::State & state_) {
+    auto corpus = blobs();
+    CountingSink sink;
+    amqp::internal::reader::JsonVisitor visitor (sink);
+
+    std::vector<std::unique_ptr<BlobInspector>> inspectors;
+    for (const auto & cb : corpus) {
+        inspectors.emplace_back (std::make_unique<BlobInspector> (cb));
+    }
+
+    for (auto _ : state_) {
+        for (auto & bi : inspectors) {
+            if (Compiled) {
+                bi->visit (visitor);
+            } else {
+                bi->walk (visitor);
+            }
+        }
+    }
+
+    benchmark::DoNotOptimize (sink.written());
+
+    state_.SetItemsProcessed (state_.iterations() * corpus.size());
+    state_.SetBytesProcessed (state_.iterations() * bytes (corpus));
+}
+
+BENCHMARK_TEMPLATE (BM_Walk, true)->Name ("BM_ProgramRun"); // NOLINT
+BENCHMARK_TEMPLATE (BM_Walk, false)->Name ("BM_ReaderWalk"); // NOLINT
+
+/******************************************************************************/
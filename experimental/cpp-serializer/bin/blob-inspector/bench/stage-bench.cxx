@@ -0,0 +1,387 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+#include "proton/codec.h"
+#include "proton/proton_wrapper.h"
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+#include "CountingSink.h"
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/decoder/Cursor.h"
+#include "amqp/encoder/Synthetic.h"
+#include "amqp/reader/IReader.h"
+#include "amqp/schema/OrderedTypeNotations.h"
+#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+
+/******************************************************************************/
+
+/**
+ * Each stage of decoding a blob measured on its own, over blobs generated
+ * to a given size and depth rather than the handful checked in, so we can
+ * see how each scales and which one a regression lands in.
+ *
+ * A blob of depth d is d nested composites, each holding a few scalars, a
+ * list of [size] ints and, but for the innermost, the next one in. So the
+ * bytes grow with size * depth and the schema with depth.
+ */
+
+namespace {
+
+    namespace encoder = amqp::internal::encoder;
+
+    /**
+     * The blob and, as CordaBytes would give it us, its payload
+     */
+    class Blob {
+        private :
+            std::string m_blob;
+
+        public :
+            explicit Blob (std::string blob_) : m_blob (std::move (blob_)) { }
+
+            const std::string & blob() const { return m_blob; }
+
+            std::string_view payload() const {
+                return std::string_view (m_blob).substr (amqp::AMQP_HEADER.size() + 1);
+            }
+    };
+
+    /**
+     * range(0) is the size, range(1) the depth
+     */
+    Blob
+    synthetic (const benchmark::State & state_) {
+        encoder::Shape shape;
+        shape.m_fields = 5;
+        shape.m_list = state_.range (0);
+        shape.m_depth = state_.range (1);
+
+        return Blob (encoder::Synthetic (shape).blob (0));
+    }
+
+    void
+    sizes (benchmark::internal::Benchmark * b_) {
+        b_->ArgNames ({ "size", "depth" })
+          ->RangeMultiplier (16)
+          ->Ranges ({ { 1, 4096 }, { 1, 64 } });
+    }
+
+    using PnData = std::unique_ptr<pn_data_t, decltype (&pn_data_free)>;
+
+    PnData
+    decode (std::string_view bytes_) {
+        PnData data { pn_data (0), &pn_data_free };
+
+        if (pn_data_decode (data.get(), bytes_.data(), bytes_.size())
+                != static_cast<ssize_t>(bytes_.size()))
+        {
+            throw std::runtime_error ("Failed to decode blob");
+        }
+
+        return data;
+    }
+
+    /**
+     * The encoded schema section, found without building anything
+     */
+    std::string_view
+    schemaSection (std::string_view payload_) {
+        namespace decoder = amqp::internal::decoder;
+
+        decoder::Cursor cursor (payload_);
+        cursor.next();
+
+        decoder::auto_enter p (cursor, true);
+        decoder::auto_list_enter ale (cursor, true);
+        cursor.next();
+
+        return cursor.raw();
+    }
+
+    void
+    rewind (pn_data_t * data_) {
+        pn_data_rewind (data_);
+        pn_data_next (data_);
+    }
+
+    void
+    bytes (benchmark::State & state_, size_t size_) {
+        state_.SetBytesProcessed (state_.iterations() * size_);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Opening a blob from disk, mapping it and checking its header
+ */
+static void
+BM_CordaBytesLoad (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+
+    char path[] = "/tmp/stage-bench-XXXXXX";
+    auto fd = ::mkstemp (path);
+    ::close (fd);
+
+    std::ofstream (path, std::ios::binary) << blob.blob();
+
+    for (auto _ : state_) {
+        CordaBytes cb (path);
+        benchmark::DoNotOptimize (cb.bytes());
+    }
+
+    ::unlink (path);
+
+    bytes (state_, blob.blob().size());
+}
+
+BENCHMARK (BM_CordaBytesLoad)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * The whole envelope decoded into a proton tree
+ */
+static void
+BM_PnDataDecode (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+    auto payload = blob.payload();
+    auto data = pn_data (0);
+
+    for (auto _ : state_) {
+        pn_data_clear (data);
+        benchmark::DoNotOptimize (pn_data_decode (data, payload.data(), payload.size()));
+    }
+
+    pn_data_free (data);
+
+    bytes (state_, payload.size());
+}
+
+BENCHMARK (BM_PnDataDecode)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * The envelope built from its proton tree, which skips the payload and
+ * builds the schema
+ */
+static void
+BM_EnvelopeBuild (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+    auto data = decode (blob.payload());
+
+    for (auto _ : state_) {
+        rewind (data.get());
+        benchmark::DoNotOptimize (
+                amqp::internal::schema::descriptors::dispatchDescribed<
+                        amqp::internal::schema::Envelope> (data.get()));
+    }
+
+    bytes (state_, blob.payload().size());
+}
+
+BENCHMARK (BM_EnvelopeBuild)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * Just the schema, which is what the cache builds on a miss
+ */
+static void
+BM_SchemaBuild (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+    auto schema = schemaSection (blob.payload());
+    auto data = decode (schema);
+
+    for (auto _ : state_) {
+        rewind (data.get());
+        benchmark::DoNotOptimize (
+                amqp::internal::schema::descriptors::dispatchDescribed<
+                        amqp::internal::schema::Schema> (data.get()));
+    }
+
+    bytes (state_, schema.size());
+}
+
+BENCHMARK (BM_SchemaBuild)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A type that depends on whichever types it names and nothing else
+     */
+    class Notation : public amqp::internal::schema::OrderedTypeNotation {
+        private :
+            std::string m_name;
+            std::vector<std::string> m_dependsOn;
+
+        public :
+            Notation (std::string name_, std::vector<std::string> dependsOn_)
+                : m_name (std::move (name_))
+                , m_dependsOn (std::move (dependsOn_))
+            { }
+
+            int dependsOn (const OrderedTypeNotation &) const override {
+                return 0;
+            }
+
+            const std::string & name() const override { return m_name; }
+
+            void dependencies (std::vector<std::string_view> & names_) const override {
+                names_.insert (names_.end(), m_dependsOn.begin(), m_dependsOn.end());
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Inserting range(0) types, each depending on the one inserted after it,
+ * and ordering them. Every type ends up on a level of its own which is
+ * as bad as it gets.
+ */
+static void
+BM_OrderedTypeNotationsInsert (benchmark::State & state_) {
+    using amqp::internal::schema::OrderedTypeNotations;
+
+    const auto count = static_cast<size_t>(state_.range (0));
+
+    std::vector<std::string> names;
+    for (size_t i { 0 } ; i < count ; ++i) {
+        names.push_back ("net.corda.bench.Type" + std::to_string (i));
+    }
+
+    for (auto _ : state_) {
+        OrderedTypeNotations<Notation> types;
+
+        for (size_t i { 0 } ; i < count ; ++i) {
+            types.insert (std::make_unique<Notation> (
+                    names[i],
+                    i + 1 < count
+                        ? std::vector<std::string> { names[i + 1] }
+                        : std::vector<std::string> { }));
+        }
+
+        benchmark::DoNotOptimize (types.begin());
+    }
+
+    state_.SetItemsProcessed (state_.iterations() * count);
+    state_.SetComplexityN (state_.range (0));
+}
+
+BENCHMARK (BM_OrderedTypeNotationsInsert) // NOLINT
+        ->ArgName ("types")
+        ->RangeMultiplier (4)
+        ->Range (1, 4096)
+        ->Complexity();
+
+/******************************************************************************/
+
+/**
+ * Readers built for every type in the schema
+ */
+static void
+BM_CompositeFactoryProcess (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+    auto data = decode (blob.payload());
+
+    rewind (data.get());
+    auto envelope = amqp::internal::schema::descriptors::dispatchDescribed<
+            amqp::internal::schema::Envelope> (data.get());
+
+    for (auto _ : state_) {
+        amqp::internal::CompositeFactory factory;
+        factory.process (envelope->schema());
+        benchmark::DoNotOptimize (factory.byDescriptor (envelope->descriptor()));
+    }
+
+    state_.SetItemsProcessed (state_.iterations() * (state_.range (1) + 1));
+}
+
+BENCHMARK (BM_CompositeFactoryProcess)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * The readers turning the proton tree into a tree of values, with the
+ * schema already resolved and the tree already decoded
+ */
+static void
+BM_ReaderDump (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+    CordaBytes cb (blob.blob().data(), blob.blob().size());
+    BlobInspector bi (cb);
+
+    bi.value ("Parsed");
+
+    for (auto _ : state_) {
+        benchmark::DoNotOptimize (bi.value ("Parsed"));
+    }
+
+    bytes (state_, cb.size());
+}
+
+BENCHMARK (BM_ReaderDump)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * The tree of values from above written out
+ */
+static void
+BM_ValueDump (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+    CordaBytes cb (blob.blob().data(), blob.blob().size());
+    auto value = BlobInspector (cb).value ("Parsed");
+    CountingSink sink;
+
+    for (auto _ : state_) {
+        value->dump (sink);
+    }
+
+    benchmark::DoNotOptimize (sink.written());
+
+    state_.SetBytesProcessed (sink.written());
+}
+
+BENCHMARK (BM_ValueDump)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
+
+/**
+ * For comparison, the cursor walking the payload straight into JSON by
+ * way of the compiled program
+ */
+static void
+BM_ProgramDump (benchmark::State & state_) {
+    auto blob = synthetic (state_);
+    CordaBytes cb (blob.blob().data(), blob.blob().size());
+    BlobInspector bi (cb);
+    CountingSink sink;
+
+    for (auto _ : state_) {
+        bi.dump (sink);
+    }
+
+    benchmark::DoNotOptimize (sink.written());
+
+    bytes (state_, cb.size());
+}
+
+BENCHMARK (BM_ProgramDump)->Apply (sizes); // NOLINT
+
+/******************************************************************************/
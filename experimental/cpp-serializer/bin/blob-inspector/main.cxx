@@ -1,13 +1,21 @@
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
 #include <fstream>
 #include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
 
 #include <assert.h>
 #include <string.h>
 #include <proton/types.h>
 #include <proton/codec.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "debug.h"
 
@@ -19,29 +27,326 @@
 
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/SchemaCache.h"
+#include "amqp/reader/Sink.h"
+#include "amqp/reader/JsonVisitor.h"
+#include "amqp/reader/Profile.h"
+#include "amqp/columnar/Columns.h"
+#include "amqp/columnar/ArrowFile.h"
 #include "CordaBytes.h"
 #include "BlobInspector.h"
+#include "PushParser.h"
+#include "Batch.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * exe_) {
+        std::cerr << "usage: " << exe_ << " [--profile] [--select <path>[,<path>...]] <blob>"
+                  << std::endl
+                  << "       " << exe_ << " --batch <directory | file list | ->"
+                  << " [--threads <n>] [--select <path>[,<path>...]] [--profile]" << std::endl
+                  << "       " << exe_ << " --batch <directory | file list | ->"
+                  << " --arrow <file> [--rows <n>]" << std::endl
+                  << "       " << exe_ << " --stream [--prime <blob>]..." << std::endl;
+    }
+
+    /**
+     * [arg_] as a count, false unless it's all digits and more than zero
+     */
+    bool
+    number (const char * arg_, size_t & value_) {
+        char * end;
+        value_ = std::strtoull (arg_, &end, 10);
+
+        return std::isdigit (static_cast<unsigned char>(*arg_)) && *end == '\0' && value_ > 0;
+    }
+
+    /**
+     * Where the time went by type, to stderr so it doesn't end up mixed
+     * in with the blobs
+     */
+    void
+    profile() {
+        const auto report = amqp::internal::reader::Profile::report();
+
+        size_t width { 4 };
+        for (const auto & entry : report) {
+            width = std::max (width, entry.m_type.size());
+        }
+
+        auto ms = [](std::chrono::nanoseconds ns_) {
+            return std::chrono::duration<double, std::milli> (ns_).count();
+        };
+
+        std::cerr << std::left << std::setw (width) << "type" << std::right
+                  << std::setw (12) << "calls"
+                  << std::setw (14) << "incl ms"
+                  << std::setw (14) << "excl ms"
+                  << std::setw (14) << "bytes" << std::endl;
+
+        std::cerr << std::fixed << std::setprecision (3);
+
+        for (const auto & entry : report) {
+            std::cerr << std::left << std::setw (width) << entry.m_type << std::right
+                      << std::setw (12) << entry.m_calls
+                      << std::setw (14) << ms (entry.m_inclusive)
+                      << std::setw (14) << ms (entry.m_exclusive)
+                      << std::setw (14) << entry.m_bytes << std::endl;
+        }
+    }
+
+    /**
+     * Comma separated dotted paths, "owner.name,amount"
+     */
+    std::vector<std::string>
+    paths (const std::string & select_) {
+        std::vector<std::string> rtn;
+        std::stringstream ss (select_);
+
+        for (std::string path ; std::getline (ss, path, ',') ; ) {
+            if (!path.empty()) rtn.push_back (path);
+        }
+
+        return rtn;
+    }
+
+    int
+    batch (
+        const std::string & source_,
+        size_t threads_,
+        std::vector<std::string> select_
+    ) {
+        Batch batch (Batch::paths (source_), std::move (select_));
+
+        auto failures = batch.run (std::cout, threads_);
+
+        const auto & cache = amqp::internal::SchemaCache::instance();
+
+        std::cerr << batch.blobs().size() << " blobs, " << failures
+                  << " failed, schema cache " << cache.hits() << " hits "
+                  << cache.misses() << " misses" << std::endl;
+
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /**
+     * Decode blobs sharing a type into columns, written to [out_] as an
+     * Arrow file of batches of [rows_] rows. Any blob that fails leaves
+     * its row half written so the export stops there.
+     */
+    int
+    arrow (const std::string & source_, const std::string & out_, size_t rows_) {
+        namespace columnar = amqp::internal::columnar;
+
+        const auto paths = Batch::paths (source_);
+
+        std::ofstream file (out_, std::ios::binary);
+
+        if (!file) {
+            throw std::runtime_error ("Failed to open " + out_);
+        }
+
+        columnar::Columns columns;
+        columnar::ArrowFile arrow (file, columns);
+
+        for (const auto & path : paths) {
+            try {
+                CordaBytes cb (path);
+                BlobInspector (cb).columns (columns);
+            } catch (const std::exception & e) {
+                throw std::runtime_error (path + ": " + e.what());
+            }
+
+            if (static_cast<size_t>(columns.rows()) == rows_) {
+                arrow.batch();
+            }
+        }
+
+        if (columns.rows() > 0) {
+            arrow.batch();
+        }
+
+        arrow.close();
+
+        std::cerr << paths.size() << " blobs of " << columns.type() << ", "
+                  << arrow.batches() << " batches" << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    /**
+     * Decode a blob from stdin as it arrives, having first put the schemas
+     * of [prime_] in the cache so blobs of the same types stream rather
+     * than waiting for their schema
+     */
+    int
+    stream (const std::vector<std::string> & prime_) {
+        for (const auto & blob : prime_) {
+            CordaBytes cb (blob);
+            BlobInspector (cb).resolve();
+        }
+
+        amqp::internal::reader::FdSink sink (STDOUT_FILENO);
+        amqp::internal::reader::JsonVisitor visitor (sink);
+        PushParser parser (visitor);
+
+        std::vector<char> chunk (PushParser::CAPACITY);
+
+        for (;;) {
+            auto got = ::read (STDIN_FILENO, chunk.data(), chunk.size());
+
+            if (got < 0) {
+                throw std::runtime_error ("Failed to read stdin");
+            }
+
+            if (got == 0) {
+                break;
+            }
+
+            parser.feed ({ chunk.data(), static_cast<size_t>(got) });
+            sink.flush();
+        }
+
+        parser.finish();
+        sink << "\n";
+
+        return EXIT_SUCCESS;
+    }
+
+}
 
 /******************************************************************************/
 
 int
 main (int argc, char **argv) {
+    std::string source;
+    std::string blob;
+    std::vector<std::string> select;
+    size_t threads { 1 };
+    bool streaming { false };
+    std::vector<std::string> prime;
+    std::string arrowFile;
+    size_t rows { 65536 };
+
+    for (int i { 1 } ; i < argc ; ++i) {
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp (argv[i], "--batch") == 0 && hasValue) {
+            source = argv[++i];
+        } else if (strcmp (argv[i], "--threads") == 0 && hasValue
+                   && number (argv[i + 1], threads)) {
+            ++i;
+        } else if (strcmp (argv[i], "--select") == 0 && hasValue) {
+            select = paths (argv[++i]);
+        } else if (strcmp (argv[i], "--profile") == 0) {
+            amqp::internal::reader::Profile::enable (true);
+        } else if (strcmp (argv[i], "--arrow") == 0 && hasValue) {
+            arrowFile = argv[++i];
+        } else if (strcmp (argv[i], "--rows") == 0 && hasValue
+                   && number (argv[i + 1], rows)) {
+            ++i;
+        } else if (strcmp (argv[i], "--stream") == 0) {
+            streaming = true;
+        } else if (strcmp (argv[i], "--prime") == 0 && hasValue) {
+            prime.emplace_back (argv[++i]);
+        } else if (argv[i][0] != '-' && blob.empty()) {
+            blob = argv[i];
+        } else {
+            usage (argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!arrowFile.empty()) {
+        if (source.empty() || !blob.empty() || !select.empty() || streaming) {
+            usage (argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        try {
+            return arrow (source, arrowFile, rows);
+        } catch (const std::exception & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (streaming) {
+        if (!source.empty() || !blob.empty() || !select.empty()) {
+            usage (argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        try {
+            return stream (prime);
+        } catch (const std::exception & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!source.empty()) {
+        if (!blob.empty()) {
+            usage (argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        try {
+            auto rtn = batch (source, threads, std::move (select));
+
+            if (amqp::internal::reader::Profile::enabled()) {
+                profile();
+            }
+
+            return rtn;
+        } catch (const std::exception & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (blob.empty()) {
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
     struct stat results { };
 
-    if (stat(argv[1], &results) != 0) {
+    if (stat (blob.c_str(), &results) != 0) {
         return EXIT_FAILURE;
     }
 
-    CordaBytes cb (argv[1]);
-    
-    if (cb.encoding() == amqp::DATA_AND_STOP) {
+    try {
+        CordaBytes cb (blob);
+
         BlobInspector blobInspector (cb);
-        auto val = blobInspector.dump();
-        std::cout << val << std::endl;
-    } else {
-        std::cerr << "BAD ENCODING " << cb.encoding() << " != "
-            << amqp::DATA_AND_STOP << std::endl;
 
+        // decoded in full before any of it's written so a blob that fails
+        // partway leaves nothing on stdout
+        std::string json;
+        amqp::internal::reader::StringSink buffer (json);
+
+        if (select.empty()) {
+            blobInspector.dump (buffer);
+        } else {
+            amqp::internal::reader::JsonVisitor visitor (buffer);
+            blobInspector.select (select, visitor);
+        }
+
+        buffer << "\n";
+
+        amqp::internal::reader::FdSink sink (STDOUT_FILENO);
+        sink.write (json.data(), json.size());
+        sink.flush();
+
+        if (amqp::internal::reader::Profile::enabled()) {
+            profile();
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
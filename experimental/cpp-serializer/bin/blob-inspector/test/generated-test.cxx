@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+#include "CordaBytes.h"
+
+/*
+ * Written by schema-dumper --generate at build time from the blobs below
+ */
+#include "Generated.h"
+
+const std::string filepath ("../../test-files/"); // NOLINT
+
+/******************************************************************************
+ *
+ * Generated Decoder Tests
+ *
+ ******************************************************************************/
+
+using namespace gen::net::corda::blobwriter;
+
+/******************************************************************************/
+
+namespace {
+
+    template<class T>
+    T
+    decode (const std::string & file_) {
+        CordaBytes cb (filepath + file_);
+
+        T rtn;
+        amqp::internal::decoder::decodePayload (cb.payload(), rtn);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Generated, composites) { // NOLINT
+    auto value = decode<_i_is__> ("_i_is__");
+
+    EXPECT_EQ (1, value.a);
+    EXPECT_EQ (2, value.b.a);
+    EXPECT_EQ ("three", value.b.b);
+}
+
+/******************************************************************************/
+
+TEST (Generated, maps) { // NOLINT
+    auto value = decode<_MiLs_> ("_MiLs_");
+
+    decltype (value.a) expected {
+        { 1, { "two", "three", "four" } },
+        { 5, { "six" } },
+        { 7, { } }
+    };
+
+    EXPECT_EQ (expected, value.a);
+}
+
+/******************************************************************************/
+
+TEST (Generated, nested) { // NOLINT
+    auto value = decode<__i_LMis_l__> ("__i_LMis_l__");
+
+    decltype (value.x) expected {
+        { { 1, "two" }, { 3, "four" }, { 5, "six" } },
+        { { 7, "eight" }, { 9, "ten" } }
+    };
+
+    EXPECT_EQ (expected, value.x);
+    EXPECT_EQ (1000000, value.y.x);
+    EXPECT_EQ (666, value.z.a);
+}
+
+/******************************************************************************/
+
+TEST (Generated, enums) { // NOLINT
+    auto value = decode<_Le_> ("_Le_");
+
+    EXPECT_EQ ((std::vector<E> { E::A, E::B, E::C }), value.listy);
+}
+
+/******************************************************************************/
+
+/**
+ * A decoder only accepts the type it was generated for
+ */
+TEST (Generated, wrongType) { // NOLINT
+    EXPECT_THROW (decode<_MiLs_> ("_i_is__"), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
@@ -9,6 +9,7 @@
 #include <proton/codec.h>
 #include <sys/stat.h>
 #include <sstream>
+#include <filesystem>
 
 #include "debug.h"
 
@@ -20,6 +21,11 @@
 
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/codegen/Generator.h"
+
+#include "Batch.h"
+#include "CordaBytes.h"
+#include "BlobInspector.h"
 
 /******************************************************************************/
 
@@ -28,7 +34,7 @@ printNode (pn_data_t * d_) {
     std::stringstream ss;
 
     if (pn_data_is_described (d_)) {
-        amqp::internal::AMQPDescriptorRegistory[22UL]->read (d_, ss);
+        amqp::internal::AMQPDescriptorRegistory.at (22UL)->read (d_, ss);
     }
 
     std::cout << ss.str() << std::endl;
@@ -38,51 +44,95 @@ printNode (pn_data_t * d_) {
 /******************************************************************************/
 
 void
-data_and_stop(std::ifstream & f_, ssize_t sz) {
-    char * blob = new char[sz];
-    memset (blob, 0, sz);
-    f_.read(blob, sz);
-
-    pn_data_t * d = pn_data(sz);
+data_and_stop (const CordaBytes & cb_) {
+    pn_data_t * d = pn_data (cb_.size());
 
     // returns how many bytes we processed which right now we don't care
     // about but I assume there is a case where it doesn't process the
     // entire file
-    auto rtn = pn_data_decode (d, blob, sz);
-    assert (rtn == sz);
+    auto rtn = pn_data_decode (d, cb_.bytes(), cb_.size());
+    assert (rtn == static_cast<ssize_t>(cb_.size()));
 
     printNode (d);
 
+    pn_data_free (d);
 }
 
 /******************************************************************************/
 
+/**
+ * schema-dumper --generate [--namespace <ns>] <blob|directory>...
+ *
+ * Writes a header to stdout declaring a struct for every type used by
+ * the blobs, and every blob in the directories, given along with the
+ * decoders to read them
+ */
 int
-main (int argc, char **argv) {
-    struct stat results { };
+generate (int argc, char **argv) {
+    std::string ns { "corda" };
+    std::vector<std::string> paths;
+
+    for (int i { 2 } ; i < argc ; ++i) {
+        std::string arg { argv[i] };
+
+        if (arg == "--namespace" && i + 1 < argc) {
+            ns = argv[++i];
+        } else if (std::filesystem::is_directory (arg)) {
+            auto dir = Batch::paths (arg);
+            paths.insert (paths.end(), dir.begin(), dir.end());
+        } else {
+            paths.emplace_back (std::move (arg));
+        }
+    }
 
-    if (stat(argv[1], &results) != 0) {
+    if (paths.empty()) {
+        std::cerr << "usage: " << argv[0]
+            << " --generate [--namespace <ns>] <blob|directory>..." << std::endl;
         return EXIT_FAILURE;
     }
 
-    std::ifstream f (argv[1], std::ios::in | std::ios::binary);
-    std::array<char, 7> header { };
-    f.read(header.data(), 7);
+    amqp::internal::codegen::Generator generator (ns);
 
-    if (header != amqp::AMQP_HEADER) {
-        std::cerr << "Bad Header in blob" << std::endl;
+    try {
+        for (const auto & path : paths) {
+            CordaBytes cb (path);
+            BlobInspector (cb).generate (generator);
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
-    amqp::amqp_section_id_t encoding;
-    f.read((char *)&encoding, 1);
+    generator.write (std::cout);
 
-    if (encoding == amqp::DATA_AND_STOP) {
-        data_and_stop(f, results.st_size - 8);
-    } else {
-        std::cerr << "BAD ENCODING " << encoding << " != "
-            << amqp::DATA_AND_STOP << std::endl;
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    struct stat results { };
+
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " [--generate] <blob>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (std::string (argv[1]) == "--generate") {
+        return generate (argc, argv);
+    }
+
+    if (stat(argv[1], &results) != 0) {
+        return EXIT_FAILURE;
+    }
 
+    // compressed blobs are decompressed as they're opened
+    try {
+        CordaBytes cb (argv[1]);
+        data_and_stop (cb);
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -2,11 +2,24 @@
 
 /******************************************************************************/
 
+#include <cstddef>
+
+/******************************************************************************/
+
 namespace amqp {
 
+    /**
+     * Described types are allocated from the schema arena of the thread
+     * building them when there is one, see amqp::internal::schema::Arena,
+     * and from the heap otherwise. Either way they're released with a
+     * plain delete.
+     */
     class AMQPDescribed {
         public :
             virtual ~AMQPDescribed() { }
+
+            static void * operator new (std::size_t);
+            static void operator delete (void *) noexcept;
     };
 
 }
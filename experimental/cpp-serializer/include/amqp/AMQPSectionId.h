@@ -14,6 +14,15 @@ namespace amqp {
         ENCODING          = 2
     };
 
+    /**
+     * Follows an ENCODING section id, whatever comes after it having
+     * been compressed with the one named
+     */
+    enum corda_encoding_t {
+        DEFLATE = 0,
+        SNAPPY  = 1
+    };
+
 }
 
 /******************************************************************************/
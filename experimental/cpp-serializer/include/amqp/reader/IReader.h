@@ -2,9 +2,9 @@
 
 /******************************************************************************/
 
-#include <any>
-
 #include "amqp/AMQPDescribed.h"
+#include "amqp/reader/ISink.h"
+#include "amqp/reader/IVisitor.h"
 
 #include "amqp/schema/described-types/Schema.h"
 
@@ -16,6 +16,12 @@
 
 struct pn_data_t;
 
+namespace amqp::internal::decoder {
+
+    class Cursor;
+
+}
+
 /******************************************************************************
  *
  * class amqp::reader::IValue
@@ -25,13 +31,15 @@ struct pn_data_t;
 /**
  * Used by the dump method on all instantiated instances of amqp readers
  * it represents the ability to pull out a value from the blob as determined
- * by the reader type and convert it to a string formatted nicely as JSON
+ * by the reader type and convert it to a string formatted nicely as JSON,
+ * either returned or written directly into a sink
  */
 namespace amqp::reader {
 
     class IValue {
         public :
             virtual std::string dump() const = 0;
+            virtual void dump (ISink &) const = 0;
 
             virtual ~IValue() = default;
     };
@@ -56,7 +64,6 @@ namespace amqp::reader {
             virtual const std::string & name() const = 0;
             virtual const std::string & type() const = 0;
 
-            virtual std::any read (pn_data_t *) const = 0;
             virtual std::string readString (pn_data_t *) const = 0;
 
             virtual std::unique_ptr<IValue> dump(
@@ -68,6 +75,15 @@ namespace amqp::reader {
                     pn_data_t *,
                     const SchemaType &) const = 0;
 
+            /**
+             * Walk the value straight off the encoded bytes rather than
+             * building an IValue from a decoded tree, the cursor is left
+             * positioned on the next value as with dump
+             */
+            virtual void visit (
+                    amqp::internal::decoder::Cursor &,
+                    const SchemaType &,
+                    IVisitor &) const = 0;
     };
 
 }
@@ -0,0 +1,36 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::reader::ISink
+ *
+ ******************************************************************************/
+
+/**
+ * Somewhere for a dumped value to write itself. Values stream their text
+ * straight into a sink rather than returning strings that their parents
+ * then have to splice together, so the output of a whole blob is written
+ * exactly once regardless of how deeply it nests.
+ */
+namespace amqp::reader {
+
+    class ISink {
+        public :
+            virtual ~ISink() = default;
+
+            virtual void write (const char *, size_t) = 0;
+
+            ISink & operator << (std::string_view str_) {
+                write (str_.data(), str_.size());
+                return *this;
+            }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,125 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::reader::IVisitor
+ *
+ ******************************************************************************/
+
+/**
+ * Rather than building a tree of values that then gets dumped, readers
+ * can walk a blob and tell a visitor what they find as they find it.
+ *
+ * Inside an object every value is preceded by a call to field naming the
+ * property it belongs to. Inside a map values alternate between key and
+ * value. Strings passed to a visitor are only valid for the duration of
+ * the call.
+ *
+ * Bytes and shorts arrive as an int32_t, timestamps as their milliseconds
+ * since the epoch and chars, UUIDs, symbols and decimals as text. Floats
+ * arrive as a float, which a visitor with no use for the difference can
+ * leave to go on to value (double).
+ */
+namespace amqp::reader {
+
+    class IVisitor {
+        public :
+            virtual ~IVisitor() = default;
+
+            virtual void startObject() = 0;
+            virtual void endObject() = 0;
+
+            virtual void field (std::string_view) = 0;
+
+            virtual void startList() = 0;
+            virtual void endList() = 0;
+
+            virtual void startMap() = 0;
+            virtual void endMap() = 0;
+
+            virtual void value (bool) = 0;
+            virtual void value (int32_t) = 0;
+            virtual void value (int64_t) = 0;
+            virtual void value (double) = 0;
+            virtual void value (std::string_view) = 0;
+            virtual void value (float);
+
+            /**
+             * A byte[], which unlike a string needn't be text
+             */
+            virtual void binary (std::string_view) = 0;
+
+            /**
+             * A run of elements of a list or array read in one go. Each
+             * goes to value in turn unless overridden by a visitor that
+             * can take them as a block.
+             */
+            virtual void values (const bool *, size_t);
+            virtual void values (const int32_t *, size_t);
+            virtual void values (const int64_t *, size_t);
+            virtual void values (const double *, size_t);
+            virtual void values (const float *, size_t);
+
+            /**
+             * The chosen constant of an enumeration
+             */
+            virtual void enumValue (std::string_view) = 0;
+    };
+
+}
+
+/******************************************************************************/
+
+inline void
+amqp::reader::
+IVisitor::values (const bool * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+/******************************************************************************/
+
+inline void
+amqp::reader::
+IVisitor::values (const int32_t * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+/******************************************************************************/
+
+inline void
+amqp::reader::
+IVisitor::values (const int64_t * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+/******************************************************************************/
+
+inline void
+amqp::reader::
+IVisitor::values (const double * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+/******************************************************************************/
+
+inline void
+amqp::reader::
+IVisitor::values (const float * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+/******************************************************************************/
+
+inline void
+amqp::reader::
+IVisitor::value (float value_) {
+    value (static_cast<double>(value_));
+}
+
+/******************************************************************************/
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include "types.h"
 
 #include "amqp/AMQPDescribed.h"
@@ -10,7 +12,7 @@ namespace amqp::schema {
     class ISchema {
         public :
             virtual Iterator fromType (const std::string &) const = 0;
-            virtual Iterator fromDescriptor (const std::string &) const = 0;
+            virtual Iterator fromDescriptor (std::string_view) const = 0;
     };
 
 }
\ No newline at end of file
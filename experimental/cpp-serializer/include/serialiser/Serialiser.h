@@ -2,14 +2,122 @@
 
 /******************************************************************************/
 
+#include <map>
+#include <string>
+#include <typeindex>
+#include <string_view>
+
+#include "amqp/encoder/Type.h"
+#include "amqp/encoder/Encoder.h"
+
+/******************************************************************************/
+
+namespace serialiser {
+
+    template<class T, class M>
+    struct Field {
+        using type = M;
+
+        const char * m_name;
+        M T::* m_member;
+    };
+
+    template<class T, class M>
+    constexpr Field<T, M>
+    field (const char * name_, M T::* member_) {
+        return { name_, member_ };
+    }
+
+    /**
+     * Specialise for each C++ type to be written as a Java class, naming
+     * the class and listing its fields in the order they're written
+     *
+     *   template<>
+     *   struct serialiser::Class<Point> {
+     *       static constexpr const char * name = "net.corda.Point";
+     *       static constexpr auto fields = std::make_tuple (
+     *           serialiser::field ("x", &Point::x),
+     *           serialiser::field ("y", &Point::y));
+     *   };
+     *
+     * Fields may be any of int8_t, int16_t, int32_t, int64_t, bool,
+     * char32_t, float, double, std::string, the decoder's Timestamp, Uuid
+     * and Decimal, std::vector<std::byte> for a byte[], another registered
+     * class, or a std::vector, std::map or vector of pairs of them.
+     */
+    template<class T>
+    struct Class;
+
+}
+
+/******************************************************************************/
+
 namespace serialiser {
 
+    /**
+     * Writes C++ values as Corda AMQP blobs, header, envelope, payload
+     * and the schema describing it.
+     *
+     * Every blob is written into the one buffer, grown as needed but
+     * otherwise kept from one blob to the next, so once it's big enough
+     * writing a blob allocates nothing. The schema for a type depends on
+     * nothing but the type, so it's encoded the first time a value of that
+     * type is written and copied in whole thereafter.
+     *
+     * A serialiser isn't thread safe, use one per thread.
+     */
     class Serialiser {
+        private :
+            std::string m_buffer;
+
+            amqp::internal::encoder::Encoder m_encoder;
+
+            /**
+             * Encoded schema sections by the type at the root of the blob
+             */
+            std::map<std::type_index, std::string> m_schemas;
+
+            void begin();
+
+            const std::string & schema (
+                const std::type_index &,
+                void (*)(amqp::internal::encoder::TypeSet &));
+
+            void end (const std::string &);
+
+        public :
+            explicit Serialiser (size_t capacity_ = 4096);
 
+            Serialiser (const Serialiser &) = delete;
+            Serialiser & operator = (const Serialiser &) = delete;
+
+            /**
+             * @return the blob, which remains good until the next
+             * call to serialise
+             */
+            template<class T>
+            std::string_view serialise (const T &);
+
+            size_t schemas() const { return m_schemas.size(); }
     };
 
 }
 
 /******************************************************************************/
 
+template<class T>
+std::string_view
+serialiser::
+Serialiser::serialise (const T & value_) {
+    using Type = amqp::internal::encoder::Type<T>;
+
+    const auto & schema = this->schema (typeid (T), &Type::describe);
+
+    begin();
+    Type::write (m_encoder, value_);
+    end (schema);
 
+    return m_buffer;
+}
+
+/******************************************************************************/
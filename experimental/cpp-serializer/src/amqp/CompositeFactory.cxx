@@ -127,11 +127,13 @@ CompositeFactory::processComposite (
 ) {
     DBG ("processComposite - " << type_.name() << std::endl);
     std::vector<std::weak_ptr<reader::Reader>> readers;
+    std::vector<std::string> names;
 
     const auto & fields = dynamic_cast<const schema::Composite &> (
             type_).fields();
 
     readers.reserve (fields.size());
+    names.reserve (fields.size());
 
     for (const auto & field : fields) {
         DBG ("  Field: " << field->name() << ": \"" << field->type()
@@ -157,10 +159,12 @@ CompositeFactory::processComposite (
 
         assert (reader);
         readers.emplace_back (reader);
+        names.emplace_back (field->name());
         assert (readers.back().lock());
     }
 
-    return std::make_shared<reader::CompositeReader> (type_.name(), readers);
+    return std::make_shared<reader::CompositeReader> (
+            type_.name(), type_.descriptor(), readers, std::move (names));
 }
 
 /******************************************************************************/
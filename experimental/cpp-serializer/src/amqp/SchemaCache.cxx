@@ -0,0 +1,324 @@
+#include "SchemaCache.h"
+
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include "debug.h"
+
+#include "proton/codec.h"
+#include "proton/proton_wrapper.h"
+
+#include "decoder/Cursor.h"
+
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    /**
+     * With the cursor on a described composite or restricted type pull
+     * out its descriptor symbol without building anything. Composites
+     * carry their descriptor as the fourth element of their list,
+     * restricted types as the fifth.
+     */
+    std::string
+    typeDescriptor (decoder::Cursor & cursor_) {
+        decoder::is_described (cursor_);
+        decoder::auto_enter p (cursor_);
+        decoder::is_ulong (cursor_);
+
+        auto id = amqp::stripCorda (cursor_.getUlong());
+
+        int skip;
+        if (id == amqp::schema::descriptors::COMPOSITE_TYPE) {
+            skip = 3;
+        } else if (id == amqp::schema::descriptors::RESTRICTED_TYPE) {
+            skip = 4;
+        } else {
+            throw std::runtime_error ("Expected a composite or restricted type");
+        }
+
+        cursor_.next();
+
+        decoder::auto_list_enter ale (cursor_, true);
+
+        while (skip--) cursor_.next();
+
+        decoder::is_described (cursor_);
+        decoder::auto_enter p2 (cursor_, true);
+        decoder::auto_list_enter ale2 (cursor_, true);
+
+        decoder::is_symbol (cursor_);
+
+        return std::string (cursor_.getSymbol());
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::SchemaCache::Entry
+ *
+ ******************************************************************************/
+
+amqp::internal::
+SchemaCache::Entry::Entry (uPtr<schema::Schema> schema_)
+    : m_schema (std::move (schema_))
+{
+    m_factory.process (*m_schema);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::ISchemaType &
+amqp::internal::
+SchemaCache::Entry::schema() const {
+    return *m_schema;
+}
+
+/******************************************************************************/
+
+const std::shared_ptr<amqp::internal::CompositeFactory::ReaderType>
+amqp::internal::
+SchemaCache::Entry::byDescriptor (const std::string & descriptor_) {
+    return m_factory.byDescriptor (descriptor_);
+}
+
+/******************************************************************************/
+
+/**
+ * Path [path_] compiled against the reader for [descriptor_], locking
+ * works as it does for the cache itself
+ */
+const amqp::internal::reader::Projection &
+amqp::internal::
+SchemaCache::Entry::select (
+    const std::string & descriptor_,
+    const std::string & path_
+) {
+    auto key = descriptor_ + ' ' + path_;
+
+    {
+        std::shared_lock<std::shared_mutex> l (m_lock);
+
+        auto it = m_projections.find (key);
+
+        if (it != m_projections.end()) {
+            return *it->second;
+        }
+    }
+
+    auto reader = m_factory.byDescriptor (descriptor_);
+
+    if (!reader) {
+        throw std::runtime_error ("No reader for " + descriptor_);
+    }
+
+    auto projection = std::make_unique<reader::Projection> (reader, path_);
+
+    std::unique_lock<std::shared_mutex> l (m_lock);
+
+    return *m_projections.emplace (
+            std::move (key), std::move (projection)).first->second;
+}
+
+/******************************************************************************/
+
+/**
+ * The reader for [descriptor_] compiled into a program, compiled the first
+ * time it's asked for
+ */
+const amqp::internal::reader::Program &
+amqp::internal::
+SchemaCache::Entry::program (const std::string & descriptor_) {
+    {
+        std::shared_lock<std::shared_mutex> l (m_lock);
+
+        auto it = m_programs.find (descriptor_);
+
+        if (it != m_programs.end()) {
+            return *it->second;
+        }
+    }
+
+    auto reader = m_factory.byDescriptor (descriptor_);
+
+    if (!reader) {
+        throw std::runtime_error ("No reader for " + descriptor_);
+    }
+
+    auto program = std::make_unique<reader::Program> (reader);
+
+    std::unique_lock<std::shared_mutex> l (m_lock);
+
+    return *m_programs.emplace (
+            descriptor_, std::move (program)).first->second;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::SchemaCache
+ *
+ ******************************************************************************/
+
+amqp::internal::
+SchemaCache::SchemaCache()
+    : m_hits { 0 }
+    , m_misses { 0 }
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::SchemaCache &
+amqp::internal::
+SchemaCache::instance() {
+    static SchemaCache cache;
+
+    return cache;
+}
+
+/******************************************************************************/
+
+/**
+ * With the cursor on the described schema, return a key made of the
+ * sorted descriptors of every type it contains. Each descriptor is itself
+ * a fingerprint of its type so two schemas with the same set are
+ * interchangeable. The cursor is left where we found it.
+ */
+std::string
+amqp::internal::
+SchemaCache::fingerprint (decoder::Cursor & cursor_) {
+    std::vector<std::string> descriptors;
+
+    decoder::is_described (cursor_);
+    {
+        decoder::auto_enter p (cursor_, true);
+        decoder::auto_list_enter ale (cursor_);
+
+        while (cursor_.next()) {
+            decoder::auto_list_enter ale2 (cursor_);
+
+            while (cursor_.next()) {
+                descriptors.emplace_back (typeDescriptor (cursor_));
+            }
+        }
+    }
+
+    std::sort (descriptors.begin(), descriptors.end());
+
+    std::string rtn;
+    for (const auto & descriptor : descriptors) {
+        rtn += descriptor;
+        rtn += ';';
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * With the cursor on the described schema return the cache entry for it,
+ * building the schema and its readers only if we've not seen it before.
+ * The schema builders work from a proton tree so on a miss, and only
+ * then, we decode just the schema section into one.
+ */
+amqp::internal::SchemaCache::Entry &
+amqp::internal::
+SchemaCache::fetch (decoder::Cursor & cursor_) {
+    auto key = fingerprint (cursor_);
+
+    {
+        std::shared_lock<std::shared_mutex> l (m_lock);
+
+        auto it = m_entries.find (key);
+
+        if (it != m_entries.end()) {
+            ++m_hits;
+            return *it->second;
+        }
+    }
+
+    ++m_misses;
+
+    DBG ("SchemaCache miss: " << key << std::endl); // NOLINT
+
+    /*
+     * Build outside of the lock, if another thread beat us to it then
+     * theirs wins and ours is discarded
+     */
+    auto raw = cursor_.raw();
+
+    std::unique_ptr<pn_data_t, decltype (&pn_data_free)> data {
+            pn_data (0), &pn_data_free };
+
+    if (pn_data_decode (data.get(), raw.data(), raw.size()) != static_cast<ssize_t>(raw.size())) {
+        throw std::runtime_error ("Failed to decode schema");
+    }
+
+    pn_data_rewind (data.get());
+    pn_data_next (data.get());
+
+    auto entry = std::make_unique<Entry> (
+            schema::descriptors::dispatchDescribed<schema::Schema> (data.get()));
+
+    std::unique_lock<std::shared_mutex> l (m_lock);
+
+    auto inserted = m_entries.emplace (std::move (key), std::move (entry));
+
+    if (inserted.second) {
+        const auto & fingerprint = inserted.first->first;
+
+        for (size_t start { 0 }, end ; (end = fingerprint.find (';', start)) != std::string::npos ; start = end + 1) {
+            m_byDescriptor.emplace (
+                    fingerprint.substr (start, end - start),
+                    inserted.first->second.get());
+        }
+    }
+
+    return *inserted.first->second;
+}
+
+/******************************************************************************/
+
+amqp::internal::SchemaCache::Entry *
+amqp::internal::
+SchemaCache::find (const std::string & descriptor_) const {
+    std::shared_lock<std::shared_mutex> l (m_lock);
+
+    auto it = m_byDescriptor.find (descriptor_);
+
+    return it == m_byDescriptor.end() ? nullptr : it->second;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::size() const {
+    std::shared_lock<std::shared_mutex> l (m_lock);
+
+    return m_entries.size();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+SchemaCache::clear() {
+    std::unique_lock<std::shared_mutex> l (m_lock);
+
+    m_byDescriptor.clear();
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+/******************************************************************************/
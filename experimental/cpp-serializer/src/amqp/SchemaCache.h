@@ -0,0 +1,116 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+
+#include "types.h"
+
+#include "CompositeFactory.h"
+#include "reader/Program.h"
+#include "reader/Projection.h"
+#include "amqp/schema/described-types/Schema.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    class Cursor;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Most blobs in a vault share a small number of schemas so rather than
+     * rebuilding the schema and every reader for each blob we key the
+     * parsed schema, and the readers built from it, on the set of type
+     * descriptors (fingerprints) it contains. Those can be pulled straight
+     * from the encoded schema without building anything so a hit costs a
+     * walk of the schema section and a map lookup. Only on a miss is the
+     * schema section handed to proton to be decoded into a tree.
+     *
+     * Lookups take a shared lock so any number of decoding threads can
+     * hit concurrently, only a miss takes the exclusive lock. Entries
+     * are never removed while decoding so references handed out remain
+     * valid until clear() is called.
+     */
+    class SchemaCache {
+        public :
+            class Entry {
+                private :
+                    uPtr<schema::Schema> m_schema;
+                    CompositeFactory m_factory;
+
+                    /**
+                     * Compiled projections keyed on descriptor and path,
+                     * so a query run across a vault compiles once per
+                     * schema rather than once per blob
+                     */
+                    std::map<std::string, uPtr<reader::Projection>> m_projections;
+
+                    /**
+                     * Reader graphs compiled down to programs, by descriptor
+                     */
+                    std::map<std::string, uPtr<reader::Program>> m_programs;
+
+                    mutable std::shared_mutex m_lock;
+
+                public :
+                    explicit Entry (uPtr<schema::Schema>);
+
+                    const schema::ISchemaType & schema() const;
+
+                    const std::shared_ptr<CompositeFactory::ReaderType> byDescriptor (const std::string &);
+
+                    const reader::Projection & select (
+                            const std::string &,
+                            const std::string &);
+
+                    const reader::Program & program (const std::string &);
+            };
+
+        private :
+            std::map<std::string, uPtr<Entry>> m_entries;
+
+            /**
+             * Every entry by each of the descriptors in it, for when the
+             * payload's been seen but not yet the schema
+             */
+            std::map<std::string, Entry *> m_byDescriptor;
+            mutable std::shared_mutex m_lock;
+
+            std::atomic<size_t> m_hits;
+            std::atomic<size_t> m_misses;
+
+        public :
+            SchemaCache();
+
+            static SchemaCache & instance();
+
+            static std::string fingerprint (decoder::Cursor &);
+
+            Entry & fetch (decoder::Cursor &);
+
+            /**
+             * Some entry whose schema has a type for [descriptor_], or
+             * null if none has
+             */
+            Entry * find (const std::string & descriptor_) const;
+
+            size_t hits() const { return m_hits; }
+            size_t misses() const { return m_misses; }
+            size_t size() const;
+
+            void clear();
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,457 @@
+#include "Generator.h"
+
+#include <cctype>
+#include <ostream>
+#include <stdexcept>
+
+#include "debug.h"
+
+#include "reader/CompositeReader.h"
+#include "reader/restricted-readers/MapReader.h"
+#include "reader/restricted-readers/ListReader.h"
+#include "reader/restricted-readers/EnumReader.h"
+#include "reader/restricted-readers/ArrayReader.h"
+#include "reader/property-readers/IntPropertyReader.h"
+#include "reader/property-readers/BoolPropertyReader.h"
+#include "reader/property-readers/LongPropertyReader.h"
+#include "reader/property-readers/DoublePropertyReader.h"
+#include "reader/property-readers/StringPropertyReader.h"
+#include "reader/property-readers/BytePropertyReader.h"
+#include "reader/property-readers/ShortPropertyReader.h"
+#include "reader/property-readers/CharPropertyReader.h"
+#include "reader/property-readers/FloatPropertyReader.h"
+#include "reader/property-readers/TimestampPropertyReader.h"
+#include "reader/property-readers/UuidPropertyReader.h"
+#include "reader/property-readers/BinaryPropertyReader.h"
+#include "reader/property-readers/SymbolPropertyReader.h"
+#include "reader/property-readers/DecimalPropertyReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Anything Java allows as an identifier that C++ doesn't
+     */
+    const std::set<std::string> keywords {
+        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand",
+        "bitor", "bool", "break", "case", "catch", "char", "char16_t",
+        "char32_t", "class", "compl", "const", "constexpr", "const_cast",
+        "continue", "decltype", "default", "delete", "do", "double",
+        "dynamic_cast", "else", "enum", "explicit", "export", "extern",
+        "false", "float", "for", "friend", "goto", "if", "inline", "int",
+        "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+        "nullptr", "operator", "or", "or_eq", "private", "protected",
+        "public", "register", "reinterpret_cast", "return", "short",
+        "signed", "sizeof", "static", "static_assert", "static_cast",
+        "struct", "switch", "template", "this", "thread_local", "throw",
+        "true", "try", "typedef", "typeid", "typename", "union", "unsigned",
+        "using", "virtual", "void", "volatile", "wchar_t", "while", "xor",
+        "xor_eq"
+    };
+
+    /**
+     * Splits a Java class name into its package and the class itself,
+     * ignoring any dots in its generic parameters
+     */
+    std::pair<std::string, std::string>
+    split (const std::string & name_) {
+        auto dot = name_.rfind ('.', name_.find ('<'));
+
+        if (dot == std::string::npos) {
+            return { "", name_ };
+        }
+
+        return { name_.substr (0, dot), name_.substr (dot + 1) };
+    }
+
+    /**
+     * For the package [package_] nested under [root_]
+     */
+    std::string
+    cppNamespace (const std::string & root_, const std::string & package_) {
+        std::string rtn { root_ };
+
+        size_t start { 0 };
+        while (start < package_.size()) {
+            auto end = package_.find ('.', start);
+            if (end == std::string::npos) end = package_.size();
+
+            if (!rtn.empty()) rtn += "::";
+            rtn += amqp::internal::codegen::Generator::identifier (
+                    package_.substr (start, end - start));
+
+            start = end + 1;
+        }
+
+        return rtn;
+    }
+
+    std::string
+    quote (const std::string & str_) {
+        std::string rtn { "\"" };
+
+        for (auto c : str_) {
+            if (c == '"' || c == '\\') rtn += '\\';
+            rtn += c;
+        }
+
+        return rtn + "\"";
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::codegen::
+Generator::Generator (std::string namespace_)
+    : m_namespace (std::move (namespace_))
+    , m_schemas (0)
+{
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::codegen::
+Generator::identifier (const std::string & name_) {
+    std::string rtn;
+    rtn.reserve (name_.size() + 1);
+
+    for (auto c : name_) {
+        rtn += std::isalnum (static_cast<unsigned char>(c)) ? c : '_';
+    }
+
+    if (rtn.empty() || std::isdigit (static_cast<unsigned char>(rtn[0]))) {
+        rtn.insert (rtn.begin(), '_');
+    }
+
+    if (keywords.count (rtn)) {
+        rtn += '_';
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * Fully qualified, so the decoders can name it from their own namespace
+ */
+std::string
+amqp::internal::codegen::
+Generator::qualified (const std::string & type_) const {
+    auto [package, name] = split (type_);
+    auto ns = cppNamespace (m_namespace, package);
+
+    return (ns.empty() ? "::" : "::" + ns + "::") + identifier (name);
+}
+
+/******************************************************************************/
+
+/**
+ * The C++ type a value read by [reader_] decodes into, writing out the
+ * definition of any type of ours it needs first
+ */
+std::string
+amqp::internal::codegen::
+Generator::cppType (
+    const reader::IReader & reader_,
+    const schema::ISchemaType & schema_
+) {
+    auto element = [this, &schema_](const std::shared_ptr<reader::Reader> & r_) {
+        if (!r_) {
+            throw std::runtime_error ("Cannot generate code for a null reader");
+        }
+        return cppType (*r_, schema_);
+    };
+
+    if (dynamic_cast<const reader::IntPropertyReader *>(&reader_)) {
+        return "int32_t";
+    } else if (dynamic_cast<const reader::LongPropertyReader *>(&reader_)) {
+        return "int64_t";
+    } else if (dynamic_cast<const reader::BoolPropertyReader *>(&reader_)) {
+        return "bool";
+    } else if (dynamic_cast<const reader::DoublePropertyReader *>(&reader_)) {
+        return "double";
+    } else if (dynamic_cast<const reader::StringPropertyReader *>(&reader_)) {
+        return "std::string";
+    } else if (dynamic_cast<const reader::BytePropertyReader *>(&reader_)) {
+        return "int8_t";
+    } else if (dynamic_cast<const reader::ShortPropertyReader *>(&reader_)) {
+        return "int16_t";
+    } else if (dynamic_cast<const reader::CharPropertyReader *>(&reader_)) {
+        return "char32_t";
+    } else if (dynamic_cast<const reader::FloatPropertyReader *>(&reader_)) {
+        return "float";
+    } else if (dynamic_cast<const reader::TimestampPropertyReader *>(&reader_)) {
+        return "amqp::internal::decoder::Timestamp";
+    } else if (dynamic_cast<const reader::UuidPropertyReader *>(&reader_)) {
+        return "amqp::internal::decoder::Uuid";
+    } else if (dynamic_cast<const reader::BinaryPropertyReader *>(&reader_)) {
+        return "std::vector<std::byte>";
+    } else if (dynamic_cast<const reader::SymbolPropertyReader *>(&reader_)) {
+        return "std::string";
+    } else if (dynamic_cast<const reader::DecimalPropertyReader *>(&reader_)) {
+        return "amqp::internal::decoder::Decimal";
+    } else if (auto list = dynamic_cast<const reader::ListReader *>(&reader_)) {
+        return "std::vector<" + element (list->elementReader()) + ">";
+    } else if (auto array = dynamic_cast<const reader::ArrayReader *>(&reader_)) {
+        return "std::vector<" + element (array->elementReader()) + ">";
+    } else if (auto map = dynamic_cast<const reader::MapReader *>(&reader_)) {
+        return "std::vector<std::pair<" + element (map->keyReader()) + ", "
+            + element (map->valueReader()) + ">>";
+    } else if (auto c = dynamic_cast<const reader::CompositeReader *>(&reader_)) {
+        composite (*c, schema_);
+    } else if (auto e = dynamic_cast<const reader::EnumReader *>(&reader_)) {
+        if (begin (*e, schema_)) {
+            enumeration (*e);
+        }
+    } else {
+        throw std::runtime_error ("Cannot generate code for " + reader_.type());
+    }
+
+    return qualified (reader_.type());
+}
+
+/******************************************************************************/
+
+/**
+ * @return true if [reader_]'s type still needs writing
+ */
+bool
+amqp::internal::codegen::
+Generator::begin (
+    const reader::IReader & reader_,
+    const schema::ISchemaType & schema_
+) {
+    const auto & type = reader_.type();
+    const auto & descriptor = schema_.fromType (type)->second.get()->descriptor();
+
+    if (m_pending.count (type)) {
+        throw std::runtime_error (
+            "Cannot generate code for " + type + ", it contains itself");
+    }
+
+    auto it = m_types.find (type);
+
+    if (it != m_types.end()) {
+        if (it->second != descriptor) {
+            throw std::runtime_error (
+                "Conflicting definitions of " + type + ", " + it->second
+                    + " and " + descriptor);
+        }
+
+        return false;
+    }
+
+    m_pending.insert (type);
+    m_types.emplace (type, descriptor);
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Field types are resolved, and so written, before we start on the
+ * struct itself so everything it holds is complete by the time it's
+ * declared
+ */
+void
+amqp::internal::codegen::
+Generator::composite (
+    const reader::CompositeReader & reader_,
+    const schema::ISchemaType & schema_
+) {
+    if (!begin (reader_, schema_)) {
+        return;
+    }
+
+    const auto & type = reader_.type();
+    const auto & descriptor = m_types.at (type);
+    const auto name = qualified (type);
+
+    std::vector<std::pair<std::string, std::string>> fields;
+
+    for (size_t i { 0 } ; i < reader_.fieldCount() ; ++i) {
+        auto field = reader_.field (i);
+
+        if (!field) {
+            throw std::runtime_error (
+                "null field reader: " + reader_.fieldName (i));
+        }
+
+        fields.emplace_back (
+            cppType (*field, schema_),
+            identifier (reader_.fieldName (i)));
+    }
+
+    DBG ("Generating " << type << " as " << name << std::endl); // NOLINT
+
+    auto ns = cppNamespace (m_namespace, split (type).first);
+
+    if (!ns.empty()) {
+        m_structs << "namespace " << ns << " {\n\n";
+    }
+
+    m_structs
+        << "    /**\n"
+        << "     * " << type << "\n"
+        << "     */\n"
+        << "    struct " << identifier (split (type).second) << " {\n";
+
+    for (const auto & field : fields) {
+        m_structs << "        " << field.first << " " << field.second << " { };\n";
+    }
+
+    m_structs << "    };\n\n";
+
+    if (!ns.empty()) {
+        m_structs << "}\n\n";
+    }
+
+    m_structs << "/" << std::string (78, '*') << "/\n\n";
+
+    m_decoders
+        << "    template<>\n"
+        << "    struct Decoder<" << name << "> {\n"
+        << "        static void decode (Cursor & cursor_, " << name << " & value_) {\n"
+        << "            auto_next an (cursor_);\n"
+        << "            auto_composite_enter ace (cursor_, " << quote (descriptor) << ");\n";
+
+    if (!fields.empty()) {
+        m_decoders << "\n";
+    }
+
+    for (const auto & field : fields) {
+        m_decoders
+            << "            amqp::internal::decoder::decode (cursor_, value_."
+            << field.second << ");\n";
+    }
+
+    m_decoders << "        }\n    };\n\n";
+
+    m_pending.erase (type);
+}
+
+/******************************************************************************/
+
+/**
+ * Enums are encoded by name so that's what we match on, an unknown name
+ * is most likely a constant added to a later version of the class
+ */
+void
+amqp::internal::codegen::
+Generator::enumeration (const reader::EnumReader & reader_) {
+    const auto & type = reader_.type();
+    const auto name = qualified (type);
+
+    auto ns = cppNamespace (m_namespace, split (type).first);
+
+    if (!ns.empty()) {
+        m_structs << "namespace " << ns << " {\n\n";
+    }
+
+    m_structs
+        << "    /**\n"
+        << "     * " << type << "\n"
+        << "     */\n"
+        << "    enum class " << identifier (split (type).second) << " {\n";
+
+    const auto & choices = reader_.choices();
+
+    for (size_t i { 0 } ; i < choices.size() ; ++i) {
+        m_structs << "        " << identifier (choices[i])
+            << (i + 1 < choices.size() ? ",\n" : "\n");
+    }
+
+    m_structs << "    };\n\n";
+
+    if (!ns.empty()) {
+        m_structs << "}\n\n";
+    }
+
+    m_structs << "/" << std::string (78, '*') << "/\n\n";
+
+    m_decoders
+        << "    template<>\n"
+        << "    struct Decoder<" << name << "> {\n"
+        << "        static void decode (Cursor & cursor_, " << name << " & value_) {\n"
+        << "            auto choice = enumChoice (cursor_);\n\n";
+
+    std::string indent { "            " };
+
+    for (size_t i { 0 } ; i < choices.size() ; ++i) {
+        m_decoders
+            << (i == 0 ? indent : " else ")
+            << "if (choice == " << quote (choices[i]) << ") {\n"
+            << indent << "    value_ = " << name << "::" << identifier (choices[i]) << ";\n"
+            << indent << "}";
+    }
+
+    if (!choices.empty()) {
+        m_decoders << " else {\n";
+        indent += "    ";
+    }
+
+    m_decoders
+        << indent << "throw std::runtime_error (\n"
+        << indent << "        \"Unknown constant \" + std::string (choice) + \" of "
+        << type << "\");\n";
+
+    if (!choices.empty()) {
+        m_decoders << "            }\n";
+    }
+
+    m_decoders << "        }\n    };\n\n";
+
+    m_pending.erase (type);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::codegen::
+Generator::add (SchemaCache::Entry & entry_, const std::string & descriptor_) {
+    auto reader = entry_.byDescriptor (descriptor_);
+
+    if (!reader) {
+        throw std::runtime_error ("No reader for " + descriptor_);
+    }
+
+    cppType (*reader, entry_.schema());
+
+    ++m_schemas;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::codegen::
+Generator::write (std::ostream & out_) const {
+    const std::string rule = "/" + std::string (78, '*') + "/\n\n";
+
+    out_
+        << "#pragma once\n\n"
+        << "/*\n"
+        << " * Generated by schema-dumper from " << m_schemas
+        << (m_schemas == 1 ? " blob" : " blobs") << ", do not edit\n"
+        << " */\n\n"
+        << rule
+        << "#include <string>\n"
+        << "#include <vector>\n"
+        << "#include <cstddef>\n"
+        << "#include <utility>\n"
+        << "#include <cstdint>\n"
+        << "#include <stdexcept>\n\n"
+        << "#include \"amqp/decoder/Decoder.h\"\n\n"
+        << rule
+        << m_structs.str()
+        << "namespace amqp::internal::decoder {\n\n"
+        << m_decoders.str()
+        << "}\n\n"
+        << rule;
+}
+
+/******************************************************************************/
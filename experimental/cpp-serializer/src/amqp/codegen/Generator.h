@@ -0,0 +1,95 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <set>
+#include <map>
+#include <string>
+#include <sstream>
+
+#include "SchemaCache.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    class EnumReader;
+    class CompositeReader;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::codegen {
+
+    /**
+     * Turns the types of one or more schemas into a C++ header, a plain
+     * struct for every composite, an enum class for every enum, and a
+     * specialisation of decoder::Decoder for each that reads its fields
+     * in the order they're encoded.
+     *
+     * Everything is generated from the reader graph rather than the schema
+     * itself so a field's type is resolved exactly as it is when we dump
+     * a blob. Lists and arrays become vectors, maps vectors of pairs.
+     *
+     * Types seen in more than one schema, as they will be across a vault,
+     * are written once. A type turning up with a different descriptor is
+     * a different version of the class and can't share a name, so that's
+     * an error.
+     */
+    class Generator {
+        private :
+            /**
+             * The namespace Java packages are nested under
+             */
+            std::string m_namespace;
+
+            /**
+             * Descriptors of the types already written, by type
+             */
+            std::map<std::string, std::string> m_types;
+
+            /**
+             * Those we're part way through, to catch a type that
+             * contains itself
+             */
+            std::set<std::string> m_pending;
+
+            size_t m_schemas;
+
+            std::stringstream m_structs;
+            std::stringstream m_decoders;
+
+            std::string qualified (const std::string &) const;
+
+            std::string cppType (
+                const reader::IReader &,
+                const schema::ISchemaType &);
+
+            bool begin (const reader::IReader &, const schema::ISchemaType &);
+
+            void composite (
+                const reader::CompositeReader &,
+                const schema::ISchemaType &);
+
+            void enumeration (const reader::EnumReader &);
+
+        public :
+            explicit Generator (std::string namespace_ = "corda");
+
+            /**
+             * The type described by [descriptor_] and everything it uses
+             */
+            void add (SchemaCache::Entry &, const std::string & descriptor_);
+
+            void write (std::ostream &) const;
+
+            /**
+             * A valid C++ identifier as close to [name_] as we can manage
+             */
+            static std::string identifier (const std::string & name_);
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,192 @@
+#include "ArrowFile.h"
+
+#include <ostream>
+#include <stdexcept>
+
+#include "Columns.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string MAGIC { "ARROW1" }; // NOLINT
+
+    constexpr uint32_t CONTINUATION = 0xFFFFFFFF;
+
+    /**
+     * V5, the current version
+     */
+    constexpr int16_t VERSION = 4;
+
+    /**
+     * Members of the MessageHeader union
+     */
+    constexpr uint8_t SCHEMA = 1;
+    constexpr uint8_t DICTIONARY_BATCH = 2;
+    constexpr uint8_t RECORD_BATCH = 3;
+
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::
+ArrowFile::ArrowFile (std::ostream & out_, Columns & columns_)
+    : m_out (out_)
+    , m_columns (columns_)
+    , m_written (0)
+    , m_started (false)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+ArrowFile::write (const std::string & bytes_) {
+    m_out.write (bytes_.data(), static_cast<std::streamsize>(bytes_.size()));
+
+    if (!m_out) {
+        throw std::runtime_error ("Failed to write Arrow file");
+    }
+
+    m_written += bytes_.size();
+}
+
+/******************************************************************************/
+
+/**
+ * A message is a continuation marker, the length of its metadata, the
+ * metadata padded so the body that follows starts on an eight byte
+ * boundary, then the body
+ */
+amqp::internal::columnar::ArrowFile::Block
+amqp::internal::columnar::
+ArrowFile::message (uint8_t type_, Flatbuffer::Offset header_, const std::string & body_) {
+    m_fb.start();
+    m_fb.add (0, VERSION);
+    m_fb.add (1, type_);
+    m_fb.offset (2, header_);
+    m_fb.add (3, static_cast<int64_t>(body_.size()));
+
+    auto metadata = m_fb.finish (m_fb.end());
+    metadata.resize ((metadata.size() + 7) & ~size_t { 7 }, '\0');
+
+    Block rtn { static_cast<int64_t>(m_written), 0, static_cast<int64_t>(body_.size()) };
+
+    std::string prefix;
+    littleEndian (prefix, CONTINUATION, sizeof (uint32_t));
+    littleEndian (prefix, metadata.size(), sizeof (int32_t));
+
+    rtn.m_metadata = static_cast<int32_t>(prefix.size() + metadata.size());
+
+    write (prefix);
+    write (metadata);
+    write (body_);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+ArrowFile::start() {
+    write (MAGIC + std::string (2, '\0'));
+
+    message (SCHEMA, m_columns.schema (m_fb), { });
+
+    for (size_t id { 0 } ; id < m_columns.dictionaries() ; ++id) {
+        RecordBatch batch;
+        m_columns.dictionary (id, batch);
+
+        auto data = batch.write (m_fb, m_columns.dictionaryLength (id));
+
+        m_fb.start();
+        m_fb.add (0, static_cast<int64_t>(id));
+        m_fb.offset (1, data);
+        m_fb.add (2, false);
+
+        m_dictionaries.push_back (message (DICTIONARY_BATCH, m_fb.end(), batch.body()));
+    }
+
+    m_started = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+ArrowFile::batch() {
+    if (!m_started) {
+        start();
+    }
+
+    RecordBatch batch;
+    m_columns.batch (batch);
+
+    auto header = batch.write (m_fb, m_columns.rows());
+
+    m_batches.push_back (message (RECORD_BATCH, header, batch.body()));
+
+    m_columns.clear();
+}
+
+/******************************************************************************/
+
+/**
+ * Block is a long offset, an int metadata length padded out to eight
+ * bytes, and a long body length
+ */
+std::string
+amqp::internal::columnar::
+ArrowFile::blocks (const std::vector<Block> & blocks_) {
+    std::string rtn;
+
+    for (const auto & block : blocks_) {
+        littleEndian (rtn, static_cast<uint64_t>(block.m_offset), sizeof (int64_t));
+        littleEndian (rtn, static_cast<uint32_t>(block.m_metadata), sizeof (int32_t));
+        littleEndian (rtn, 0, sizeof (int32_t));
+        littleEndian (rtn, static_cast<uint64_t>(block.m_body), sizeof (int64_t));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * An end of stream marker, so the file reads as a stream too, then the
+ * footer, its length and the magic again
+ */
+void
+amqp::internal::columnar::
+ArrowFile::close() {
+    if (!m_started) {
+        start();
+    }
+
+    std::string eos;
+    littleEndian (eos, CONTINUATION, sizeof (uint32_t));
+    littleEndian (eos, 0, sizeof (uint32_t));
+    write (eos);
+
+    auto schema = m_columns.schema (m_fb);
+    auto dictionaries = m_fb.vector (blocks (m_dictionaries), m_dictionaries.size(), sizeof (int64_t));
+    auto batches = m_fb.vector (blocks (m_batches), m_batches.size(), sizeof (int64_t));
+
+    m_fb.start();
+    m_fb.add (0, VERSION);
+    m_fb.offset (1, schema);
+    m_fb.offset (2, dictionaries);
+    m_fb.offset (3, batches);
+
+    auto footer = m_fb.finish (m_fb.end());
+    littleEndian (footer, footer.size(), sizeof (int32_t));
+
+    write (footer);
+    write (MAGIC);
+
+    m_out.flush();
+}
+
+/******************************************************************************/
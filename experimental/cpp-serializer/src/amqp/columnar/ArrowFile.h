@@ -0,0 +1,75 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Flatbuffer.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::columnar {
+
+    class Columns;
+    class RecordBatch;
+
+    /**
+     * Writes columns out in the Arrow IPC file format, readable by
+     * anything that reads Arrow without anything but this process
+     * having produced it.
+     *
+     * The file's schema and enum dictionaries are written ahead of the
+     * first batch, each batch then being whatever rows the columns hold,
+     * after which they're emptied for the next. Closing writes the footer
+     * indexing them all.
+     */
+    class ArrowFile {
+        private :
+            struct Block {
+                int64_t m_offset;
+                int32_t m_metadata;
+                int64_t m_body;
+            };
+
+            std::ostream & m_out;
+            Columns & m_columns;
+
+            uint64_t m_written;
+            bool m_started;
+
+            std::vector<Block> m_dictionaries;
+            std::vector<Block> m_batches;
+
+            Flatbuffer m_fb;
+
+            void write (const std::string &);
+
+            /**
+             * The message whose header is [header_], a member of the
+             * MessageHeader union, followed by [body_]
+             */
+            Block message (uint8_t type_, Flatbuffer::Offset header_, const std::string & body_);
+
+            void start();
+
+            static std::string blocks (const std::vector<Block> &);
+
+        public :
+            ArrowFile (std::ostream &, Columns &);
+
+            ArrowFile (const ArrowFile &) = delete;
+            ArrowFile & operator = (const ArrowFile &) = delete;
+
+            void batch();
+
+            void close();
+
+            size_t batches() const { return m_batches.size(); }
+    };
+
+}
+
+/******************************************************************************/
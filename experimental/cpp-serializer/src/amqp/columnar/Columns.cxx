@@ -0,0 +1,1070 @@
+#include "Columns.h"
+
+#include <map>
+#include <array>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "reader/CompositeReader.h"
+#include "reader/restricted-readers/MapReader.h"
+#include "reader/restricted-readers/ListReader.h"
+#include "reader/restricted-readers/EnumReader.h"
+#include "reader/restricted-readers/ArrayReader.h"
+#include "reader/property-readers/IntPropertyReader.h"
+#include "reader/property-readers/BoolPropertyReader.h"
+#include "reader/property-readers/LongPropertyReader.h"
+#include "reader/property-readers/DoublePropertyReader.h"
+#include "reader/property-readers/StringPropertyReader.h"
+#include "reader/property-readers/BytePropertyReader.h"
+#include "reader/property-readers/ShortPropertyReader.h"
+#include "reader/property-readers/CharPropertyReader.h"
+#include "reader/property-readers/FloatPropertyReader.h"
+#include "reader/property-readers/TimestampPropertyReader.h"
+#include "reader/property-readers/UuidPropertyReader.h"
+#include "reader/property-readers/BinaryPropertyReader.h"
+#include "reader/property-readers/SymbolPropertyReader.h"
+#include "reader/property-readers/DecimalPropertyReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::columnar::Column;
+    using amqp::internal::columnar::Flatbuffer;
+    using amqp::internal::columnar::RecordBatch;
+    using amqp::internal::columnar::littleEndian;
+
+    /**
+     * Members of Arrow's Type union
+     */
+    namespace arrow {
+
+        constexpr uint8_t Int = 2;
+        constexpr uint8_t FloatingPoint = 3;
+        constexpr uint8_t Binary = 4;
+        constexpr uint8_t Utf8 = 5;
+        constexpr uint8_t Bool = 6;
+        constexpr uint8_t Timestamp = 10;
+        constexpr uint8_t List = 12;
+        constexpr uint8_t Struct = 13;
+        constexpr uint8_t Map = 17;
+
+        constexpr int16_t DOUBLE = 2;
+        constexpr int16_t MILLISECOND = 1;
+
+    }
+
+    /**
+     * A type with nothing to say beyond what it is
+     */
+    Flatbuffer::Offset
+    empty (Flatbuffer & fb_) {
+        fb_.start();
+        return fb_.end();
+    }
+
+    Flatbuffer::Offset
+    integer (Flatbuffer & fb_, int32_t bits_) {
+        fb_.start();
+        fb_.add (0, bits_);
+        fb_.add (1, true);
+        return fb_.end();
+    }
+
+    /**
+     * List offsets are 32 bits, a batch big enough to need more should
+     * be split into several
+     */
+    void
+    offset (std::string & offsets_, int64_t offset_) {
+        if (offset_ > std::numeric_limits<int32_t>::max()) {
+            throw std::runtime_error ("Too many values for one batch, write fewer rows per batch");
+        }
+
+        littleEndian (offsets_, static_cast<uint64_t>(offset_), sizeof (int32_t));
+    }
+
+    /******************************************************************************/
+
+    /**
+     * Fixed width values, as many bytes a value as they take in memory
+     */
+    template<typename T>
+    class PrimitiveColumn : public Column {
+        private :
+            std::string m_values;
+
+            static Flatbuffer::Offset type (Flatbuffer &);
+
+        public :
+            explicit PrimitiveColumn (std::string name_) : Column (std::move (name_)) { }
+
+            using Column::value;
+            using Column::values;
+
+            void value (T value_) override {
+                uint64_t bits { 0 };
+                std::memcpy (&bits, &value_, sizeof (T));
+
+                littleEndian (m_values, bits, sizeof (T));
+                ++m_length;
+            }
+
+            /**
+             * Already laid out as Arrow wants them on a little endian
+             * host so a run is appended whole
+             */
+            void values (const T * values_, size_t count_) override {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                m_values.append (reinterpret_cast<const char *>(values_), count_ * sizeof (T));
+                m_length += static_cast<int64_t>(count_);
+#else
+                for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+#endif
+            }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                auto type_ = type (fb_);
+                return describe (fb_, std::is_floating_point_v<T> ? arrow::FloatingPoint : arrow::Int, type_);
+            }
+
+            void batch (RecordBatch & batch_) const override {
+                batch_.node (m_length, 0);
+                batch_.validity();
+                batch_.buffer (m_values);
+            }
+
+            void clear() override {
+                m_values.clear();
+                m_length = 0;
+            }
+    };
+
+    template<>
+    Flatbuffer::Offset
+    PrimitiveColumn<int32_t>::type (Flatbuffer & fb_) {
+        return integer (fb_, 32);
+    }
+
+    template<>
+    Flatbuffer::Offset
+    PrimitiveColumn<int64_t>::type (Flatbuffer & fb_) {
+        return integer (fb_, 64);
+    }
+
+    template<>
+    Flatbuffer::Offset
+    PrimitiveColumn<double>::type (Flatbuffer & fb_) {
+        fb_.start();
+        fb_.add (0, arrow::DOUBLE);
+        return fb_.end();
+    }
+
+    /******************************************************************************/
+
+    /**
+     * A bit a value, least significant first
+     */
+    class BoolColumn : public Column {
+        private :
+            std::string m_bits;
+
+        public :
+            explicit BoolColumn (std::string name_) : Column (std::move (name_)) { }
+
+            using Column::value;
+
+            void value (bool value_) override {
+                if (m_length % 8 == 0) {
+                    m_bits.push_back (0);
+                }
+
+                if (value_) {
+                    m_bits.back() = static_cast<char>(m_bits.back() | (1 << (m_length % 8)));
+                }
+
+                ++m_length;
+            }
+
+            using Column::values;
+
+            void values (const bool * values_, size_t count_) override {
+                for (size_t i { 0 } ; i < count_ ; ++i) {
+                    BoolColumn::value (values_[i]);
+                }
+            }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                return describe (fb_, arrow::Bool, empty (fb_));
+            }
+
+            void batch (RecordBatch & batch_) const override {
+                batch_.node (m_length, 0);
+                batch_.validity();
+                batch_.buffer (m_bits);
+            }
+
+            void clear() override {
+                m_bits.clear();
+                m_length = 0;
+            }
+    };
+
+    /******************************************************************************/
+
+    /**
+     * Every string end to end with the offset of each, plus one for the
+     * end of the last
+     */
+    class StringColumn : public Column {
+        private :
+            std::string m_offsets;
+            std::string m_data;
+
+        public :
+            explicit StringColumn (std::string name_) : Column (std::move (name_)) {
+                clear();
+            }
+
+            using Column::value;
+
+            void value (std::string_view value_) override {
+                m_data.append (value_.data(), value_.size());
+                offset (m_offsets, static_cast<int64_t>(m_data.size()));
+                ++m_length;
+            }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                return describe (fb_, arrow::Utf8, empty (fb_));
+            }
+
+            void batch (RecordBatch & batch_) const override {
+                batch_.node (m_length, 0);
+                batch_.validity();
+                batch_.buffer (m_offsets);
+                batch_.buffer (m_data);
+            }
+
+            void clear() override {
+                m_offsets.clear();
+                m_data.clear();
+                offset (m_offsets, 0);
+                m_length = 0;
+            }
+    };
+
+    /******************************************************************************/
+
+    /**
+     * Laid out as a string is but the values needn't be text
+     */
+    class BinaryColumn : public StringColumn {
+        public :
+            explicit BinaryColumn (std::string name_) : StringColumn (std::move (name_)) { }
+
+            void value (std::string_view) override {
+                mismatch ("string");
+            }
+
+            void binary (std::string_view value_) override {
+                StringColumn::value (value_);
+            }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                return describe (fb_, arrow::Binary, empty (fb_));
+            }
+    };
+
+    /******************************************************************************/
+
+    /**
+     * Milliseconds since the epoch, UTC, a long as far as the values go
+     */
+    class TimestampColumn : public PrimitiveColumn<int64_t> {
+        public :
+            explicit TimestampColumn (std::string name_)
+                : PrimitiveColumn<int64_t> (std::move (name_))
+            { }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                auto timezone = fb_.string ("UTC");
+
+                fb_.start();
+                fb_.add (0, arrow::MILLISECOND);
+                fb_.offset (1, timezone);
+                auto type = fb_.end();
+
+                return describe (fb_, arrow::Timestamp, type);
+            }
+    };
+
+    /******************************************************************************/
+
+    /**
+     * Lists and arrays alike, where each one's elements end within the
+     * column of elements
+     */
+    class ListColumn : public Column {
+        private :
+            std::string m_offsets;
+            std::unique_ptr<Column> m_item;
+
+        public :
+            ListColumn (std::string name_, std::unique_ptr<Column> item_)
+                : Column (std::move (name_))
+                , m_item (std::move (item_))
+            {
+                offset (m_offsets, 0);
+            }
+
+            void startList() override { }
+
+            void end() override {
+                offset (m_offsets, m_item->length());
+                ++m_length;
+            }
+
+            Column & next() override { return *m_item; }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                std::vector<Flatbuffer::Offset> children { m_item->schema (fb_) };
+                return describe (fb_, arrow::List, empty (fb_), children);
+            }
+
+            void batch (RecordBatch & batch_) const override {
+                batch_.node (m_length, 0);
+                batch_.validity();
+                batch_.buffer (m_offsets);
+
+                m_item->batch (batch_);
+            }
+
+            void clear() override {
+                m_item->clear();
+                m_offsets.clear();
+                offset (m_offsets, 0);
+                m_length = 0;
+            }
+    };
+
+    /******************************************************************************/
+
+    /**
+     * Arrow's map is a list of key value structs, those being the column
+     * of keys and the column of values. Keys and values arrive turn and
+     * turn about.
+     */
+    class MapColumn : public Column {
+        private :
+            std::string m_offsets;
+            std::unique_ptr<Column> m_key;
+            std::unique_ptr<Column> m_value;
+            bool m_isKey;
+
+        public :
+            MapColumn (
+                std::string name_,
+                std::unique_ptr<Column> key_,
+                std::unique_ptr<Column> value_
+            ) : Column (std::move (name_))
+              , m_key (std::move (key_))
+              , m_value (std::move (value_))
+              , m_isKey (true)
+            {
+                offset (m_offsets, 0);
+            }
+
+            void startMap() override {
+                m_isKey = true;
+            }
+
+            void end() override {
+                offset (m_offsets, m_key->length());
+                ++m_length;
+            }
+
+            Column & next() override {
+                auto & rtn = m_isKey ? *m_key : *m_value;
+                m_isKey = !m_isKey;
+                return rtn;
+            }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                std::vector<Flatbuffer::Offset> entries { m_key->schema (fb_), m_value->schema (fb_) };
+
+                auto name = fb_.string ("entries");
+                auto type = empty (fb_);
+                auto children = fb_.vector (entries);
+
+                fb_.start();
+                fb_.offset (0, name);
+                fb_.add (1, false);
+                fb_.add (2, arrow::Struct);
+                fb_.offset (3, type);
+                fb_.offset (5, children);
+
+                std::vector<Flatbuffer::Offset> child { fb_.end() };
+
+                fb_.start();
+                fb_.add (0, false);
+                auto map = fb_.end();
+
+                return describe (fb_, arrow::Map, map, child);
+            }
+
+            void batch (RecordBatch & batch_) const override {
+                batch_.node (m_length, 0);
+                batch_.validity();
+                batch_.buffer (m_offsets);
+
+                batch_.node (m_key->length(), 0);
+                batch_.validity();
+
+                m_key->batch (batch_);
+                m_value->batch (batch_);
+            }
+
+            void clear() override {
+                m_key->clear();
+                m_value->clear();
+                m_offsets.clear();
+                offset (m_offsets, 0);
+                m_length = 0;
+            }
+    };
+
+    /******************************************************************************/
+
+    /**
+     * Each constant as its index in the enum's dictionary, the constants
+     * themselves are written once for the whole file
+     */
+    class DictionaryColumn : public Column {
+        private :
+            int64_t m_id;
+            std::string m_indices;
+            std::map<std::string, int32_t, std::less<>> m_choices;
+
+        public :
+            DictionaryColumn (
+                std::string name_,
+                int64_t id_,
+                const std::vector<std::string> & choices_
+            ) : Column (std::move (name_))
+              , m_id (id_)
+            {
+                for (const auto & choice : choices_) {
+                    m_choices.emplace (choice, static_cast<int32_t>(m_choices.size()));
+                }
+            }
+
+            void enumValue (std::string_view value_) override {
+                auto it = m_choices.find (value_);
+
+                if (it == m_choices.end()) {
+                    throw std::runtime_error (
+                        "Unknown constant " + std::string (value_) + " of " + m_name);
+                }
+
+                littleEndian (m_indices, static_cast<uint32_t>(it->second), sizeof (int32_t));
+                ++m_length;
+            }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                auto index = integer (fb_, 32);
+
+                fb_.start();
+                fb_.add (0, m_id);
+                fb_.offset (1, index);
+                fb_.add (2, false);
+                auto dictionary = fb_.end();
+
+                return describe (fb_, arrow::Utf8, empty (fb_), { }, dictionary);
+            }
+
+            void batch (RecordBatch & batch_) const override {
+                batch_.node (m_length, 0);
+                batch_.validity();
+                batch_.buffer (m_indices);
+            }
+
+            void clear() override {
+                m_indices.clear();
+                m_length = 0;
+            }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::columnar::StructColumn
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::columnar {
+
+    /**
+     * A composite, a column per field. Fields are visited in the order
+     * they're declared so we look for the next first.
+     */
+    class StructColumn : public Column {
+        private :
+            std::vector<std::unique_ptr<Column>> m_columns;
+            size_t m_field;
+
+        public :
+            StructColumn (std::string name_, std::vector<std::unique_ptr<Column>> columns_)
+                : Column (std::move (name_))
+                , m_columns (std::move (columns_))
+                , m_field (0)
+            { }
+
+            const std::vector<std::unique_ptr<Column>> & columns() const { return m_columns; }
+
+            void startObject() override {
+                m_field = m_columns.size() - 1;
+            }
+
+            void end() override {
+                ++m_length;
+            }
+
+            void field (std::string_view name_) override {
+                for (size_t i { 1 } ; i <= m_columns.size() ; ++i) {
+                    auto field = (m_field + i) % m_columns.size();
+
+                    if (m_columns[field]->name() == name_) {
+                        m_field = field;
+                        return;
+                    }
+                }
+
+                throw std::runtime_error (
+                    "No column " + std::string (name_) + " within " + m_name);
+            }
+
+            Column & next() override {
+                if (m_columns.empty()) {
+                    mismatch ("field");
+                }
+
+                return *m_columns[m_field];
+            }
+
+            Flatbuffer::Offset schema (Flatbuffer & fb_) const override {
+                std::vector<Flatbuffer::Offset> children;
+                children.reserve (m_columns.size());
+
+                for (const auto & column : m_columns) {
+                    children.push_back (column->schema (fb_));
+                }
+
+                return describe (fb_, arrow::Struct, empty (fb_), children);
+            }
+
+            void batch (RecordBatch & batch_) const override {
+                batch_.node (m_length, 0);
+                batch_.validity();
+
+                for (const auto & column : m_columns) {
+                    column->batch (batch_);
+                }
+            }
+
+            void clear() override {
+                for (auto & column : m_columns) {
+                    column->clear();
+                }
+
+                m_length = 0;
+            }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::columnar::RecordBatch
+ *
+ ******************************************************************************/
+
+amqp::internal::columnar::
+RecordBatch::RecordBatch()
+    : m_nodeCount (0)
+    , m_bufferCount (0)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+RecordBatch::node (int64_t length_, int64_t nulls_) {
+    littleEndian (m_nodes, static_cast<uint64_t>(length_), sizeof (int64_t));
+    littleEndian (m_nodes, static_cast<uint64_t>(nulls_), sizeof (int64_t));
+
+    ++m_nodeCount;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+RecordBatch::buffer (std::string_view buffer_) {
+    littleEndian (m_buffers, m_body.size(), sizeof (int64_t));
+    littleEndian (m_buffers, buffer_.size(), sizeof (int64_t));
+
+    m_body.append (buffer_.data(), buffer_.size());
+    m_body.resize ((m_body.size() + 7) & ~size_t { 7 }, '\0');
+
+    ++m_bufferCount;
+}
+
+/******************************************************************************/
+
+/**
+ * FieldNode and Buffer are both structs of two longs
+ */
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+RecordBatch::write (Flatbuffer & fb_, int64_t length_) const {
+    auto nodes = fb_.vector (m_nodes, m_nodeCount, sizeof (int64_t));
+    auto buffers = fb_.vector (m_buffers, m_bufferCount, sizeof (int64_t));
+
+    fb_.start();
+    fb_.add (0, length_);
+    fb_.offset (1, nodes);
+    fb_.offset (2, buffers);
+
+    return fb_.end();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::columnar::Column
+ *
+ ******************************************************************************/
+
+amqp::internal::columnar::
+Column::Column (std::string name_)
+    : m_name (std::move (name_))
+    , m_length (0)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Column::mismatch (const char * what_) const {
+    throw std::runtime_error ("Column " + m_name + " can't hold a " + what_);
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+Column::describe (
+    Flatbuffer & fb_,
+    uint8_t typeType_,
+    Flatbuffer::Offset type_,
+    const std::vector<Flatbuffer::Offset> & children_,
+    Flatbuffer::Offset dictionary_
+) const {
+    auto name = fb_.string (m_name);
+    auto children = fb_.vector (children_);
+
+    fb_.start();
+    fb_.offset (0, name);
+    fb_.add (1, false);
+    fb_.add (2, typeType_);
+    fb_.offset (3, type_);
+    if (dictionary_) fb_.offset (4, dictionary_);
+    fb_.offset (5, children);
+
+    return fb_.end();
+}
+
+/******************************************************************************/
+
+void amqp::internal::columnar::Column::startObject() { mismatch ("composite"); }
+void amqp::internal::columnar::Column::startList() { mismatch ("list"); }
+void amqp::internal::columnar::Column::startMap() { mismatch ("map"); }
+void amqp::internal::columnar::Column::end() { }
+
+void amqp::internal::columnar::Column::field (std::string_view) { mismatch ("field"); }
+
+amqp::internal::columnar::Column &
+amqp::internal::columnar::Column::next() { mismatch ("value within it"); }
+
+void amqp::internal::columnar::Column::value (bool) { mismatch ("boolean"); }
+void amqp::internal::columnar::Column::value (int32_t) { mismatch ("int"); }
+void amqp::internal::columnar::Column::value (int64_t) { mismatch ("long"); }
+void amqp::internal::columnar::Column::value (double) { mismatch ("double"); }
+void amqp::internal::columnar::Column::value (std::string_view) { mismatch ("string"); }
+void amqp::internal::columnar::Column::binary (std::string_view) { mismatch ("binary"); }
+void amqp::internal::columnar::Column::enumValue (std::string_view) { mismatch ("enum"); }
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Column::values (const bool * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+void
+amqp::internal::columnar::
+Column::values (const int32_t * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+void
+amqp::internal::columnar::
+Column::values (const int64_t * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+void
+amqp::internal::columnar::
+Column::values (const double * values_, size_t count_) {
+    for (size_t i { 0 } ; i < count_ ; ++i) value (values_[i]);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::columnar::Columns
+ *
+ ******************************************************************************/
+
+amqp::internal::columnar::
+Columns::Columns() = default;
+
+amqp::internal::columnar::
+Columns::~Columns() = default;
+
+/******************************************************************************/
+
+/**
+ * Laid out from the readers, as the code generator does, so a field's
+ * type is resolved exactly as it is when we dump a blob
+ */
+std::unique_ptr<amqp::internal::columnar::Column>
+amqp::internal::columnar::
+Columns::make (const std::string & name_, const reader::IReader & reader_) {
+    auto element = [this](const std::string & name, const std::shared_ptr<reader::Reader> & r_) {
+        if (!r_) {
+            throw std::runtime_error ("Cannot lay out a column for a null reader");
+        }
+        return make (name, *r_);
+    };
+
+    if (dynamic_cast<const reader::IntPropertyReader *>(&reader_)) {
+        return std::make_unique<PrimitiveColumn<int32_t>> (name_);
+    } else if (dynamic_cast<const reader::LongPropertyReader *>(&reader_)) {
+        return std::make_unique<PrimitiveColumn<int64_t>> (name_);
+    } else if (dynamic_cast<const reader::BoolPropertyReader *>(&reader_)) {
+        return std::make_unique<BoolColumn> (name_);
+    } else if (dynamic_cast<const reader::DoublePropertyReader *>(&reader_)) {
+        return std::make_unique<PrimitiveColumn<double>> (name_);
+    } else if (dynamic_cast<const reader::StringPropertyReader *>(&reader_)) {
+        return std::make_unique<StringColumn> (name_);
+    } else if (dynamic_cast<const reader::BytePropertyReader *>(&reader_)
+            || dynamic_cast<const reader::ShortPropertyReader *>(&reader_))
+    {
+        return std::make_unique<PrimitiveColumn<int32_t>> (name_);
+    } else if (dynamic_cast<const reader::FloatPropertyReader *>(&reader_)) {
+        return std::make_unique<PrimitiveColumn<double>> (name_);
+    } else if (dynamic_cast<const reader::TimestampPropertyReader *>(&reader_)) {
+        return std::make_unique<TimestampColumn> (name_);
+    } else if (dynamic_cast<const reader::BinaryPropertyReader *>(&reader_)) {
+        return std::make_unique<BinaryColumn> (name_);
+    } else if (dynamic_cast<const reader::CharPropertyReader *>(&reader_)
+            || dynamic_cast<const reader::UuidPropertyReader *>(&reader_)
+            || dynamic_cast<const reader::SymbolPropertyReader *>(&reader_)
+            || dynamic_cast<const reader::DecimalPropertyReader *>(&reader_))
+    {
+        return std::make_unique<StringColumn> (name_);
+    } else if (auto list = dynamic_cast<const reader::ListReader *>(&reader_)) {
+        return std::make_unique<ListColumn> (name_, element ("item", list->elementReader()));
+    } else if (auto array = dynamic_cast<const reader::ArrayReader *>(&reader_)) {
+        return std::make_unique<ListColumn> (name_, element ("item", array->elementReader()));
+    } else if (auto map = dynamic_cast<const reader::MapReader *>(&reader_)) {
+        return std::make_unique<MapColumn> (
+            name_,
+            element ("key", map->keyReader()),
+            element ("value", map->valueReader()));
+    } else if (auto c = dynamic_cast<const reader::CompositeReader *>(&reader_)) {
+        return composite (name_, *c);
+    } else if (auto e = dynamic_cast<const reader::EnumReader *>(&reader_)) {
+        auto dictionary = std::make_unique<StringColumn> (e->type());
+        for (const auto & choice : e->choices()) {
+            dictionary->value (choice);
+        }
+
+        m_dictionaries.push_back (std::move (dictionary));
+
+        return std::make_unique<DictionaryColumn> (
+            name_, m_dictionaries.size() - 1, e->choices());
+    }
+
+    throw std::runtime_error ("Cannot lay out a column for " + reader_.type());
+}
+
+/******************************************************************************/
+
+std::unique_ptr<amqp::internal::columnar::StructColumn>
+amqp::internal::columnar::
+Columns::composite (const std::string & name_, const reader::CompositeReader & reader_) {
+    const auto & type = reader_.type();
+
+    if (!m_pending.insert (type).second) {
+        throw std::runtime_error (
+            "Cannot lay out columns for " + type + ", it contains itself");
+    }
+
+    std::vector<std::unique_ptr<Column>> columns;
+    columns.reserve (reader_.fieldCount());
+
+    for (size_t i { 0 } ; i < reader_.fieldCount() ; ++i) {
+        auto field = reader_.field (i);
+
+        if (!field) {
+            throw std::runtime_error ("null field reader: " + reader_.fieldName (i));
+        }
+
+        columns.push_back (make (reader_.fieldName (i), *field));
+    }
+
+    m_pending.erase (type);
+
+    return std::make_unique<StructColumn> (name_, std::move (columns));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Columns::type (const reader::IReader & reader_, const std::string & descriptor_) {
+    if (m_root) {
+        if (descriptor_ != m_descriptor) {
+            throw std::runtime_error (
+                "Cannot add a " + reader_.type() + " to columns of " + m_type);
+        }
+
+        return;
+    }
+
+    auto composite = dynamic_cast<const reader::CompositeReader *>(&reader_);
+
+    if (!composite) {
+        throw std::runtime_error (
+            "Only composites can be laid out as columns, not " + reader_.type());
+    }
+
+    m_root = this->composite (reader_.type(), *composite);
+    m_type = reader_.type();
+    m_descriptor = descriptor_;
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::internal::columnar::
+Columns::rows() const {
+    return m_root ? m_root->length() : 0;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Columns::clear() {
+    if (m_root) {
+        m_root->clear();
+    }
+
+    m_open.clear();
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+Columns::schema (Flatbuffer & fb_) const {
+    if (!m_root) {
+        throw std::runtime_error ("No columns have been laid out");
+    }
+
+    std::vector<Flatbuffer::Offset> fields;
+    fields.reserve (m_root->columns().size());
+
+    for (const auto & column : m_root->columns()) {
+        fields.push_back (column->schema (fb_));
+    }
+
+    auto vector = fb_.vector (fields);
+
+    fb_.start();
+    fb_.add (0, int16_t { 0 });
+    fb_.offset (1, vector);
+
+    return fb_.end();
+}
+
+/******************************************************************************/
+
+/**
+ * The rows are the top level composite's fields, it has no column of
+ * its own
+ */
+void
+amqp::internal::columnar::
+Columns::batch (RecordBatch & batch_) const {
+    if (!m_root) {
+        throw std::runtime_error ("No columns have been laid out");
+    }
+
+    for (const auto & column : m_root->columns()) {
+        column->batch (batch_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Columns::dictionary (size_t id_, RecordBatch & batch_) const {
+    m_dictionaries.at (id_)->batch (batch_);
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::internal::columnar::
+Columns::dictionaryLength (size_t id_) const {
+    return m_dictionaries.at (id_)->length();
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::Column &
+amqp::internal::columnar::
+Columns::next() {
+    if (!m_open.empty()) {
+        return m_open.back()->next();
+    }
+
+    if (!m_root) {
+        throw std::runtime_error ("No columns have been laid out");
+    }
+
+    return *m_root;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Columns::startObject() {
+    auto & column = next();
+    column.startObject();
+    m_open.push_back (&column);
+}
+
+void
+amqp::internal::columnar::
+Columns::startList() {
+    auto & column = next();
+    column.startList();
+    m_open.push_back (&column);
+}
+
+void
+amqp::internal::columnar::
+Columns::startMap() {
+    auto & column = next();
+    column.startMap();
+    m_open.push_back (&column);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Columns::endObject() {
+    m_open.back()->end();
+    m_open.pop_back();
+}
+
+void
+amqp::internal::columnar::
+Columns::endList() {
+    endObject();
+}
+
+void
+amqp::internal::columnar::
+Columns::endMap() {
+    endObject();
+}
+
+/******************************************************************************/
+
+/**
+ * Outside of any composite this is the name the blob itself is given,
+ * which has no column
+ */
+void
+amqp::internal::columnar::
+Columns::field (std::string_view name_) {
+    if (!m_open.empty()) {
+        m_open.back()->field (name_);
+    }
+}
+
+/******************************************************************************/
+
+void amqp::internal::columnar::Columns::value (bool value_) { next().value (value_); }
+void amqp::internal::columnar::Columns::value (int32_t value_) { next().value (value_); }
+void amqp::internal::columnar::Columns::value (int64_t value_) { next().value (value_); }
+void amqp::internal::columnar::Columns::value (double value_) { next().value (value_); }
+void amqp::internal::columnar::Columns::value (float value_) { next().value (double { value_ }); }
+void amqp::internal::columnar::Columns::value (std::string_view value_) { next().value (value_); }
+void amqp::internal::columnar::Columns::binary (std::string_view value_) { next().binary (value_); }
+void amqp::internal::columnar::Columns::enumValue (std::string_view value_) { next().enumValue (value_); }
+
+/******************************************************************************/
+
+/**
+ * A run is always the elements of one list or array so all of it goes
+ * into the one column
+ */
+void amqp::internal::columnar::Columns::values (const bool * values_, size_t count_) { next().values (values_, count_); }
+void amqp::internal::columnar::Columns::values (const int32_t * values_, size_t count_) { next().values (values_, count_); }
+void amqp::internal::columnar::Columns::values (const int64_t * values_, size_t count_) { next().values (values_, count_); }
+void amqp::internal::columnar::Columns::values (const double * values_, size_t count_) { next().values (values_, count_); }
+
+/******************************************************************************/
+
+/**
+ * Float columns hold doubles, so widen the run a block at a time
+ */
+void
+amqp::internal::columnar::
+Columns::values (const float * values_, size_t count_) {
+    auto & column = next();
+    std::array<double, 64> run; // NOLINT
+
+    for (size_t i { 0 } ; i < count_ ; ) {
+        auto n = std::min (run.size(), count_ - i);
+        std::copy (values_ + i, values_ + i + n, run.begin());
+        column.values (run.data(), n);
+        i += n;
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,237 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <set>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "Flatbuffer.h"
+
+#include "amqp/reader/IVisitor.h"
+#include "reader/Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    class CompositeReader;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::columnar {
+
+    /**
+     * The body of a record batch, as Arrow lays it out, and the field
+     * nodes and buffer locations that describe it. Every buffer starts
+     * on an eight byte boundary.
+     */
+    class RecordBatch {
+        private :
+            std::string m_nodes;
+            std::string m_buffers;
+            std::string m_body;
+
+            size_t m_nodeCount;
+            size_t m_bufferCount;
+
+        public :
+            RecordBatch();
+
+            void node (int64_t length_, int64_t nulls_);
+            void buffer (std::string_view);
+
+            /**
+             * A column with no nulls needs no bitmap saying so
+             */
+            void validity() { buffer ({ }); }
+
+            Flatbuffer::Offset write (Flatbuffer &, int64_t length_) const;
+
+            const std::string & body() const { return m_body; }
+    };
+
+    /**
+     * The values of one field across every row, appended to as the blobs
+     * holding them are visited. Each column accepts the visitor calls a
+     * value of its type makes and throws on any other.
+     *
+     * None of the columns ever hold a null so none have a validity bitmap.
+     */
+    class Column {
+        protected :
+            std::string m_name;
+            int64_t m_length;
+
+            [[noreturn]] void mismatch (const char *) const;
+
+            /**
+             * The Field table describing us, everything it refers to
+             * already written
+             */
+            Flatbuffer::Offset describe (
+                Flatbuffer &,
+                uint8_t typeType_,
+                Flatbuffer::Offset type_,
+                const std::vector<Flatbuffer::Offset> & children_ = { },
+                Flatbuffer::Offset dictionary_ = 0) const;
+
+        public :
+            explicit Column (std::string);
+            virtual ~Column() = default;
+
+            const std::string & name() const { return m_name; }
+            int64_t length() const { return m_length; }
+
+            virtual void startObject();
+            virtual void startList();
+            virtual void startMap();
+            virtual void end();
+
+            virtual void field (std::string_view);
+
+            /**
+             * The column the next value within one of ours goes into
+             */
+            virtual Column & next();
+
+            virtual void value (bool);
+            virtual void value (int32_t);
+            virtual void value (int64_t);
+            virtual void value (double);
+            virtual void value (std::string_view);
+            virtual void binary (std::string_view);
+            virtual void enumValue (std::string_view);
+
+            /**
+             * Runs of elements, by default a value at a time
+             */
+            virtual void values (const bool *, size_t);
+            virtual void values (const int32_t *, size_t);
+            virtual void values (const int64_t *, size_t);
+            virtual void values (const double *, size_t);
+
+            virtual Flatbuffer::Offset schema (Flatbuffer &) const = 0;
+
+            /**
+             * Our field nodes and buffers followed by those of the
+             * columns within us, depth first as Arrow wants them
+             */
+            virtual void batch (RecordBatch &) const = 0;
+
+            virtual void clear() = 0;
+    };
+
+    class StructColumn;
+
+    /**
+     * Decodes blobs sharing a top level type into a column per field, the
+     * columns of a list, array or map being its offsets into a column of
+     * its elements, or keys and values, and an enum's the index of its
+     * constant within a dictionary of them all.
+     *
+     * Columns are laid out from the reader graph of the first blob's type
+     * and filled by visiting each blob's payload, so nothing but the
+     * values themselves is built per blob. A blob left half visited by an
+     * error leaves the columns inconsistent, they should be cleared or
+     * abandoned.
+     */
+    class Columns : public amqp::reader::IVisitor {
+        private :
+            std::string m_type;
+            std::string m_descriptor;
+
+            std::unique_ptr<StructColumn> m_root;
+
+            /**
+             * The constants of each enum, the index of one being its
+             * dictionary's id
+             */
+            std::vector<std::unique_ptr<Column>> m_dictionaries;
+
+            std::vector<Column *> m_open;
+
+            /**
+             * Composites we're part way through laying out, to catch a
+             * type that contains itself
+             */
+            std::set<std::string> m_pending;
+
+            std::unique_ptr<Column> make (const std::string &, const reader::IReader &);
+
+            std::unique_ptr<StructColumn> composite (
+                const std::string &,
+                const reader::CompositeReader &);
+
+            Column & next();
+
+        public :
+            Columns();
+            ~Columns() override;
+
+            Columns (const Columns &) = delete;
+            Columns & operator = (const Columns &) = delete;
+
+            /**
+             * Lay the columns out for [reader_] if this is the first blob,
+             * otherwise check it's of the type they were laid out for
+             */
+            void type (const reader::IReader & reader_, const std::string & descriptor_);
+
+            const std::string & type() const { return m_type; }
+
+            int64_t rows() const;
+
+            /**
+             * Empty every column, keeping the layout
+             */
+            void clear();
+
+            /**
+             * The Schema table
+             */
+            Flatbuffer::Offset schema (Flatbuffer &) const;
+
+            void batch (RecordBatch &) const;
+
+            size_t dictionaries() const { return m_dictionaries.size(); }
+            void dictionary (size_t id_, RecordBatch &) const;
+            int64_t dictionaryLength (size_t id_) const;
+
+            void startObject() override;
+            void endObject() override;
+
+            void field (std::string_view) override;
+
+            void startList() override;
+            void endList() override;
+
+            void startMap() override;
+            void endMap() override;
+
+            void value (bool) override;
+            void value (int32_t) override;
+            void value (int64_t) override;
+            void value (double) override;
+            void value (std::string_view) override;
+            void value (float) override;
+
+            void binary (std::string_view) override;
+
+            void values (const bool *, size_t) override;
+            void values (const int32_t *, size_t) override;
+            void values (const int64_t *, size_t) override;
+            void values (const double *, size_t) override;
+            void values (const float *, size_t) override;
+
+            void enumValue (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,291 @@
+#include "Flatbuffer.h"
+
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+littleEndian (std::string & out_, uint64_t value_, size_t size_) {
+    for (size_t i { 0 } ; i < size_ ; ++i) {
+        out_.push_back (static_cast<char>(value_ >> (8 * i)));
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::
+Flatbuffer::Flatbuffer()
+    : m_buffer (1024)
+    , m_head (m_buffer.size())
+    , m_align (1)
+    , m_table (0)
+    , m_building (false)
+{
+}
+
+/******************************************************************************/
+
+/**
+ * What's been written moves to the end of a bigger buffer, offsets being
+ * from the end they all still hold
+ */
+void
+amqp::internal::columnar::
+Flatbuffer::reserve (size_t size_) {
+    if (m_head >= size_) {
+        return;
+    }
+
+    const auto used = size();
+    std::vector<uint8_t> bigger (std::max (m_buffer.size() * 2, used + size_));
+
+    std::memcpy (bigger.data() + bigger.size() - used, m_buffer.data() + m_head, used);
+
+    m_buffer.swap (bigger);
+    m_head = m_buffer.size() - used;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::pad (size_t size_) {
+    reserve (size_);
+
+    for (size_t i { 0 } ; i < size_ ; ++i) {
+        m_buffer[--m_head] = 0;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::align (size_t size_, size_t align_) {
+    m_align = std::max (m_align, align_);
+
+    pad ((align_ - ((size() + size_) % align_)) % align_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::put (uint64_t value_, size_t size_) {
+    reserve (size_);
+    m_head -= size_;
+
+    for (size_t i { 0 } ; i < size_ ; ++i) {
+        m_buffer[m_head + i] = static_cast<uint8_t>(value_ >> (8 * i));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::put (std::string_view bytes_) {
+    reserve (bytes_.size());
+    m_head -= bytes_.size();
+
+    std::memcpy (m_buffer.data() + m_head, bytes_.data(), bytes_.size());
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+Flatbuffer::refer (Offset to_) const {
+    return size() + sizeof (Offset) - to_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::field (uint16_t id_) {
+    if (!m_building) {
+        throw std::runtime_error ("Adding a field outside of a table");
+    }
+
+    m_fields.emplace_back (id_, size());
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+Flatbuffer::string (std::string_view str_) {
+    align (str_.size() + 1, sizeof (Offset));
+
+    pad (1);
+    put (str_);
+    put (str_.size(), sizeof (Offset));
+
+    return size();
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+Flatbuffer::vector (std::string_view elements_, size_t count_, size_t align_) {
+    align (elements_.size(), std::max (align_, sizeof (Offset)));
+
+    put (elements_);
+    put (count_, sizeof (Offset));
+
+    return size();
+}
+
+/******************************************************************************/
+
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+Flatbuffer::vector (const std::vector<Offset> & elements_) {
+    align (elements_.size() * sizeof (Offset), sizeof (Offset));
+
+    for (auto it = elements_.rbegin() ; it != elements_.rend() ; ++it) {
+        put (refer (*it), sizeof (Offset));
+    }
+
+    put (elements_.size(), sizeof (Offset));
+
+    return size();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::start() {
+    if (m_building) {
+        throw std::runtime_error ("Tables can't be nested, finish the inner one first");
+    }
+
+    m_building = true;
+    m_fields.clear();
+    m_table = size();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::add (uint16_t id_, bool value_) {
+    add (id_, static_cast<uint8_t>(value_));
+}
+
+void
+amqp::internal::columnar::
+Flatbuffer::add (uint16_t id_, uint8_t value_) {
+    put (value_, sizeof (value_));
+    field (id_);
+}
+
+void
+amqp::internal::columnar::
+Flatbuffer::add (uint16_t id_, int16_t value_) {
+    align (sizeof (value_), sizeof (value_));
+    put (static_cast<uint16_t>(value_), sizeof (value_));
+    field (id_);
+}
+
+void
+amqp::internal::columnar::
+Flatbuffer::add (uint16_t id_, int32_t value_) {
+    align (sizeof (value_), sizeof (value_));
+    put (static_cast<uint32_t>(value_), sizeof (value_));
+    field (id_);
+}
+
+void
+amqp::internal::columnar::
+Flatbuffer::add (uint16_t id_, int64_t value_) {
+    align (sizeof (value_), sizeof (value_));
+    put (static_cast<uint64_t>(value_), sizeof (value_));
+    field (id_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::columnar::
+Flatbuffer::offset (uint16_t id_, Offset to_) {
+    align (sizeof (Offset), sizeof (Offset));
+    put (refer (to_), sizeof (Offset));
+    field (id_);
+}
+
+/******************************************************************************/
+
+/**
+ * The table starts with the offset back to its vtable, which we write
+ * immediately before it. The vtable is its own size, the table's, then
+ * where each field sits within the table by id, zero for those absent.
+ */
+amqp::internal::columnar::Flatbuffer::Offset
+amqp::internal::columnar::
+Flatbuffer::end() {
+    if (!m_building) {
+        throw std::runtime_error ("Ending a table that was never started");
+    }
+
+    align (sizeof (int32_t), sizeof (int32_t));
+    put (0, sizeof (int32_t));
+
+    const auto table = size();
+
+    size_t fields { 0 };
+    for (const auto & field : m_fields) {
+        fields = std::max (fields, static_cast<size_t>(field.first) + 1);
+    }
+
+    std::vector<uint16_t> offsets (fields, 0);
+    for (const auto & field : m_fields) {
+        offsets[field.first] = static_cast<uint16_t>(table - field.second);
+    }
+
+    for (auto it = offsets.rbegin() ; it != offsets.rend() ; ++it) {
+        put (*it, sizeof (uint16_t));
+    }
+
+    put (table - m_table, sizeof (uint16_t));
+    put ((fields + 2) * sizeof (uint16_t), sizeof (uint16_t));
+
+    const auto vtable = size();
+    const auto at = m_buffer.size() - table;
+
+    for (size_t i { 0 } ; i < sizeof (int32_t) ; ++i) {
+        m_buffer[at + i] = static_cast<uint8_t>((vtable - table) >> (8 * i));
+    }
+
+    m_building = false;
+
+    return table;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::columnar::
+Flatbuffer::finish (Offset root_) {
+    if (m_building) {
+        throw std::runtime_error ("Finishing part way through a table");
+    }
+
+    align (sizeof (Offset), std::max (m_align, sizeof (Offset)));
+    put (refer (root_), sizeof (Offset));
+
+    std::string rtn (m_buffer.begin() + m_head, m_buffer.end());
+
+    m_head = m_buffer.size();
+    m_align = 1;
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,121 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::columnar {
+
+    /**
+     * Just enough of a FlatBuffers builder to write Arrow's metadata, which
+     * is all tables, vectors, strings and a couple of structs.
+     *
+     * As with the real thing the buffer is built back to front, so
+     * everything a table refers to has to be finished before the table is
+     * started, and an offset is the distance of a thing from the end of
+     * the buffer. Nothing is shared or deduplicated, the messages we write
+     * are a few hundred bytes.
+     *
+     * Everything is written little endian whatever the host.
+     */
+    class Flatbuffer {
+        public :
+            using Offset = uint32_t;
+
+        private :
+            /**
+             * Grows downwards, what's been written runs from m_head to
+             * the end
+             */
+            std::vector<uint8_t> m_buffer;
+            size_t m_head;
+
+            /**
+             * The widest alignment asked for, the finished buffer is
+             * padded to a multiple of it
+             */
+            size_t m_align;
+
+            /**
+             * Fields of the table being built by id with where they
+             * were written
+             */
+            std::vector<std::pair<uint16_t, Offset>> m_fields;
+            Offset m_table;
+            bool m_building;
+
+            Offset size() const {
+                return static_cast<Offset>(m_buffer.size() - m_head);
+            }
+
+            void reserve (size_t);
+            void pad (size_t);
+
+            /**
+             * Pad so that once [size_] more bytes are written we're on
+             * a multiple of [align_]
+             */
+            void align (size_t size_, size_t align_);
+
+            void put (uint64_t, size_t);
+            void put (std::string_view);
+
+            /**
+             * The value of an offset about to be written that refers
+             * to [to_]
+             */
+            Offset refer (Offset to_) const;
+
+            void field (uint16_t);
+
+        public :
+            Flatbuffer();
+
+            Offset string (std::string_view);
+
+            /**
+             * Of structs or scalars, [elements_] is their little endian
+             * bytes laid end to end
+             */
+            Offset vector (std::string_view elements_, size_t count_, size_t align_);
+
+            /**
+             * Of tables or strings
+             */
+            Offset vector (const std::vector<Offset> &);
+
+            void start();
+
+            void add (uint16_t id_, bool);
+            void add (uint16_t id_, uint8_t);
+            void add (uint16_t id_, int16_t);
+            void add (uint16_t id_, int32_t);
+            void add (uint16_t id_, int64_t);
+
+            /**
+             * A table, string or vector
+             */
+            void offset (uint16_t id_, Offset);
+
+            Offset end();
+
+            /**
+             * Write the root and take the buffer, which leaves us empty
+             * and ready to build another
+             */
+            std::string finish (Offset root_);
+    };
+
+    /**
+     * Append [value_] to [out_] as [size_] little endian bytes
+     */
+    void littleEndian (std::string & out_, uint64_t value_, size_t size_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,498 @@
+#include "Cursor.h"
+
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************
+ *
+ * Runs of primitive elements read straight into a buffer. An element is
+ * taken if its format code encodes the type the run was asked for and
+ * the value fits the buffer, anything else ends the run.
+ *
+ ******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::decoder;
+
+    uint16_t
+    be16 (const uint8_t * bytes_) {
+        return static_cast<uint16_t>((bytes_[0] << 8) | bytes_[1]);
+    }
+
+    uint32_t
+    be32 (const uint8_t * bytes_) {
+        return (uint32_t { bytes_[0] } << 24)
+             | (uint32_t { bytes_[1] } << 16)
+             | (uint32_t { bytes_[2] } << 8)
+             | uint32_t { bytes_[3] };
+    }
+
+    uint64_t
+    be64 (const uint8_t * bytes_) {
+        return (uint64_t { be32 (bytes_) } << 32) | be32 (bytes_ + 4);
+    }
+
+    /**
+     * The width of the value of an element encoded as [code_] if a run
+     * of [type_] into a buffer of T can take it, -1 if it can't
+     */
+    template<class T>
+    int
+    width (Type type_, uint8_t code_) {
+        if (typeOf (code_) != type_) {
+            return -1;
+        }
+
+        if constexpr (std::is_same_v<T, int32_t>) {
+            switch (code_) {
+                case 0x51 :
+                case 0x54 : return 1;
+                case 0x61 : return 2;
+                case 0x71 : return 4;
+                default : return -1;
+            }
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            switch (code_) {
+                case 0x55 : return 1;
+                case 0x81 :
+                case 0x83 : return 8;
+                default : return -1;
+            }
+        } else if constexpr (std::is_same_v<T, double>) {
+            switch (code_) {
+                case 0x72 : return 4;
+                case 0x82 : return 8;
+                default : return -1;
+            }
+        } else if constexpr (std::is_same_v<T, float>) {
+            return code_ == 0x72 ? 4 : -1;
+        } else {
+            switch (code_) {
+                case 0x41 :
+                case 0x42 : return 0;
+                case 0x56 : return 1;
+                default : return -1;
+            }
+        }
+    }
+
+    /**
+     * The value of an element encoded as [code_], which [width] must
+     * already have accepted
+     */
+    template<class T>
+    T
+    read (uint8_t code_, const uint8_t * value_) {
+        switch (code_) {
+            case 0x41 : return static_cast<T>(true);
+            case 0x42 : return static_cast<T>(false);
+            case 0x56 : return static_cast<T>(*value_ != 0);
+            case 0x51 :
+            case 0x54 :
+            case 0x55 : return static_cast<T>(static_cast<int8_t>(*value_));
+            case 0x61 : return static_cast<T>(static_cast<int16_t>(be16 (value_)));
+            case 0x71 : return static_cast<T>(static_cast<int32_t>(be32 (value_)));
+            case 0x81 :
+            case 0x83 : return static_cast<T>(static_cast<int64_t>(be64 (value_)));
+            case 0x72 : {
+                auto bits = be32 (value_);
+                float rtn;
+                std::memcpy (&rtn, &bits, sizeof (rtn));
+                return static_cast<T>(rtn);
+            }
+            default : {
+                auto bits = be64 (value_);
+                double rtn;
+                std::memcpy (&rtn, &bits, sizeof (rtn));
+                return static_cast<T>(rtn);
+            }
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * SSE2 kernels, x86 being little endian every big endian value needs
+ * its bytes reversing, and the narrower ones sign extending
+ *
+ ******************************************************************************/
+
+#if defined (__SSE2__)
+
+namespace {
+
+    __m128i
+    load (const uint8_t * bytes_) {
+        return _mm_loadu_si128 (reinterpret_cast<const __m128i *>(bytes_));
+    }
+
+    template<class T>
+    void
+    store (T * out_, __m128i value_) {
+        _mm_storeu_si128 (reinterpret_cast<__m128i *>(out_), value_);
+    }
+
+    __m128i
+    swap16 (__m128i value_) {
+        return _mm_or_si128 (_mm_slli_epi16 (value_, 8), _mm_srli_epi16 (value_, 8));
+    }
+
+    __m128i
+    swap32 (__m128i value_) {
+        value_ = swap16 (value_);
+        return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (value_, 0xb1), 0xb1);
+    }
+
+    __m128i
+    swap64 (__m128i value_) {
+        value_ = swap16 (value_);
+        return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (value_, 0x1b), 0x1b);
+    }
+
+    /**
+     * The bytes of [value_] sign extended to 16 bits, the low eight or
+     * the high eight
+     */
+    __m128i
+    low8 (__m128i value_) {
+        return _mm_srai_epi16 (_mm_unpacklo_epi8 (value_, value_), 8);
+    }
+
+    __m128i
+    high8 (__m128i value_) {
+        return _mm_srai_epi16 (_mm_unpackhi_epi8 (value_, value_), 8);
+    }
+
+    /**
+     * Eight int16s sign extended into the buffer
+     */
+    void
+    widen (__m128i value_, int32_t * out_) {
+        store (out_, _mm_srai_epi32 (_mm_unpacklo_epi16 (value_, value_), 16));
+        store (out_ + 4, _mm_srai_epi32 (_mm_unpackhi_epi16 (value_, value_), 16));
+    }
+
+    void
+    widen (__m128i value_, int64_t * out_) {
+        auto low = _mm_srai_epi32 (_mm_unpacklo_epi16 (value_, value_), 16);
+        auto high = _mm_srai_epi32 (_mm_unpackhi_epi16 (value_, value_), 16);
+        auto lowSign = _mm_srai_epi32 (low, 31);
+        auto highSign = _mm_srai_epi32 (high, 31);
+
+        store (out_, _mm_unpacklo_epi32 (low, lowSign));
+        store (out_ + 2, _mm_unpackhi_epi32 (low, lowSign));
+        store (out_ + 4, _mm_unpacklo_epi32 (high, highSign));
+        store (out_ + 6, _mm_unpackhi_epi32 (high, highSign));
+    }
+
+}
+
+#endif
+
+/******************************************************************************
+ *
+ * Lists, each element with its own format code. Only runs of the single
+ * byte encodings are regular enough to take a block at a time, checking
+ * the codes and widening the values between them at once. Each returns
+ * how many elements it read, always a whole number of blocks.
+ *
+ ******************************************************************************/
+
+namespace {
+
+#if defined (__SSE2__)
+
+    template<class T>
+    size_t
+    blocks (uint8_t code_, const uint8_t * in_, const uint8_t * end_, size_t max_, T * out_) {
+        size_t n { 0 };
+
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+            if (code_ != 0x51 && code_ != 0x54 && code_ != 0x55) {
+                return 0;
+            }
+
+            // a code and its value in each 16 bit lane, the value high
+            const auto codes = _mm_set1_epi8 (static_cast<char>(code_));
+
+            for ( ; max_ - n >= 8 && end_ - in_ >= 16 ; n += 8, in_ += 16) {
+                auto bytes = load (in_);
+
+                if ((_mm_movemask_epi8 (_mm_cmpeq_epi8 (bytes, codes)) & 0x5555) != 0x5555) {
+                    break;
+                }
+
+                widen (_mm_srai_epi16 (bytes, 8), out_ + n);
+            }
+        } else if constexpr (std::is_same_v<T, bool>) {
+            if (code_ != 0x41 && code_ != 0x42) {
+                return 0;
+            }
+
+            // true and false are a code and nothing else
+            const auto trues = _mm_set1_epi8 (0x41);
+            const auto falses = _mm_set1_epi8 (0x42);
+            const auto ones = _mm_set1_epi8 (1);
+
+            for ( ; max_ - n >= 16 && end_ - in_ >= 16 ; n += 16, in_ += 16) {
+                auto bytes = load (in_);
+                auto t = _mm_cmpeq_epi8 (bytes, trues);
+
+                if (_mm_movemask_epi8 (_mm_or_si128 (t, _mm_cmpeq_epi8 (bytes, falses))) != 0xffff) {
+                    break;
+                }
+
+                store (out_ + n, _mm_and_si128 (t, ones));
+            }
+        }
+
+        return n;
+    }
+
+#else
+
+    template<class T>
+    size_t
+    blocks (uint8_t, const uint8_t *, const uint8_t *, size_t, T *) {
+        return 0;
+    }
+
+#endif
+
+}
+
+/******************************************************************************
+ *
+ * Arrays, every element sharing one code so the values are packed end
+ * to end
+ *
+ ******************************************************************************/
+
+namespace {
+
+    template<class T>
+    void
+    packed (uint8_t code_, const uint8_t * in_, size_t count_, int width_, T * out_) {
+        size_t i { 0 };
+
+#if defined (__SSE2__)
+        if constexpr (std::is_same_v<T, int32_t>) {
+            switch (code_) {
+                case 0x51 :
+                case 0x54 :
+                    for ( ; i + 16 <= count_ ; i += 16) {
+                        auto bytes = load (in_ + i);
+                        widen (low8 (bytes), out_ + i);
+                        widen (high8 (bytes), out_ + i + 8);
+                    }
+                    break;
+                case 0x61 :
+                    for ( ; i + 8 <= count_ ; i += 8) {
+                        widen (swap16 (load (in_ + 2 * i)), out_ + i);
+                    }
+                    break;
+                case 0x71 :
+                    for ( ; i + 4 <= count_ ; i += 4) {
+                        store (out_ + i, swap32 (load (in_ + 4 * i)));
+                    }
+                    break;
+                default :
+                    break;
+            }
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            switch (code_) {
+                case 0x55 :
+                    for ( ; i + 16 <= count_ ; i += 16) {
+                        auto bytes = load (in_ + i);
+                        widen (low8 (bytes), out_ + i);
+                        widen (high8 (bytes), out_ + i + 8);
+                    }
+                    break;
+                case 0x81 :
+                case 0x83 :
+                    for ( ; i + 2 <= count_ ; i += 2) {
+                        store (out_ + i, swap64 (load (in_ + 8 * i)));
+                    }
+                    break;
+                default :
+                    break;
+            }
+        } else if constexpr (std::is_same_v<T, double>) {
+            switch (code_) {
+                case 0x72 :
+                    for ( ; i + 4 <= count_ ; i += 4) {
+                        auto floats = _mm_castsi128_ps (swap32 (load (in_ + 4 * i)));
+                        _mm_storeu_pd (out_ + i, _mm_cvtps_pd (floats));
+                        _mm_storeu_pd (out_ + i + 2, _mm_cvtps_pd (_mm_movehl_ps (floats, floats)));
+                    }
+                    break;
+                case 0x82 :
+                    for ( ; i + 2 <= count_ ; i += 2) {
+                        _mm_storeu_pd (out_ + i, _mm_castsi128_pd (swap64 (load (in_ + 8 * i))));
+                    }
+                    break;
+                default :
+                    break;
+            }
+        } else if constexpr (std::is_same_v<T, float>) {
+            for ( ; i + 4 <= count_ ; i += 4) {
+                _mm_storeu_ps (out_ + i, _mm_castsi128_ps (swap32 (load (in_ + 4 * i))));
+            }
+        } else {
+            if (code_ == 0x56) {
+                const auto zeros = _mm_setzero_si128();
+                const auto ones = _mm_set1_epi8 (1);
+
+                for ( ; i + 16 <= count_ ; i += 16) {
+                    store (out_ + i, _mm_andnot_si128 (
+                            _mm_cmpeq_epi8 (load (in_ + i), zeros), ones));
+                }
+            }
+        }
+#endif
+
+        for ( ; i < count_ ; ++i) {
+            out_[i] = read<T> (code_, in_ + i * width_);
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::Cursor
+ *
+ ******************************************************************************/
+
+template<class T>
+size_t
+amqp::internal::decoder::
+Cursor::run (Type type_, T * out_, size_t max_) {
+    if (!m_valid || !m_frames.back().m_hasParent) {
+        return 0;
+    }
+
+    auto & frame = m_frames.back();
+    auto parent = typeOf (frame.m_parent.m_code);
+
+    if ((parent != Type::list_t && parent != Type::array_t)
+        || (frame.m_describedArray && frame.m_index == 0))
+    {
+        return 0;
+    }
+
+    max_ = std::min (max_, frame.m_count - frame.m_index);
+
+    size_t count { 0 };
+    Node last { };
+
+    if (frame.m_array) {
+        const auto code = frame.m_elementCode;
+        const auto width = ::width<T> (type_, code);
+
+        if (width < 0) {
+            return 0;
+        }
+
+        if (width > 0) {
+            max_ = std::min (max_, (frame.m_end - m_node.m_start) / width);
+        }
+
+        if (max_ == 0) {
+            return 0;
+        }
+
+        packed (code, m_bytes + m_node.m_start, max_, width, out_);
+
+        count = max_;
+
+        auto start = m_node.m_start + (count - 1) * width;
+        last = { start, start, start + width, code };
+    } else {
+        auto offset = m_node.m_start;
+
+        while (count < max_ && offset < frame.m_end) {
+            const auto code = m_bytes[offset];
+            const auto width = ::width<T> (type_, code);
+
+            if (width < 0 || offset + 1 + width > frame.m_end) {
+                break;
+            }
+
+            const size_t stride = 1 + width;
+
+            auto n = blocks (code, m_bytes + offset, m_bytes + frame.m_end,
+                    max_ - count, out_ + count);
+
+            if (n == 0) {
+                out_[count] = read<T> (code, m_bytes + offset + 1);
+                n = 1;
+            }
+
+            count += n;
+            offset += n * stride;
+            last = { offset - stride, offset - width, offset, code };
+        }
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    // onto the last element read, as though we'd stepped through each
+    // of them, and then past it as reading it would have
+    frame.m_index += count - 1;
+    m_node = last;
+    next();
+
+    return count;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::readRun (Type type_, bool * out_, size_t max_) {
+    return run (type_, out_, max_);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::readRun (Type type_, int32_t * out_, size_t max_) {
+    return run (type_, out_, max_);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::readRun (Type type_, int64_t * out_, size_t max_) {
+    return run (type_, out_, max_);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::readRun (Type type_, double * out_, size_t max_) {
+    return run (type_, out_, max_);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::readRun (Type type_, float * out_, size_t max_) {
+    return run (type_, out_, max_);
+}
+
+/******************************************************************************/
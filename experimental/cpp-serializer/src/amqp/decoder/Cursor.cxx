@@ -0,0 +1,1171 @@
+#include "Cursor.h"
+
+#include <limits>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <exception>
+#include <stdexcept>
+
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::decoder;
+
+    std::string
+    hex (uint8_t code_) {
+        std::stringstream ss;
+        ss << "0x" << std::hex << std::setw (2) << std::setfill ('0')
+           << static_cast<unsigned>(code_);
+        return ss.str();
+    }
+
+    /**
+     * The high nibble of a format code gives the width of what follows it,
+     * either directly or as the width of a size prefix
+     */
+    enum class Category : uint8_t {
+        fixed_t,
+        variable_t,
+        compound_t,
+        array_t
+    };
+
+    Category
+    category (uint8_t code_) {
+        switch (code_ >> 4) {
+            case 0xa : case 0xb : return Category::variable_t;
+            case 0xc : case 0xd : return Category::compound_t;
+            case 0xe : case 0xf : return Category::array_t;
+            default : return Category::fixed_t;
+        }
+    }
+
+    /**
+     * Whether a variable, compound or array type uses a one or four byte
+     * size prefix
+     */
+    size_t
+    prefix (uint8_t code_) {
+        return ((code_ >> 4) & 0x1) ? 4 : 1;
+    }
+
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::typeName (Type type_) {
+    switch (type_) {
+        case Type::null_t : return "null";
+        case Type::bool_t : return "bool";
+        case Type::ubyte_t : return "ubyte";
+        case Type::byte_t : return "byte";
+        case Type::ushort_t : return "ushort";
+        case Type::short_t : return "short";
+        case Type::uint_t : return "uint";
+        case Type::int_t : return "int";
+        case Type::char_t : return "char";
+        case Type::ulong_t : return "ulong";
+        case Type::long_t : return "long";
+        case Type::timestamp_t : return "timestamp";
+        case Type::float_t : return "float";
+        case Type::double_t : return "double";
+        case Type::decimal32_t : return "decimal32";
+        case Type::decimal64_t : return "decimal64";
+        case Type::decimal128_t : return "decimal128";
+        case Type::uuid_t : return "uuid";
+        case Type::binary_t : return "binary";
+        case Type::string_t : return "string";
+        case Type::symbol_t : return "symbol";
+        case Type::described_t : return "described";
+        case Type::array_t : return "array";
+        case Type::list_t : return "list";
+        case Type::map_t : return "map";
+        default : return "invalid";
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Type
+amqp::internal::decoder::typeOf (uint8_t code_) {
+    switch (code_) {
+        case 0x00 : return Type::described_t;
+        case 0x40 : return Type::null_t;
+        case 0x41 :
+        case 0x42 :
+        case 0x56 : return Type::bool_t;
+        case 0x50 : return Type::ubyte_t;
+        case 0x51 : return Type::byte_t;
+        case 0x60 : return Type::ushort_t;
+        case 0x61 : return Type::short_t;
+        case 0x43 :
+        case 0x52 :
+        case 0x70 : return Type::uint_t;
+        case 0x54 :
+        case 0x71 : return Type::int_t;
+        case 0x73 : return Type::char_t;
+        case 0x44 :
+        case 0x53 :
+        case 0x80 : return Type::ulong_t;
+        case 0x55 :
+        case 0x81 : return Type::long_t;
+        case 0x83 : return Type::timestamp_t;
+        case 0x72 : return Type::float_t;
+        case 0x82 : return Type::double_t;
+        case 0x74 : return Type::decimal32_t;
+        case 0x84 : return Type::decimal64_t;
+        case 0x94 : return Type::decimal128_t;
+        case 0x98 : return Type::uuid_t;
+        case 0xa0 :
+        case 0xb0 : return Type::binary_t;
+        case 0xa1 :
+        case 0xb1 : return Type::string_t;
+        case 0xa3 :
+        case 0xb3 : return Type::symbol_t;
+        case 0x45 :
+        case 0xc0 :
+        case 0xd0 : return Type::list_t;
+        case 0xc1 :
+        case 0xd1 : return Type::map_t;
+        case 0xe0 :
+        case 0xf0 : return Type::array_t;
+        default : return Type::invalid_t;
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::Cursor
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+Cursor::Cursor (const char * bytes_, size_t size_)
+    : m_bytes (reinterpret_cast<const uint8_t *>(bytes_))
+    , m_size (size_)
+    , m_node { }
+    , m_valid (false)
+    , m_origin (nullptr)
+    , m_complete (true)
+{
+    // the outermost frame is the sequence of top level values, it has
+    // no parent and runs until the bytes do
+    m_frames.reserve (32);
+    m_frames.push_back ({ { }, false, 0, 0, m_size,
+                          std::numeric_limits<size_t>::max(), 0, 0, false, false });
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+Cursor::Cursor (std::string_view bytes_)
+    : Cursor (bytes_.data(), bytes_.size())
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+Cursor::Cursor (std::string_view bytes_, const Cursor & origin_)
+    : Cursor (bytes_.data(), bytes_.size())
+{
+    m_origin = origin_.m_origin ? origin_.m_origin : &origin_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Cursor::require (size_t offset_, size_t bytes_) const {
+    if (offset_ > m_size || bytes_ > m_size - offset_) {
+        throw std::runtime_error ("Truncated AMQP value");
+    }
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::internal::decoder::
+Cursor::u8 (size_t offset_) const {
+    require (offset_, 1);
+    return m_bytes[offset_];
+}
+
+/******************************************************************************/
+
+uint16_t
+amqp::internal::decoder::
+Cursor::u16 (size_t offset_) const {
+    require (offset_, 2);
+    return static_cast<uint16_t>((m_bytes[offset_] << 8) | m_bytes[offset_ + 1]);
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Cursor::u32 (size_t offset_) const {
+    require (offset_, 4);
+    return (uint32_t { m_bytes[offset_] } << 24)
+         | (uint32_t { m_bytes[offset_ + 1] } << 16)
+         | (uint32_t { m_bytes[offset_ + 2] } << 8)
+         | uint32_t { m_bytes[offset_ + 3] };
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::decoder::
+Cursor::u64 (size_t offset_) const {
+    return (uint64_t { u32 (offset_) } << 32) | u32 (offset_ + 4);
+}
+
+/******************************************************************************/
+
+/**
+ * The number of bytes following the constructor of a value of type
+ * [code_] whose encoding starts at [payload_]
+ */
+size_t
+amqp::internal::decoder::
+Cursor::width (uint8_t code_, size_t payload_) const {
+    switch (category (code_)) {
+        case Category::variable_t :
+        case Category::compound_t :
+        case Category::array_t :
+            return prefix (code_) == 1
+                ? 1 + size_t { u8 (payload_) }
+                : 4 + size_t { u32 (payload_) };
+        default :
+            break;
+    }
+
+    if (typeOf (code_) == Type::invalid_t) {
+        throw std::runtime_error ("Unknown AMQP format code " + hex (code_));
+    }
+
+    switch (code_ >> 4) {
+        case 0x4 : return 0;
+        case 0x5 : return 1;
+        case 0x6 : return 2;
+        case 0x7 : return 4;
+        case 0x8 : return 8;
+        default : return 16;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Returns the offset just past the constructor encoded value starting at
+ * [offset_]. Described values are the only ones whose extent can't be
+ * read from a prefix, each leaves a descriptor and then a value to step
+ * over. They're counted rather than recursed into so however many a
+ * blob nests it's a truncation, not the stack, that stops a bad one.
+ */
+size_t
+amqp::internal::decoder::
+Cursor::skip (size_t offset_) const {
+    size_t pending { 1 };
+
+    while (pending > 0) {
+        auto code = u8 (offset_);
+
+        if (code == 0x00) {
+            ++offset_;
+            ++pending;
+            continue;
+        }
+
+        auto end = offset_ + 1 + width (code, offset_ + 1);
+        require (offset_, end - offset_);
+
+        offset_ = end;
+        --pending;
+    }
+
+    return offset_;
+}
+
+/******************************************************************************/
+
+/**
+ * Array elements share the array's constructor, for those [code_] is
+ * the element type and [offset_] points straight at the value. Otherwise
+ * [code_] is ignored and read from the buffer.
+ */
+amqp::internal::decoder::Cursor::Node
+amqp::internal::decoder::
+Cursor::parse (size_t offset_, uint8_t code_) const {
+    Node node { offset_, offset_, offset_, code_ };
+
+    if (!m_frames.back().m_array
+        || (m_frames.back().m_describedArray && m_frames.back().m_index == 0))
+    {
+        node.m_code = u8 (offset_);
+        node.m_payload = offset_ + 1;
+    }
+
+    node.m_end = node.m_code == 0x00
+        ? skip (node.m_start)
+        : node.m_payload + width (node.m_code, node.m_payload);
+
+    require (node.m_start, node.m_end - node.m_start);
+
+    return node;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Cursor::Frame
+amqp::internal::decoder::
+Cursor::frame (const Node & node_) const {
+    Frame frame { node_, true, 0, 0, node_.m_end, 0, 0, 0, false, false };
+
+    if (node_.m_code == 0x00) {
+        // a descriptor followed by the described value
+        frame.m_first = node_.m_payload;
+        frame.m_count = 2;
+
+        return frame;
+    }
+
+    if (node_.m_code == 0x45) {
+        frame.m_first = node_.m_end;
+        return frame;
+    }
+
+    const size_t width = prefix (node_.m_code);
+
+    frame.m_first = node_.m_payload + 2 * width;
+    frame.m_count = width == 1
+        ? u8 (node_.m_payload + 1)
+        : u32 (node_.m_payload + 4);
+
+    if (frame.m_first > node_.m_end) {
+        throw std::runtime_error ("Malformed AMQP " + std::string (
+                typeName (typeOf (node_.m_code))));
+    }
+
+    if (category (node_.m_code) == Category::array_t) {
+        frame.m_array = true;
+
+        if (u8 (frame.m_first) == 0x00) {
+            // the descriptor is the first child, the elements follow
+            // the element constructor that comes after it
+            auto descriptorEnd = skip (frame.m_first + 1);
+
+            frame.m_describedArray = true;
+            frame.m_first += 1;
+            frame.m_elementCode = u8 (descriptorEnd);
+            frame.m_elements = descriptorEnd + 1;
+            frame.m_count += 1;
+        } else {
+            frame.m_elementCode = u8 (frame.m_first);
+            frame.m_elements = frame.m_first + 1;
+            frame.m_first = frame.m_elements;
+        }
+    }
+
+    return frame;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Cursor::next() {
+    auto & frame = m_frames.back();
+
+    size_t offset;
+    size_t index;
+
+    if (!m_valid) {
+        offset = frame.m_first;
+        index = 0;
+    } else {
+        offset = (frame.m_describedArray && frame.m_index == 0)
+            ? frame.m_elements
+            : m_node.m_end;
+        index = frame.m_index + 1;
+    }
+
+    if (index >= frame.m_count || offset >= frame.m_end) {
+        return false;
+    }
+
+    frame.m_index = index;
+
+    auto node = parse (offset, frame.m_elementCode);
+
+    if (node.m_end > frame.m_end) {
+        throw std::runtime_error ("AMQP value overruns its container");
+    }
+
+    m_node = node;
+    m_valid = true;
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Cursor::enter() {
+    switch (type()) {
+        case Type::described_t :
+        case Type::list_t :
+        case Type::map_t :
+        case Type::array_t :
+            break;
+        default :
+            return false;
+    }
+
+    m_frames.push_back (frame (m_node));
+    m_valid = false;
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Cursor::exit() {
+    if (!m_frames.back().m_hasParent) {
+        return false;
+    }
+
+    m_node = m_frames.back().m_parent;
+    m_valid = true;
+    m_frames.pop_back();
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Cursor::rewind() {
+    m_frames.resize (1);
+    m_frames.back().m_index = 0;
+    m_valid = false;
+
+    m_objects.clear();
+    m_complete = true;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Type
+amqp::internal::decoder::
+Cursor::type() const {
+    return m_valid ? typeOf (m_node.m_code) : Type::invalid_t;
+}
+
+/******************************************************************************/
+
+/**
+ * Elements of an array have no constructor of their own, their raw form
+ * is just the value
+ */
+std::string_view
+amqp::internal::decoder::
+Cursor::raw() const {
+    if (!m_valid) return { };
+
+    return { reinterpret_cast<const char *>(m_bytes) + m_node.m_start,
+             m_node.m_end - m_node.m_start };
+}
+
+/******************************************************************************/
+
+/**
+ * Described by the REFERENCED_OBJECT ulong, which being that large is
+ * always written at full width, so rather than stepping in and decoding
+ * the descriptor we can just compare its bytes
+ */
+bool
+amqp::internal::decoder::
+Cursor::isReference() const {
+    if (!m_valid || m_node.m_code != 0x00 || m_node.m_end - m_node.m_payload < 10) {
+        return false;
+    }
+
+    return u8 (m_node.m_payload) == 0x80
+        && u64 (m_node.m_payload + 1) == (schema::descriptors::DESCRIPTOR_TOP_32BITS
+            | static_cast<uint64_t>(schema::descriptors::REFERENCED_OBJECT));
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Cursor::referenced() const {
+    return (m_origin ? *m_origin : *this).m_objects[reference()];
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::reference() const {
+    if (!isReference()) {
+        throw std::runtime_error ("Expected a referenced object");
+    }
+
+    // the index, a uint, follows the descriptor
+    const auto offset = m_node.m_payload + 9;
+
+    size_t index;
+    switch (u8 (offset)) {
+        case 0x43 : index = 0; break;
+        case 0x52 : index = u8 (offset + 1); break;
+        case 0x70 : index = u32 (offset + 1); break;
+        default :
+            throw std::runtime_error ("Malformed referenced object index");
+    }
+
+    const auto & owner = m_origin ? *m_origin : *this;
+
+    if (!owner.m_complete) {
+        throw std::runtime_error (
+                "Cannot resolve a referenced object after skipping values");
+    }
+
+    if (index >= owner.m_objects.size()) {
+        throw std::runtime_error (
+                "Referenced object " + std::to_string (index) + " not yet read");
+    }
+
+    return index;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Cursor::remember (std::string_view raw_) {
+    if (!m_origin) {
+        m_objects.push_back (raw_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Cursor::forget() {
+    if (!m_origin) {
+        m_complete = false;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::objects() const {
+    return (m_origin ? *m_origin : *this).m_objects.size();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::listCount() const {
+    return type() == Type::list_t ? frame (m_node).m_count : 0;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::mapCount() const {
+    return type() == Type::map_t ? frame (m_node).m_count : 0;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::elementCount() const {
+    switch (type()) {
+        case Type::list_t :
+            return frame (m_node).m_count;
+        case Type::array_t :
+            if (isArrayDescribed()) {
+                throw std::runtime_error ("Cannot read a described array as a list");
+            }
+            return arrayCount();
+        default :
+            return 0;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Cursor::arrayCount() const {
+    if (type() != Type::array_t) return 0;
+
+    auto f = frame (m_node);
+    return f.m_count - (f.m_describedArray ? 1 : 0);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Cursor::isArrayDescribed() const {
+    return type() == Type::array_t && frame (m_node).m_describedArray;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Type
+amqp::internal::decoder::
+Cursor::arrayType() const {
+    return type() == Type::array_t
+        ? typeOf (frame (m_node).m_elementCode)
+        : Type::invalid_t;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Cursor::getBool() const {
+    if (!m_valid) return false;
+
+    switch (m_node.m_code) {
+        case 0x41 : return true;
+        case 0x56 : return u8 (m_node.m_payload) != 0;
+        default : return false;
+    }
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::internal::decoder::
+Cursor::getUbyte() const {
+    return (m_valid && m_node.m_code == 0x50) ? u8 (m_node.m_payload) : 0;
+}
+
+/******************************************************************************/
+
+int8_t
+amqp::internal::decoder::
+Cursor::getByte() const {
+    return (m_valid && m_node.m_code == 0x51)
+        ? static_cast<int8_t>(u8 (m_node.m_payload))
+        : 0;
+}
+
+/******************************************************************************/
+
+uint16_t
+amqp::internal::decoder::
+Cursor::getUshort() const {
+    return (m_valid && m_node.m_code == 0x60) ? u16 (m_node.m_payload) : 0;
+}
+
+/******************************************************************************/
+
+int16_t
+amqp::internal::decoder::
+Cursor::getShort() const {
+    return (m_valid && m_node.m_code == 0x61)
+        ? static_cast<int16_t>(u16 (m_node.m_payload))
+        : 0;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Cursor::getUint() const {
+    if (!m_valid) return 0;
+
+    switch (m_node.m_code) {
+        case 0x70 : return u32 (m_node.m_payload);
+        case 0x52 : return u8 (m_node.m_payload);
+        default : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int32_t
+amqp::internal::decoder::
+Cursor::getInt() const {
+    if (!m_valid) return 0;
+
+    switch (m_node.m_code) {
+        case 0x71 : return static_cast<int32_t>(u32 (m_node.m_payload));
+        case 0x54 : return static_cast<int8_t>(u8 (m_node.m_payload));
+        default : return 0;
+    }
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Cursor::getChar() const {
+    return (m_valid && m_node.m_code == 0x73) ? u32 (m_node.m_payload) : 0;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::decoder::
+Cursor::getUlong() const {
+    if (!m_valid) return 0;
+
+    switch (m_node.m_code) {
+        case 0x80 : return u64 (m_node.m_payload);
+        case 0x53 : return u8 (m_node.m_payload);
+        default : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::internal::decoder::
+Cursor::getLong() const {
+    if (!m_valid) return 0;
+
+    switch (m_node.m_code) {
+        case 0x81 : return static_cast<int64_t>(u64 (m_node.m_payload));
+        case 0x55 : return static_cast<int8_t>(u8 (m_node.m_payload));
+        default : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::internal::decoder::
+Cursor::getTimestamp() const {
+    return (m_valid && m_node.m_code == 0x83)
+        ? static_cast<int64_t>(u64 (m_node.m_payload))
+        : 0;
+}
+
+/******************************************************************************/
+
+float
+amqp::internal::decoder::
+Cursor::getFloat() const {
+    if (!m_valid || m_node.m_code != 0x72) return 0;
+
+    auto bits = u32 (m_node.m_payload);
+    float rtn;
+    std::memcpy (&rtn, &bits, sizeof (rtn));
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+double
+amqp::internal::decoder::
+Cursor::getDouble() const {
+    if (!m_valid || m_node.m_code != 0x82) return 0;
+
+    auto bits = u64 (m_node.m_payload);
+    double rtn;
+    std::memcpy (&rtn, &bits, sizeof (rtn));
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Cursor::getDecimal32() const {
+    return (m_valid && m_node.m_code == 0x74) ? u32 (m_node.m_payload) : 0;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::decoder::
+Cursor::getDecimal64() const {
+    return (m_valid && m_node.m_code == 0x84) ? u64 (m_node.m_payload) : 0;
+}
+
+/******************************************************************************/
+
+std::array<uint8_t, 16>
+amqp::internal::decoder::
+Cursor::getDecimal128() const {
+    std::array<uint8_t, 16> rtn { };
+
+    if (m_valid && m_node.m_code == 0x94) {
+        std::memcpy (rtn.data(), m_bytes + m_node.m_payload, rtn.size());
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::array<uint8_t, 16>
+amqp::internal::decoder::
+Cursor::getUuid() const {
+    std::array<uint8_t, 16> rtn { };
+
+    if (m_valid && m_node.m_code == 0x98) {
+        std::memcpy (rtn.data(), m_bytes + m_node.m_payload, rtn.size());
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Cursor::view (Type type_) const {
+    if (type() != type_) return { };
+
+    const size_t width = prefix (m_node.m_code);
+
+    return { reinterpret_cast<const char *>(m_bytes) + m_node.m_payload + width,
+             m_node.m_end - m_node.m_payload - width };
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Cursor::getBinary() const {
+    return view (Type::binary_t);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Cursor::getString() const {
+    return view (Type::string_t);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Cursor::getSymbol() const {
+    return view (Type::symbol_t);
+}
+
+/******************************************************************************
+ *
+ * Helpers
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::decoder::is_described (const Cursor & cursor_) {
+    if (cursor_.type() != Type::described_t) {
+        throw std::runtime_error ("Expected a described type");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::is_descriptor (
+        const Cursor & cursor_,
+        std::string_view descriptor_
+) {
+    is_symbol (cursor_);
+
+    if (cursor_.getSymbol() != descriptor_) {
+        throw std::runtime_error (
+                "Expected descriptor " + std::string (descriptor_)
+                + " not " + std::string (cursor_.getSymbol()));
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::referenceDescriptor() {
+    static const auto pattern = [] {
+        const uint64_t descriptor = schema::descriptors::DESCRIPTOR_TOP_32BITS
+            | static_cast<uint64_t>(schema::descriptors::REFERENCED_OBJECT);
+
+        std::array<char, 9> rtn { static_cast<char>(0x80) };
+
+        for (size_t i { 0 } ; i < 8 ; ++i) {
+            rtn[1 + i] = static_cast<char>(descriptor >> (56 - 8 * i));
+        }
+
+        return rtn;
+    }();
+
+    return { pattern.data(), pattern.size() };
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::mayReference (std::string_view bytes_) {
+    return bytes_.find (referenceDescriptor()) != std::string_view::npos;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::is_ulong (const Cursor & cursor_) {
+    auto t = cursor_.type();
+    if (t != Type::ulong_t) {
+        throw std::runtime_error (
+                "Expected an unsigned long but received "
+                    + std::string (typeName (t)));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::is_symbol (const Cursor & cursor_) {
+    if (cursor_.type() != Type::symbol_t) {
+        throw std::runtime_error ("Expected a symbol");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::is_list (const Cursor & cursor_) {
+    if (cursor_.type() != Type::list_t) {
+        throw std::runtime_error ("Expected a list");
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_enter
+ *
+ ******************************************************************************/
+
+/**
+ * Matches proton::auto_enter, we land on the first child rather than
+ * before it, and on the second if [next_] is set
+ */
+amqp::internal::decoder::
+auto_enter::auto_enter (Cursor & cursor_, bool next_)
+    : m_cursor (cursor_)
+{
+    m_cursor.enter();
+    m_cursor.next();
+    if (next_) m_cursor.next();
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_enter::~auto_enter() {
+    m_cursor.exit();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_next
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+auto_next::auto_next (Cursor & cursor_)
+    : m_cursor (cursor_)
+    , m_exceptions (std::uncaught_exceptions())
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_next::~auto_next() noexcept (false) {
+    if (std::uncaught_exceptions() == m_exceptions) {
+        m_cursor.next();
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_list_enter
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+auto_list_enter::auto_list_enter (Cursor & cursor_, bool next_)
+    : m_elements (cursor_.elementCount())
+    , m_cursor (cursor_)
+{
+    m_cursor.enter();
+    if (next_) m_cursor.next();
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_list_enter::~auto_list_enter() {
+    m_cursor.exit();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_map_enter
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+auto_map_enter::auto_map_enter (Cursor & cursor_, bool next_)
+    : m_elements (cursor_.mapCount())
+    , m_cursor (cursor_)
+{
+    m_cursor.enter();
+    if (next_) m_cursor.next();
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_map_enter::~auto_map_enter() {
+    m_cursor.exit();
+}
+
+/******************************************************************************
+ *
+ * readAndNext
+ *
+ ******************************************************************************/
+
+template<>
+int32_t
+amqp::internal::decoder::
+readAndNext<int32_t> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getInt();
+}
+
+/******************************************************************************/
+
+template<>
+int64_t
+amqp::internal::decoder::
+readAndNext<int64_t> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getLong();
+}
+
+/******************************************************************************/
+
+template<>
+uint64_t
+amqp::internal::decoder::
+readAndNext<uint64_t> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getUlong();
+}
+
+/******************************************************************************/
+
+template<>
+bool
+amqp::internal::decoder::
+readAndNext<bool> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getBool();
+}
+
+/******************************************************************************/
+
+template<>
+double
+amqp::internal::decoder::
+readAndNext<double> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getDouble();
+}
+
+/******************************************************************************/
+
+template<>
+int8_t
+amqp::internal::decoder::
+readAndNext<int8_t> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getByte();
+}
+
+/******************************************************************************/
+
+template<>
+int16_t
+amqp::internal::decoder::
+readAndNext<int16_t> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getShort();
+}
+
+/******************************************************************************/
+
+template<>
+char32_t
+amqp::internal::decoder::
+readAndNext<char32_t> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getChar();
+}
+
+/******************************************************************************/
+
+template<>
+float
+amqp::internal::decoder::
+readAndNext<float> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return cursor_.getFloat();
+}
+
+/******************************************************************************/
+
+template<>
+std::string_view
+amqp::internal::decoder::
+readAndNext<std::string_view> (Cursor & cursor_, bool tolerateDeviance_) {
+    auto_next an (cursor_);
+
+    switch (cursor_.type()) {
+        case Type::string_t : return cursor_.getString();
+        case Type::symbol_t : return cursor_.getSymbol();
+        case Type::null_t :
+            if (tolerateDeviance_) return { };
+            break;
+        default :
+            break;
+    }
+
+    throw std::runtime_error (
+            "Expected a String but found "
+                + std::string (typeName (cursor_.type())));
+}
+
+/******************************************************************************/
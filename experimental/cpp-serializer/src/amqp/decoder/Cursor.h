@@ -0,0 +1,397 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    enum class Type : uint8_t {
+        invalid_t,
+        null_t,
+        bool_t,
+        ubyte_t,
+        byte_t,
+        ushort_t,
+        short_t,
+        uint_t,
+        int_t,
+        char_t,
+        ulong_t,
+        long_t,
+        timestamp_t,
+        float_t,
+        double_t,
+        decimal32_t,
+        decimal64_t,
+        decimal128_t,
+        uuid_t,
+        binary_t,
+        string_t,
+        symbol_t,
+        described_t,
+        array_t,
+        list_t,
+        map_t
+    };
+
+    std::string_view typeName (Type);
+
+    /**
+     * Maps an AMQP 1.0 format code onto the type it encodes
+     */
+    Type typeOf (uint8_t);
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * Walks an AMQP 1.0 encoded buffer in place. Navigation mirrors a
+     * proton pn_data_t, enter / next / exit and typed getters on the
+     * current node, but nothing is decoded until it's asked for and a
+     * node is never visited more than once; stepping over a compound
+     * value uses its size prefix rather than walking its contents.
+     *
+     * As with proton, entering a node leaves the cursor before its first
+     * child so next() must be called to reach it, and getters return a
+     * zero value if the current node isn't of the type asked for.
+     *
+     * The cursor doesn't own the bytes, they must outlive it, as must any
+     * views handed out by the string getters.
+     */
+    class Cursor {
+        private :
+            struct Node {
+                /**
+                 * Offsets into the buffer of the format code, of whatever
+                 * follows it, and of the first byte after the value
+                 */
+                size_t m_start;
+                size_t m_payload;
+                size_t m_end;
+                uint8_t m_code;
+            };
+
+            struct Frame {
+                /**
+                 * The node that was entered, becomes current again on exit
+                 */
+                Node m_parent;
+                bool m_hasParent;
+
+                /**
+                 * Offset of the first child and, for arrays, of the first
+                 * element, which differ only when the array is described
+                 */
+                size_t m_first;
+                size_t m_elements;
+                size_t m_end;
+
+                size_t m_count;
+                size_t m_index;
+
+                /**
+                 * Array elements share a single constructor and so carry
+                 * no format code of their own. A described array's first
+                 * child is its descriptor, which does.
+                 */
+                uint8_t m_elementCode;
+                bool m_array;
+                bool m_describedArray;
+            };
+
+            const uint8_t * m_bytes;
+            size_t m_size;
+
+            Node m_node;
+            bool m_valid;
+
+            std::vector<Frame> m_frames;
+
+            /**
+             * Bytes of every object finished so far in the order they
+             * were finished, which is the order the JVM numbers them in
+             * when it writes a back reference. Only the cursor a walk
+             * starts from keeps one, [m_origin] being that cursor for
+             * those made over bytes recalled from it.
+             */
+            std::vector<std::string_view> m_objects;
+            const Cursor * m_origin;
+            bool m_complete;
+
+            Node parse (size_t, uint8_t) const;
+            size_t skip (size_t) const;
+            size_t width (uint8_t, size_t) const;
+
+            void require (size_t, size_t) const;
+
+            uint8_t u8 (size_t) const;
+            uint16_t u16 (size_t) const;
+            uint32_t u32 (size_t) const;
+            uint64_t u64 (size_t) const;
+
+            /**
+             * What entering a described, list, map or array node would
+             * push onto the stack
+             */
+            Frame frame (const Node &) const;
+
+            std::string_view view (Type) const;
+
+            template<class T>
+            size_t run (Type, T *, size_t);
+
+        public :
+            Cursor (const char *, size_t);
+            explicit Cursor (std::string_view);
+
+            /**
+             * Over bytes recalled from [origin_], references within them
+             * resolve against its table and nothing read through us is
+             * added to it, it was all added the first time around
+             */
+            Cursor (std::string_view, const Cursor & origin_);
+
+            bool next();
+            bool enter();
+            bool exit();
+
+            /**
+             * Back to the position the cursor had when it was created
+             */
+            void rewind();
+
+            Type type() const;
+
+            size_t depth() const { return m_frames.size() - 1; }
+
+            /**
+             * The encoded bytes of the current node, constructor included,
+             * suitable for handing to another decoder
+             */
+            std::string_view raw() const;
+
+            /**
+             * Whether the current node is a REFERENCED_OBJECT, written by
+             * the JVM in place of an object it has already written
+             */
+            bool isReference() const;
+
+            /**
+             * With the cursor on a reference, the bytes of the object it
+             * refers to. Found by index so costs the same however far
+             * back the object was.
+             */
+            std::string_view referenced() const;
+
+            /**
+             * With the cursor on a reference, the number of the object
+             * it refers to in the table
+             */
+            size_t reference() const;
+
+            /**
+             * Add an object, its bytes as given by raw(), to the table
+             * once everything within it has been read
+             */
+            void remember (std::string_view);
+
+            /**
+             * Note that values have been stepped over unread, anything in
+             * them that should have been remembered wasn't so the table
+             * can no longer be trusted
+             */
+            void forget();
+
+            size_t objects() const;
+
+            size_t listCount() const;
+            size_t mapCount() const;
+
+            /**
+             * The elements of a list or, as the body of a list or array
+             * can be written as either, an array. Described arrays are
+             * rejected, their descriptor would be taken for an element.
+             */
+            size_t elementCount() const;
+
+            size_t arrayCount() const;
+            bool isArrayDescribed() const;
+            Type arrayType() const;
+
+            bool getBool() const;
+            uint8_t getUbyte() const;
+            int8_t getByte() const;
+            uint16_t getUshort() const;
+            int16_t getShort() const;
+            uint32_t getUint() const;
+            int32_t getInt() const;
+            uint32_t getChar() const;
+            uint64_t getUlong() const;
+            int64_t getLong() const;
+            int64_t getTimestamp() const;
+            float getFloat() const;
+            double getDouble() const;
+            uint32_t getDecimal32() const;
+            uint64_t getDecimal64() const;
+            std::array<uint8_t, 16> getDecimal128() const;
+            std::array<uint8_t, 16> getUuid() const;
+
+            std::string_view getBinary() const;
+            std::string_view getString() const;
+            std::string_view getSymbol() const;
+
+            /**
+             * With the cursor on an element of a list or array, reads it
+             * and as many of those after it, up to [max_], as are encoded
+             * as a [type_] into [out_], leaving the cursor as reading each
+             * in turn with readAndNext would. Returns how many were read,
+             * so if that's fewer than [max_] the cursor is on an element
+             * that must be read some other way, a null or a back reference
+             * say, or at the end of the collection.
+             *
+             * Bytes and shorts widen to an int, floats read into a double
+             * widen to one and timestamps are read as their milliseconds.
+             * Defined in Bulk.cxx, runs of the single byte encodings in a
+             * list and every array are decoded a block at a time with
+             * SSE2 where it's available.
+             */
+            size_t readRun (Type type_, bool * out_, size_t max_);
+            size_t readRun (Type type_, int32_t * out_, size_t max_);
+            size_t readRun (Type type_, int64_t * out_, size_t max_);
+            size_t readRun (Type type_, double * out_, size_t max_);
+            size_t readRun (Type type_, float * out_, size_t max_);
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Helpers mirroring those in proton_wrapper so readers written against
+ * one translate directly to the other
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    void is_list (const Cursor &);
+    void is_ulong (const Cursor &);
+    void is_symbol (const Cursor &);
+    void is_described (const Cursor &);
+
+    /**
+     * The cursor's on the descriptor of a described value and it's the
+     * symbol [descriptor_]
+     */
+    void is_descriptor (const Cursor &, std::string_view descriptor_);
+
+    /**
+     * How a back reference's descriptor is encoded, the REFERENCED_OBJECT
+     * ulong always written at full width
+     */
+    std::string_view referenceDescriptor();
+
+    /**
+     * Whether [bytes_] might hold a back reference, false only if they
+     * certainly don't. A scan for the reference's descriptor, which is
+     * always written at full width.
+     */
+    bool mayReference (std::string_view bytes_);
+
+    class auto_enter {
+        private :
+            Cursor & m_cursor;
+
+        public :
+            explicit auto_enter (Cursor &, bool next_ = false);
+            ~auto_enter();
+    };
+
+    /**
+     * Unlike proton's, moving on can find the bytes malformed and throw,
+     * so this is the one helper whose destructor may throw. It doesn't
+     * bother moving if we're already unwinding.
+     */
+    class auto_next {
+        private :
+            Cursor & m_cursor;
+            int m_exceptions;
+
+        public :
+            explicit auto_next (Cursor &);
+            auto_next (const auto_next &) = delete;
+            ~auto_next() noexcept (false);
+    };
+
+    class auto_list_enter {
+        private :
+            size_t m_elements;
+            Cursor & m_cursor;
+
+        public :
+            explicit auto_list_enter (Cursor &, bool next_ = false);
+            ~auto_list_enter();
+
+            size_t elements() const { return m_elements; }
+    };
+
+    class auto_map_enter {
+        private :
+            size_t m_elements;
+            Cursor & m_cursor;
+
+        public :
+            explicit auto_map_enter (Cursor &, bool next_ = false);
+            ~auto_map_enter();
+
+            size_t elements() const { return m_elements; }
+    };
+
+    template<typename T>
+    T readAndNext (Cursor &, bool tolerateDeviance_ = false);
+
+    template<>
+    int32_t readAndNext<int32_t> (Cursor &, bool);
+
+    template<>
+    int64_t readAndNext<int64_t> (Cursor &, bool);
+
+    template<>
+    uint64_t readAndNext<uint64_t> (Cursor &, bool);
+
+    template<>
+    bool readAndNext<bool> (Cursor &, bool);
+
+    template<>
+    double readAndNext<double> (Cursor &, bool);
+
+    template<>
+    int8_t readAndNext<int8_t> (Cursor &, bool);
+
+    template<>
+    int16_t readAndNext<int16_t> (Cursor &, bool);
+
+    template<>
+    char32_t readAndNext<char32_t> (Cursor &, bool);
+
+    template<>
+    float readAndNext<float> (Cursor &, bool);
+
+    /**
+     * Accepts either a string or a symbol
+     */
+    template<>
+    std::string_view readAndNext<std::string_view> (Cursor &, bool);
+
+}
+
+/******************************************************************************/
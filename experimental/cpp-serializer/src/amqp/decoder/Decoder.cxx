@@ -0,0 +1,65 @@
+#include "Decoder.h"
+
+#include <stdexcept>
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_composite_enter
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+auto_composite_enter::auto_composite_enter (
+    Cursor & cursor_,
+    std::string_view descriptor_
+) : m_cursor (cursor_) {
+    is_described (m_cursor);
+
+    m_cursor.enter();
+    m_cursor.next();
+
+    if (m_cursor.type() != Type::symbol_t
+        || m_cursor.getSymbol() != descriptor_)
+    {
+        m_cursor.exit();
+        throw std::runtime_error (
+                "Expected an object described by " + std::string (descriptor_));
+    }
+
+    m_cursor.next();
+    is_list (m_cursor);
+
+    m_cursor.enter();
+    m_cursor.next();
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_composite_enter::~auto_composite_enter() {
+    m_cursor.exit();
+    m_cursor.exit();
+}
+
+/******************************************************************************/
+
+/**
+ * As EnumReader reads it, the constant's name is the first element of
+ * the described list with its ordinal following. A reference will have
+ * been resolved by decode before we get here.
+ */
+std::string_view
+amqp::internal::decoder::
+enumChoice (Cursor & cursor_) {
+    auto_next an (cursor_);
+    is_described (cursor_);
+
+    auto_enter ae (cursor_);
+    cursor_.next();
+
+    auto_list_enter ale (cursor_, true);
+
+    return readAndNext<std::string_view> (cursor_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,358 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "Cursor.h"
+#include "Scalars.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * Reads a value of type T with the cursor on it, leaving the cursor
+     * on whatever follows.
+     *
+     * Specialised here for the primitives and the containers lists, maps
+     * and arrays map onto, and by schema-dumper --generate for the
+     * composites and enums of a schema. Those have their field order
+     * baked in so, unlike walking the readers, nothing is looked up and
+     * nothing is virtual as a blob is decoded.
+     */
+    template<class T>
+    struct Decoder;
+
+    /**
+     * Whether the JVM remembers values of type T as it writes them and
+     * so can write them again as back references. Never boxed primitives
+     * or byte arrays, and strings, dates, UUIDs and decimals only as
+     * elements of a collection.
+     */
+    template<class T>
+    inline constexpr bool remembered = true;
+
+    template<> inline constexpr bool remembered<int32_t> = false;
+    template<> inline constexpr bool remembered<int64_t> = false;
+    template<> inline constexpr bool remembered<bool> = false;
+    template<> inline constexpr bool remembered<double> = false;
+    template<> inline constexpr bool remembered<std::string> = false;
+    template<> inline constexpr bool remembered<int8_t> = false;
+    template<> inline constexpr bool remembered<int16_t> = false;
+    template<> inline constexpr bool remembered<char32_t> = false;
+    template<> inline constexpr bool remembered<float> = false;
+    template<> inline constexpr bool remembered<Timestamp> = false;
+    template<> inline constexpr bool remembered<Uuid> = false;
+    template<> inline constexpr bool remembered<Decimal> = false;
+    template<> inline constexpr bool remembered<std::vector<std::byte>> = false;
+
+    template<class T>
+    inline constexpr bool rememberedElement = remembered<T>;
+
+    template<> inline constexpr bool rememberedElement<std::string> = true;
+    template<> inline constexpr bool rememberedElement<Timestamp> = true;
+    template<> inline constexpr bool rememberedElement<Uuid> = true;
+    template<> inline constexpr bool rememberedElement<Decimal> = true;
+
+    /**
+     * Decodes the value the cursor is on or, if it's a back reference,
+     * the one it refers to, remembering it if [remember_]
+     */
+    template<class T>
+    void decode (Cursor & cursor_, T & value_, bool remember_ = remembered<T>) {
+        if (cursor_.isReference()) {
+            Cursor replay (cursor_.referenced(), cursor_);
+            replay.next();
+
+            Decoder<T>::decode (replay, value_);
+
+            cursor_.next();
+        } else if (remember_) {
+            auto raw = cursor_.raw();
+
+            Decoder<T>::decode (cursor_, value_);
+
+            cursor_.remember (raw);
+        } else {
+            Decoder<T>::decode (cursor_, value_);
+        }
+    }
+
+    /**
+     * As an element of a list or map strings and the like are remembered too
+     */
+    template<class T>
+    void decodeElement (Cursor & cursor_, T & value_) {
+        decode (cursor_, value_, rememberedElement<T>);
+    }
+
+    /**
+     * The encoding a vector of T is read a run at a time as, null_t for
+     * those read an element at a time
+     */
+    template<class T>
+    inline constexpr Type run = Type::null_t;
+
+    template<> inline constexpr Type run<int32_t> = Type::int_t;
+    template<> inline constexpr Type run<int64_t> = Type::long_t;
+    template<> inline constexpr Type run<double> = Type::double_t;
+    template<> inline constexpr Type run<float> = Type::float_t;
+
+    /**
+     * With [bytes_] being a blob less its Corda header, decode the value
+     * at the root of its envelope
+     */
+    template<class T>
+    void decodePayload (std::string_view bytes_, T & value_);
+
+}
+
+/******************************************************************************
+ *
+ * Helpers for generated decoders
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * Steps into the field list of a described composite. The descriptor
+     * is checked against the one the decoder was generated from as a blob
+     * written by a different version of a class will carry a different
+     * fingerprint, and decoding it field by field would be meaningless.
+     */
+    class auto_composite_enter {
+        private :
+            Cursor & m_cursor;
+
+        public :
+            auto_composite_enter (Cursor &, std::string_view);
+            auto_composite_enter (const auto_composite_enter &) = delete;
+            ~auto_composite_enter();
+    };
+
+    /**
+     * The name of the constant held by the described enum the cursor is
+     * on, the view is into the buffer the cursor walks
+     */
+    std::string_view enumChoice (Cursor &);
+
+}
+
+/******************************************************************************
+ *
+ * Primitives
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    template<>
+    struct Decoder<int32_t> {
+        static void decode (Cursor & cursor_, int32_t & value_) {
+            value_ = readAndNext<int32_t> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<int64_t> {
+        static void decode (Cursor & cursor_, int64_t & value_) {
+            value_ = readAndNext<int64_t> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<bool> {
+        static void decode (Cursor & cursor_, bool & value_) {
+            value_ = readAndNext<bool> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<double> {
+        static void decode (Cursor & cursor_, double & value_) {
+            value_ = readAndNext<double> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<std::string> {
+        static void decode (Cursor & cursor_, std::string & value_) {
+            value_.assign (readAndNext<std::string_view> (cursor_));
+        }
+    };
+
+    template<>
+    struct Decoder<int8_t> {
+        static void decode (Cursor & cursor_, int8_t & value_) {
+            value_ = readAndNext<int8_t> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<int16_t> {
+        static void decode (Cursor & cursor_, int16_t & value_) {
+            value_ = readAndNext<int16_t> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<char32_t> {
+        static void decode (Cursor & cursor_, char32_t & value_) {
+            value_ = readAndNext<char32_t> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<float> {
+        static void decode (Cursor & cursor_, float & value_) {
+            value_ = readAndNext<float> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<Timestamp> {
+        static void decode (Cursor & cursor_, Timestamp & value_) {
+            value_ = readAndNext<Timestamp> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<Uuid> {
+        static void decode (Cursor & cursor_, Uuid & value_) {
+            value_ = readAndNext<Uuid> (cursor_);
+        }
+    };
+
+    template<>
+    struct Decoder<Decimal> {
+        static void decode (Cursor & cursor_, Decimal & value_) {
+            value_ = readAndNext<Decimal> (cursor_);
+        }
+    };
+
+    /**
+     * A byte[], an AMQP binary rather than a list of bytes
+     */
+    template<>
+    struct Decoder<std::vector<std::byte>> {
+        static void decode (Cursor & cursor_, std::vector<std::byte> & value_) {
+            auto bytes = readAndNext<Binary> (cursor_).m_bytes;
+
+            value_.resize (bytes.size());
+
+            if (!bytes.empty()) {
+                std::memcpy (value_.data(), bytes.data(), bytes.size());
+            }
+        }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Containers
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * Lists and arrays, both described with their elements in a list or,
+     * should the JVM ever write one, an array. Ints, longs, doubles and
+     * floats are read a run at a time.
+     */
+    template<class T>
+    struct Decoder<std::vector<T>> {
+        static void decode (Cursor & cursor_, std::vector<T> & value_) {
+            auto_next an (cursor_);
+            is_described (cursor_);
+
+            auto_enter ae (cursor_);
+            cursor_.next();
+
+            auto_list_enter ale (cursor_, true);
+
+            if constexpr (run<T> != Type::null_t) {
+                value_.resize (ale.elements());
+
+                for (size_t i { 0 } ; i < value_.size() ; ) {
+                    auto n = cursor_.readRun (run<T>, value_.data() + i, value_.size() - i);
+
+                    if (n == 0) {
+                        decodeElement (cursor_, value_[i]);
+                        n = 1;
+                    }
+
+                    i += n;
+                }
+            } else {
+                value_.clear();
+                value_.reserve (ale.elements());
+
+                for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                    T element { };
+                    decodeElement (cursor_, element);
+                    value_.push_back (std::move (element));
+                }
+            }
+        }
+    };
+
+    /**
+     * Maps, kept as their entries in the order they were encoded rather
+     * than rebuilt into a std::map so key types needn't be ordered and
+     * what was written is what we hand back
+     */
+    template<class K, class V>
+    struct Decoder<std::vector<std::pair<K, V>>> {
+        static void decode (Cursor & cursor_, std::vector<std::pair<K, V>> & value_) {
+            auto_next an (cursor_);
+            is_described (cursor_);
+
+            auto_enter ae (cursor_);
+            cursor_.next();
+
+            auto_map_enter am (cursor_, true);
+
+            value_.clear();
+            value_.reserve (am.elements() / 2);
+
+            for (size_t i { 0 } ; i < am.elements() ; i += 2) {
+                std::pair<K, V> entry { };
+                decodeElement (cursor_, entry.first);
+                decodeElement (cursor_, entry.second);
+                value_.push_back (std::move (entry));
+            }
+        }
+    };
+
+}
+
+/******************************************************************************/
+
+template<class T>
+void
+amqp::internal::decoder::
+decodePayload (std::string_view bytes_, T & value_) {
+    Cursor cursor (bytes_);
+    cursor.next();
+
+    is_described (cursor);
+    auto_enter ae (cursor, true);
+    is_list (cursor);
+
+    auto_list_enter ale (cursor, true);
+
+    decode (cursor, value_);
+}
+
+/******************************************************************************/
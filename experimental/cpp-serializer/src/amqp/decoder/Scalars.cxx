@@ -0,0 +1,352 @@
+#include "Scalars.h"
+
+#include <cstring>
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::decoder;
+
+    /**
+     * A GCC and Clang extension, marked as such so -pedantic lets it be
+     */
+    __extension__ using u128 = unsigned __int128;
+
+    constexpr char DIGITS[] = "0123456789abcdef";
+
+    /**
+     * How each width splits its bits, and the largest coefficient that
+     * width allows, anything larger being non-canonical and read as zero
+     */
+    struct Layout {
+        int m_width;
+        int m_exponentBits;
+        int m_bias;
+        int m_digits;
+    };
+
+    constexpr Layout DECIMAL32 { 32, 8, 101, 7 };
+    constexpr Layout DECIMAL64 { 64, 10, 398, 16 };
+    constexpr Layout DECIMAL128 { 128, 14, 6176, 34 };
+
+    u128
+    mask (int bits_) {
+        return bits_ >= 128 ? ~u128 { 0 } : (u128 { 1 } << bits_) - 1;
+    }
+
+    u128
+    power (int digits_) {
+        u128 rtn { 1 };
+        while (digits_-- > 0) rtn *= 10;
+        return rtn;
+    }
+
+    /**
+     * Digits of [value_] written backwards from the end of [buffer_],
+     * returning where they start
+     */
+    char *
+    digits (u128 value_, char * end_) {
+        do {
+            *--end_ = static_cast<char>('0' + static_cast<int>(value_ % 10));
+            value_ /= 10;
+        } while (value_ != 0);
+
+        return end_;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * Comparisons
+ *
+ ******************************************************************************/
+
+bool
+amqp::internal::decoder::
+operator == (const Uuid & lhs_, const Uuid & rhs_) {
+    return lhs_.m_bytes == rhs_.m_bytes;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+operator != (const Uuid & lhs_, const Uuid & rhs_) {
+    return !(lhs_ == rhs_);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+operator == (const Decimal & lhs_, const Decimal & rhs_) {
+    return lhs_.m_type == rhs_.m_type
+        && lhs_.m_high == rhs_.m_high
+        && lhs_.m_low == rhs_.m_low;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+operator != (const Decimal & lhs_, const Decimal & rhs_) {
+    return !(lhs_ == rhs_);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::Text
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::decoder::
+Text::append (std::string_view chars_) {
+    std::memcpy (m_chars.data() + m_size, chars_.data(), chars_.size());
+    m_size += chars_.size();
+}
+
+/******************************************************************************
+ *
+ * Text forms
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::Text
+amqp::internal::decoder::
+text (char32_t char_) {
+    if (char_ > 0x10ffff || (char_ >= 0xd800 && char_ <= 0xdfff)) {
+        char_ = 0xfffd;
+    }
+
+    Text rtn;
+
+    if (char_ < 0x80) {
+        rtn.append (static_cast<char>(char_));
+    } else if (char_ < 0x800) {
+        rtn.append (static_cast<char>(0xc0 | (char_ >> 6)));
+        rtn.append (static_cast<char>(0x80 | (char_ & 0x3f)));
+    } else if (char_ < 0x10000) {
+        rtn.append (static_cast<char>(0xe0 | (char_ >> 12)));
+        rtn.append (static_cast<char>(0x80 | ((char_ >> 6) & 0x3f)));
+        rtn.append (static_cast<char>(0x80 | (char_ & 0x3f)));
+    } else {
+        rtn.append (static_cast<char>(0xf0 | (char_ >> 18)));
+        rtn.append (static_cast<char>(0x80 | ((char_ >> 12) & 0x3f)));
+        rtn.append (static_cast<char>(0x80 | ((char_ >> 6) & 0x3f)));
+        rtn.append (static_cast<char>(0x80 | (char_ & 0x3f)));
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Text
+amqp::internal::decoder::
+text (const Uuid & uuid_) {
+    Text rtn;
+
+    for (size_t i { 0 } ; i < uuid_.m_bytes.size() ; ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            rtn.append ('-');
+        }
+
+        rtn.append (DIGITS[uuid_.m_bytes[i] >> 4]);
+        rtn.append (DIGITS[uuid_.m_bytes[i] & 0xf]);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * The combination field following the sign holds the exponent and the
+ * top of the coefficient. If its top two bits are 11 the coefficient's
+ * implicit leading bits are 100 rather than 0 and the exponent starts
+ * two bits later, unless the next two are also 11 in which case it's an
+ * infinity or, with the bit after them set, a NaN.
+ */
+amqp::internal::decoder::Text
+amqp::internal::decoder::
+text (const Decimal & decimal_) {
+    Text rtn;
+
+    const Layout * layout;
+
+    switch (decimal_.m_type) {
+        case Type::decimal32_t : layout = &DECIMAL32; break;
+        case Type::decimal64_t : layout = &DECIMAL64; break;
+        case Type::decimal128_t : layout = &DECIMAL128; break;
+        default :
+            rtn.append ('0');
+            return rtn;
+    }
+
+    const int w = layout->m_width;
+    const int e = layout->m_exponentBits;
+
+    const u128 bits = (u128 { decimal_.m_high } << 64) | decimal_.m_low;
+    const bool negative = (bits >> (w - 1)) & 1;
+
+    u128 coefficient;
+    int exponent;
+
+    if (((bits >> (w - 3)) & 0x3) != 0x3) {
+        exponent = static_cast<int>((bits >> (w - 1 - e)) & mask (e));
+        coefficient = bits & mask (w - 1 - e);
+    } else if (((bits >> (w - 5)) & 0xf) == 0xf) {
+        if ((bits >> (w - 6)) & 1) {
+            rtn.append ("NaN");
+        } else {
+            rtn.append (negative ? "-Infinity" : "Infinity");
+        }
+
+        return rtn;
+    } else {
+        exponent = static_cast<int>((bits >> (w - 3 - e)) & mask (e));
+        coefficient = (u128 { 0x4 } << (w - 3 - e)) | (bits & mask (w - 3 - e));
+    }
+
+    if (coefficient >= power (layout->m_digits)) {
+        coefficient = 0;
+    }
+
+    exponent -= layout->m_bias;
+
+    std::array<char, 40> buffer { };
+    const char * end = buffer.data() + buffer.size();
+    const char * first = digits (coefficient, buffer.data() + buffer.size());
+    const auto count = static_cast<int>(end - first);
+    const int adjusted = exponent + count - 1;
+
+    if (negative && coefficient != 0) {
+        rtn.append ('-');
+    }
+
+    if (exponent <= 0 && adjusted >= -6) {
+        const int point = count + exponent;
+
+        if (exponent == 0) {
+            rtn.append ({ first, static_cast<size_t>(count) });
+        } else if (point > 0) {
+            rtn.append ({ first, static_cast<size_t>(point) });
+            rtn.append ('.');
+            rtn.append ({ first + point, static_cast<size_t>(count - point) });
+        } else {
+            rtn.append ("0.");
+            for (int i { point } ; i < 0 ; ++i) rtn.append ('0');
+            rtn.append ({ first, static_cast<size_t>(count) });
+        }
+
+        return rtn;
+    }
+
+    rtn.append (*first);
+
+    if (count > 1) {
+        rtn.append ('.');
+        rtn.append ({ first + 1, static_cast<size_t>(count - 1) });
+    }
+
+    rtn.append ('E');
+    rtn.append (adjusted < 0 ? '-' : '+');
+
+    const char * exp = digits (
+            static_cast<u128>(adjusted < 0 ? -adjusted : adjusted),
+            buffer.data() + buffer.size());
+
+    rtn.append ({ exp, static_cast<size_t>(end - exp) });
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::decoder::
+hex (std::string_view bytes_) {
+    std::string rtn (bytes_.size() * 2, '0');
+
+    for (size_t i { 0 } ; i < bytes_.size() ; ++i) {
+        auto byte = static_cast<uint8_t>(bytes_[i]);
+        rtn[2 * i] = DIGITS[byte >> 4];
+        rtn[2 * i + 1] = DIGITS[byte & 0xf];
+    }
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * readAndNext
+ *
+ ******************************************************************************/
+
+template<>
+amqp::internal::decoder::Timestamp
+amqp::internal::decoder::
+readAndNext<amqp::internal::decoder::Timestamp> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return Timestamp { std::chrono::milliseconds { cursor_.getTimestamp() } };
+}
+
+/******************************************************************************/
+
+template<>
+amqp::internal::decoder::Uuid
+amqp::internal::decoder::
+readAndNext<amqp::internal::decoder::Uuid> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return Uuid { cursor_.getUuid() };
+}
+
+/******************************************************************************/
+
+/**
+ * Anything other than a decimal reads as a zero of no particular width
+ */
+template<>
+amqp::internal::decoder::Decimal
+amqp::internal::decoder::
+readAndNext<amqp::internal::decoder::Decimal> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+
+    switch (cursor_.type()) {
+        case Type::decimal32_t :
+            return { Type::decimal32_t, 0, cursor_.getDecimal32() };
+        case Type::decimal64_t :
+            return { Type::decimal64_t, 0, cursor_.getDecimal64() };
+        case Type::decimal128_t : {
+            auto bytes = cursor_.getDecimal128();
+
+            uint64_t high { 0 };
+            uint64_t low { 0 };
+
+            for (size_t i { 0 } ; i < 8 ; ++i) {
+                high = (high << 8) | bytes[i];
+                low = (low << 8) | bytes[i + 8];
+            }
+
+            return { Type::decimal128_t, high, low };
+        }
+        default :
+            return { Type::null_t, 0, 0 };
+    }
+}
+
+/******************************************************************************/
+
+template<>
+amqp::internal::decoder::Binary
+amqp::internal::decoder::
+readAndNext<amqp::internal::decoder::Binary> (Cursor & cursor_, bool) {
+    auto_next an (cursor_);
+    return Binary { cursor_.getBinary() };
+}
+
+/******************************************************************************/
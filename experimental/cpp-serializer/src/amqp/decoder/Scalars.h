@@ -0,0 +1,121 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+#include "Cursor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * Milliseconds since the Unix epoch, as a java.util.Date holds them
+     */
+    using Timestamp = std::chrono::time_point<
+            std::chrono::system_clock,
+            std::chrono::milliseconds>;
+
+    /**
+     * The sixteen bytes of a UUID in the order they're encoded, most
+     * significant first
+     */
+    struct Uuid {
+        std::array<uint8_t, 16> m_bytes;
+    };
+
+    bool operator == (const Uuid &, const Uuid &);
+    bool operator != (const Uuid &, const Uuid &);
+
+    /**
+     * An AMQP decimal32, decimal64 or decimal128, an IEEE 754 decimal
+     * float with a binary coefficient. C++ has nothing to hold one in so
+     * it's kept as its bits, the low 32 or 64 of [m_low] for the smaller
+     * two, until it's turned into text.
+     */
+    struct Decimal {
+        Type m_type;
+        uint64_t m_high;
+        uint64_t m_low;
+    };
+
+    bool operator == (const Decimal &, const Decimal &);
+    bool operator != (const Decimal &, const Decimal &);
+
+    /**
+     * The bytes of a binary value, a view into the blob like a string is
+     * but told apart from one when dispatching
+     */
+    struct Binary {
+        std::string_view m_bytes;
+    };
+
+    /**
+     * The text of a value with no natural C++ form, built on the stack.
+     * Large enough for the longest any of them can produce, a decimal128
+     * with all 34 digits, a point, a sign and up to six leading zeros.
+     */
+    class Text {
+        private :
+            std::array<char, 48> m_chars;
+            size_t m_size;
+
+        public :
+            Text() : m_chars { }, m_size (0) { }
+
+            void append (char c_) { m_chars[m_size++] = c_; }
+            void append (std::string_view);
+
+            std::string_view view() const { return { m_chars.data(), m_size }; }
+            operator std::string_view() const { return view(); } // NOLINT
+    };
+
+    /**
+     * A char as UTF-8, anything that isn't a Unicode scalar value
+     * becoming U+FFFD
+     */
+    Text text (char32_t);
+
+    /**
+     * The canonical 8-4-4-4-12 form, as java.util.UUID writes it
+     */
+    Text text (const Uuid &);
+
+    /**
+     * As java.math.BigDecimal writes it, plain unless the exponent is
+     * positive or the value small enough that it'd need more than six
+     * leading zeros, with NaN and the infinities spelt out
+     */
+    Text text (const Decimal &);
+
+    /**
+     * Two lower case hex digits per byte
+     */
+    std::string hex (std::string_view);
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    template<>
+    Timestamp readAndNext<Timestamp> (Cursor &, bool);
+
+    template<>
+    Uuid readAndNext<Uuid> (Cursor &, bool);
+
+    template<>
+    Decimal readAndNext<Decimal> (Cursor &, bool);
+
+    template<>
+    Binary readAndNext<Binary> (Cursor &, bool);
+
+}
+
+/******************************************************************************/
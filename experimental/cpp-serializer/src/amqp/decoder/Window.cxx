@@ -0,0 +1,129 @@
+#include "Window.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    uint32_t
+    u32 (std::string_view bytes_) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(bytes_[0])) << 24u
+             | static_cast<uint32_t>(static_cast<uint8_t>(bytes_[1])) << 16u
+             | static_cast<uint32_t>(static_cast<uint8_t>(bytes_[2])) << 8u
+             | static_cast<uint32_t>(static_cast<uint8_t>(bytes_[3]));
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+Window::Window (size_t capacity_)
+    : m_start (0)
+    , m_position (0)
+    , m_peak (0)
+{
+    m_buffer.reserve (capacity_);
+}
+
+/******************************************************************************/
+
+/**
+ * Consumed bytes are only dropped when there isn't room for the new ones
+ * behind them, so a run of small chunks costs one move rather than one
+ * each
+ */
+void
+amqp::internal::decoder::
+Window::append (std::string_view bytes_) {
+    if (m_start > 0 && m_buffer.size() + bytes_.size() > m_buffer.capacity()) {
+        m_buffer.erase (0, m_start);
+        m_start = 0;
+    }
+
+    m_buffer.append (bytes_);
+
+    m_peak = std::max (m_peak, size());
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Window::consume (size_t bytes_) {
+    if (bytes_ > size()) {
+        throw std::logic_error ("Consuming bytes that haven't arrived");
+    }
+
+    m_start += bytes_;
+    m_position += bytes_;
+
+    if (m_start == m_buffer.size()) {
+        m_buffer.clear();
+        m_start = 0;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The high nibble of a format code gives its width, fixed widths up to
+ * 0x9f and then alternately one and four byte size prefixes. A described
+ * value is its descriptor and then the value, each measured in turn,
+ * counted rather than recursed into as Cursor::skip does.
+ */
+std::optional<size_t>
+amqp::internal::decoder::
+Window::extent (std::string_view bytes_) {
+    size_t offset { 0 };
+    size_t pending { 1 };
+
+    while (pending > 0) {
+        if (offset >= bytes_.size()) {
+            return std::nullopt;
+        }
+
+        const auto code = static_cast<uint8_t>(bytes_[offset]);
+
+        if (code == 0x00) {
+            ++offset;
+            ++pending;
+            continue;
+        }
+
+        const auto rest = bytes_.size() - offset;
+        size_t width;
+
+        switch (code >> 4u) {
+            case 0x4 : width = 1; break;
+            case 0x5 : width = 2; break;
+            case 0x6 : width = 3; break;
+            case 0x7 : width = 5; break;
+            case 0x8 : width = 9; break;
+            case 0x9 : width = 17; break;
+            case 0xa :
+            case 0xc :
+            case 0xe :
+                if (rest < 2) return std::nullopt;
+                width = 2 + static_cast<uint8_t>(bytes_[offset + 1]);
+                break;
+            case 0xb :
+            case 0xd :
+            case 0xf :
+                if (rest < 5) return std::nullopt;
+                width = 5 + static_cast<size_t>(u32 (bytes_.substr (offset + 1)));
+                break;
+            default :
+                throw std::runtime_error ("Unknown AMQP format code");
+        }
+
+        offset += width;
+        --pending;
+    }
+
+    return offset;
+}
+
+/******************************************************************************/
@@ -0,0 +1,69 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * The bytes of a stream that have arrived but not yet been consumed.
+     *
+     * Bytes are appended as they arrive and dropped from the front once
+     * consumed, so what's held is never more than the value currently
+     * being read plus whatever of the next chunk came with it. The buffer
+     * is only ever moved down to make room, never reallocated, unless a
+     * single value won't fit in it.
+     */
+    class Window {
+        private :
+            std::string m_buffer;
+
+            /**
+             * Offset in the buffer of the first unconsumed byte
+             */
+            size_t m_start;
+
+            /**
+             * Offset in the stream of the first unconsumed byte
+             */
+            uint64_t m_position;
+
+            size_t m_peak;
+
+        public :
+            explicit Window (size_t capacity_);
+
+            void append (std::string_view);
+            void consume (size_t);
+
+            std::string_view bytes() const {
+                return { m_buffer.data() + m_start, m_buffer.size() - m_start };
+            }
+
+            size_t size() const { return m_buffer.size() - m_start; }
+
+            uint64_t position() const { return m_position; }
+
+            /**
+             * The most that's been held at once
+             */
+            size_t peak() const { return m_peak; }
+
+            /**
+             * With [bytes_] starting at an encoded value, the number of
+             * bytes that value occupies, constructor included, if enough
+             * of it is there to tell. Only the constructors and size
+             * prefixes are needed, not the value itself.
+             */
+            static std::optional<size_t> extent (std::string_view bytes_);
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,453 @@
+#include "Encoder.h"
+
+#include <cstring>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * The constructor, a four byte size and a four byte count
+     */
+    constexpr size_t WIDE = 9;
+
+    /**
+     * The constructor, a byte of size and a byte of count
+     */
+    constexpr size_t COMPACT = 3;
+
+}
+
+/******************************************************************************/
+
+amqp::internal::encoder::
+Encoder::Encoder (std::string & buffer_)
+    : m_buffer (buffer_)
+    , m_described (false)
+{
+    m_frames.reserve (16);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::u8 (uint8_t val_) {
+    m_buffer.push_back (static_cast<char>(val_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::u32 (uint32_t val_) {
+    for (int shift { 24 } ; shift >= 0 ; shift -= 8) {
+        u8 (static_cast<uint8_t>(val_ >> shift));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::u64 (uint64_t val_) {
+    for (int shift { 56 } ; shift >= 0 ; shift -= 8) {
+        u8 (static_cast<uint8_t>(val_ >> shift));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Every value counts towards the list or map it's written into, bar the
+ * one following a descriptor which was counted with it
+ */
+void
+amqp::internal::encoder::
+Encoder::element() {
+    if (m_described) {
+        m_described = false;
+    } else if (!m_frames.empty()) {
+        ++m_frames.back().m_count;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putNull() {
+    element();
+    u8 (0x40);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putBool (bool val_) {
+    element();
+    u8 (val_ ? 0x41 : 0x42);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putInt (int32_t val_) {
+    element();
+
+    if (val_ >= INT8_MIN && val_ <= INT8_MAX) {
+        u8 (0x54);
+        u8 (static_cast<uint8_t>(val_));
+    } else {
+        u8 (0x71);
+        u32 (static_cast<uint32_t>(val_));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putLong (int64_t val_) {
+    element();
+
+    if (val_ >= INT8_MIN && val_ <= INT8_MAX) {
+        u8 (0x55);
+        u8 (static_cast<uint8_t>(val_));
+    } else {
+        u8 (0x81);
+        u64 (static_cast<uint64_t>(val_));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUint (uint32_t val_) {
+    element();
+
+    if (val_ == 0) {
+        u8 (0x43);
+    } else if (val_ <= UINT8_MAX) {
+        u8 (0x52);
+        u8 (static_cast<uint8_t>(val_));
+    } else {
+        u8 (0x70);
+        u32 (val_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUlong (uint64_t val_) {
+    element();
+
+    if (val_ == 0) {
+        u8 (0x44);
+    } else if (val_ <= UINT8_MAX) {
+        u8 (0x53);
+        u8 (static_cast<uint8_t>(val_));
+    } else {
+        u8 (0x80);
+        u64 (val_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDouble (double val_) {
+    element();
+
+    uint64_t bits;
+    std::memcpy (&bits, &val_, sizeof (bits));
+
+    u8 (0x82);
+    u64 (bits);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::bytes (uint8_t narrow_, uint8_t wide_, std::string_view val_) {
+    if (val_.size() <= UINT8_MAX) {
+        u8 (narrow_);
+        u8 (static_cast<uint8_t>(val_.size()));
+    } else if (val_.size() <= UINT32_MAX) {
+        u8 (wide_);
+        u32 (static_cast<uint32_t>(val_.size()));
+    } else {
+        throw std::length_error ("Value too large to encode");
+    }
+
+    m_buffer.append (val_.data(), val_.size());
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putString (std::string_view val_) {
+    element();
+    bytes (0xa1, 0xb1, val_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putSymbol (std::string_view val_) {
+    element();
+    bytes (0xa3, 0xb3, val_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putByte (int8_t val_) {
+    element();
+    u8 (0x51);
+    u8 (static_cast<uint8_t>(val_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putShort (int16_t val_) {
+    element();
+    u8 (0x61);
+    u8 (static_cast<uint8_t>(static_cast<uint16_t>(val_) >> 8));
+    u8 (static_cast<uint8_t>(val_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putChar (char32_t val_) {
+    element();
+    u8 (0x73);
+    u32 (static_cast<uint32_t>(val_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putFloat (float val_) {
+    element();
+
+    uint32_t bits;
+    std::memcpy (&bits, &val_, sizeof (bits));
+
+    u8 (0x72);
+    u32 (bits);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putBinary (std::string_view val_) {
+    element();
+    bytes (0xa0, 0xb0, val_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putTimestamp (int64_t val_) {
+    element();
+    u8 (0x83);
+    u64 (static_cast<uint64_t>(val_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUuid (const std::array<uint8_t, 16> & val_) {
+    element();
+    u8 (0x98);
+
+    for (auto byte : val_) {
+        u8 (byte);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDecimal32 (uint32_t val_) {
+    element();
+    u8 (0x74);
+    u32 (val_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDecimal64 (uint64_t val_) {
+    element();
+    u8 (0x84);
+    u64 (val_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDecimal128 (uint64_t high_, uint64_t low_) {
+    element();
+    u8 (0x94);
+    u64 (high_);
+    u64 (low_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDescriptor (uint64_t descriptor_) {
+    element();
+
+    u8 (0x00);
+    u8 (0x80);
+    u64 (descriptor_);
+
+    m_described = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDescriptor (std::string_view descriptor_) {
+    element();
+
+    u8 (0x00);
+    bytes (0xa3, 0xb3, descriptor_);
+
+    m_described = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::open (uint8_t code_) {
+    element();
+
+    m_frames.push_back (Frame { m_buffer.size(), 0, code_ });
+
+    u8 (code_);
+    u32 (0);
+    u32 (0);
+}
+
+/******************************************************************************/
+
+/**
+ * [code_] being the compact form of whatever we opened, an empty list
+ * has a form of its own
+ */
+void
+amqp::internal::encoder::
+Encoder::close (uint8_t code_) {
+    if (m_frames.empty() || m_frames.back().m_code != code_ + 0x10) {
+        throw std::logic_error ("Closing a compound that isn't open");
+    }
+
+    auto frame = m_frames.back();
+    m_frames.pop_back();
+
+    auto * start = &m_buffer[frame.m_start];
+    const size_t contents = m_buffer.size() - frame.m_start - WIDE;
+
+    if (frame.m_count == 0 && code_ == 0xc0) {
+        start[0] = static_cast<char>(0x45);
+        m_buffer.resize (frame.m_start + 1);
+    } else if (contents + 1 <= UINT8_MAX && frame.m_count <= UINT8_MAX) {
+        std::memmove (start + COMPACT, start + WIDE, contents);
+
+        start[0] = static_cast<char>(code_);
+        start[1] = static_cast<char>(contents + 1);
+        start[2] = static_cast<char>(frame.m_count);
+
+        m_buffer.resize (frame.m_start + COMPACT + contents);
+    } else {
+        // the size covers the count as well as the contents
+        const auto size = static_cast<uint32_t>(contents + 4);
+
+        for (int i { 0 } ; i < 4 ; ++i) {
+            start[1 + i] = static_cast<char>(size >> (24 - 8 * i));
+            start[5 + i] = static_cast<char>(frame.m_count >> (24 - 8 * i));
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::beginList() {
+    open (0xd0);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::endList() {
+    close (0xc0);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::beginMap() {
+    open (0xd1);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::endMap() {
+    close (0xc1);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putEncoded (std::string_view val_) {
+    element();
+
+    m_buffer.append (val_.data(), val_.size());
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::reset() {
+    m_frames.clear();
+    m_described = false;
+}
+
+/******************************************************************************/
@@ -0,0 +1,134 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    /**
+     * Writes AMQP 1.0 encoded values onto the end of a buffer it doesn't
+     * own, the mirror image of decoder::Cursor.
+     *
+     * Lists and maps are opened, written into and closed. Their size
+     * isn't known until they're closed so space for the widest header is
+     * left when they're opened and filled in afterwards, any that turn
+     * out small enough being shuffled down into the compact form. That
+     * only ever moves fewer than 256 bytes so costs no more than having
+     * sized them up front, and nothing but the buffer itself is ever
+     * allocated, the stack of open compounds aside, which we keep.
+     *
+     * Integers are written in the smallest form that holds them,
+     * descriptors always as a full ulong as the JVM writes them.
+     */
+    class Encoder {
+        private :
+            struct Frame {
+                /**
+                 * Offset of the constructor, the size and count follow
+                 */
+                size_t m_start;
+                uint32_t m_count;
+                uint8_t m_code;
+            };
+
+            std::string & m_buffer;
+
+            std::vector<Frame> m_frames;
+
+            /**
+             * Set between a descriptor and the value it describes, which
+             * together are one element of whatever holds them
+             */
+            bool m_described;
+
+            void element();
+            void open (uint8_t);
+            void close (uint8_t);
+
+            void u8 (uint8_t);
+            void u32 (uint32_t);
+            void u64 (uint64_t);
+
+            /**
+             * A string, symbol or binary less the element count
+             */
+            void bytes (uint8_t, uint8_t, std::string_view);
+
+        public :
+            explicit Encoder (std::string &);
+
+            Encoder (const Encoder &) = delete;
+
+            void putNull();
+            void putBool (bool);
+            void putInt (int32_t);
+            void putLong (int64_t);
+            void putUint (uint32_t);
+            void putUlong (uint64_t);
+            void putDouble (double);
+            void putString (std::string_view);
+            void putSymbol (std::string_view);
+            void putByte (int8_t);
+            void putShort (int16_t);
+            void putChar (char32_t);
+            void putFloat (float);
+            void putBinary (std::string_view);
+
+            /**
+             * Milliseconds since the Unix epoch
+             */
+            void putTimestamp (int64_t);
+
+            void putUuid (const std::array<uint8_t, 16> &);
+
+            /**
+             * The bits of an IEEE 754 decimal, the high 64 of a
+             * decimal128 first
+             */
+            void putDecimal32 (uint32_t);
+            void putDecimal64 (uint64_t);
+            void putDecimal128 (uint64_t, uint64_t);
+
+            /**
+             * Follow with the described value
+             */
+            void putDescriptor (uint64_t);
+            void putDescriptor (std::string_view);
+
+            void beginList();
+            void endList();
+
+            /**
+             * Keys and values are written alternately
+             */
+            void beginMap();
+            void endMap();
+
+            /**
+             * Copy in a single value that's already been encoded
+             */
+            void putEncoded (std::string_view);
+
+            /**
+             * Forget anything left open by a value abandoned part way
+             * through, what it wrote to the buffer is the caller's to
+             * clear
+             */
+            void reset();
+
+            /**
+             * How many lists and maps are still open
+             */
+            size_t depth() const { return m_frames.size(); }
+    };
+
+}
+
+/******************************************************************************/
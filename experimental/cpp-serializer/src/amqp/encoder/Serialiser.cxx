@@ -0,0 +1,97 @@
+#include "serialiser/Serialiser.h"
+
+#include <cassert>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace descriptors = amqp::schema::descriptors;
+
+    constexpr uint64_t
+    described (int id_) {
+        return descriptors::DESCRIPTOR_TOP_32BITS | static_cast<uint64_t>(id_);
+    }
+
+}
+
+/******************************************************************************/
+
+serialiser::
+Serialiser::Serialiser (size_t capacity_)
+    : m_encoder (m_buffer)
+{
+    m_buffer.reserve (capacity_);
+}
+
+/******************************************************************************/
+
+/**
+ * The schema for the type rooted at [type_], encoded by [describe_]
+ * the first time we see it
+ */
+const std::string &
+serialiser::
+Serialiser::schema (
+    const std::type_index & type_,
+    void (* describe_)(amqp::internal::encoder::TypeSet &)
+) {
+    auto it = m_schemas.find (type_);
+
+    if (it == m_schemas.end()) {
+        amqp::internal::encoder::TypeSet types;
+        describe_ (types);
+
+        std::string bytes;
+        amqp::internal::encoder::Encoder encoder (bytes);
+        types.encode (encoder);
+
+        it = m_schemas.emplace (type_, std::move (bytes)).first;
+    }
+
+    return it->second;
+}
+
+/******************************************************************************/
+
+/**
+ * The Corda header, an uncompressed section, and into the envelope ready
+ * for the payload
+ */
+void
+serialiser::
+Serialiser::begin() {
+    m_buffer.clear();
+    m_encoder.reset();
+
+    m_buffer.append (amqp::AMQP_HEADER.data(), amqp::AMQP_HEADER.size());
+    m_buffer.push_back (static_cast<char>(amqp::DATA_AND_STOP));
+
+    m_encoder.putDescriptor (described (descriptors::ENVELOPE));
+    m_encoder.beginList();
+}
+
+/******************************************************************************/
+
+/**
+ * After the payload come the schema and an empty set of transforms
+ */
+void
+serialiser::
+Serialiser::end (const std::string & schema_) {
+    m_encoder.putEncoded (schema_);
+
+    m_encoder.putDescriptor (described (descriptors::TRANSFORM_SCHEMA));
+    m_encoder.beginMap();
+    m_encoder.endMap();
+
+    m_encoder.endList();
+
+    assert (m_encoder.depth() == 0);
+}
+
+/******************************************************************************/
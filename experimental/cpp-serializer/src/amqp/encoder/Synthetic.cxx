@@ -0,0 +1,213 @@
+#include "Synthetic.h"
+
+#include <random>
+#include <stdexcept>
+
+#include "Encoder.h"
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace descriptors = amqp::schema::descriptors;
+
+    const std::string PACKAGE { "net.corda.synthetic." }; // NOLINT
+
+    constexpr const char * SCALARS[] = { "int", "long", "boolean", "double", "string" };
+
+    /**
+     * Printable, so a generated blob dumps as readable JSON
+     */
+    const std::string ALPHABET { // NOLINT
+            "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789" };
+
+    amqp::internal::encoder::TypeNotation
+    restricted (std::string name_, const char * source_) {
+        amqp::internal::encoder::TypeNotation rtn { std::move (name_), "", source_, { } };
+        rtn.m_descriptor = amqp::internal::encoder::fingerprint (rtn);
+        return rtn;
+    }
+
+    template<class Random>
+    void
+    putString (amqp::internal::encoder::Encoder & e_, size_t size_, Random & random_) {
+        std::string value (size_, ' ');
+
+        for (auto & c : value) {
+            c = ALPHABET[random_() % ALPHABET.size()];
+        }
+
+        e_.putString (value);
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::encoder::
+Synthetic::Synthetic (const Shape & shape_)
+    : m_shape (shape_)
+    , m_list (restricted ("java.util.List<int>", "list"))
+    , m_map (restricted ("java.util.Map<string, int>", "map"))
+    , m_array (restricted ("java.lang.Integer[]", "list"))
+{
+    if (m_shape.m_depth == 0) {
+        throw std::runtime_error ("A synthetic blob needs a depth of at least 1");
+    }
+
+    m_enum = TypeNotation { PACKAGE + "Choice", "", "list", { } };
+    for (size_t i { 0 } ; i < m_shape.m_choices ; ++i) {
+        m_enum.m_choices.push_back ("C" + std::to_string (i));
+    }
+    m_enum.m_descriptor = fingerprint (m_enum);
+
+    m_composites.reserve (m_shape.m_depth + m_shape.m_types);
+
+    for (size_t level { 0 } ; level < m_shape.m_depth ; ++level) {
+        TypeNotation type { PACKAGE + "Level" + std::to_string (level), "", "", { } };
+
+        for (size_t i { 0 } ; i < m_shape.m_fields ; ++i) {
+            type.m_fields.push_back ({ "f" + std::to_string (i), SCALARS[i % 5], "" });
+        }
+
+        if (m_shape.m_list) type.m_fields.push_back ({ "list", "*", m_list.m_name });
+        if (m_shape.m_map) type.m_fields.push_back ({ "map", "*", m_map.m_name });
+        if (m_shape.m_array) type.m_fields.push_back ({ "array", "int[]", "" });
+        if (m_shape.m_choices) type.m_fields.push_back ({ "choice", m_enum.m_name, "" });
+
+        if (level > 0) {
+            type.m_fields.push_back ({ "next", m_composites.back().m_name, "" });
+        }
+
+        type.m_descriptor = fingerprint (type);
+        m_composites.push_back (std::move (type));
+    }
+
+    for (auto & type : m_composites) {
+        m_types.add (type);
+    }
+
+    if (m_shape.m_list) m_types.add (m_list);
+    if (m_shape.m_map) m_types.add (m_map);
+    if (m_shape.m_array) m_types.add (m_array);
+    if (m_shape.m_choices) m_types.add (m_enum);
+
+    for (size_t i { 0 } ; m_types.size() < m_shape.m_types ; ++i) {
+        TypeNotation type {
+                PACKAGE + "Unused" + std::to_string (i), "", "",
+                { { "a", "int", "" } } };
+
+        type.m_descriptor = fingerprint (type);
+        m_composites.push_back (std::move (type));
+        m_types.add (m_composites.back());
+    }
+}
+
+/******************************************************************************/
+
+template<class Random>
+void
+amqp::internal::encoder::
+Synthetic::write (Encoder & e_, size_t level_, Random & random_) const {
+    e_.putDescriptor (m_composites[level_].m_descriptor);
+    e_.beginList();
+
+    for (size_t i { 0 } ; i < m_shape.m_fields ; ++i) {
+        switch (i % 5) {
+            case 0 : e_.putInt (static_cast<int32_t>(random_())); break;
+            case 1 : e_.putLong (static_cast<int64_t>(random_())); break;
+            case 2 : e_.putBool (random_() & 1u); break;
+            case 3 : e_.putDouble (static_cast<double>(random_() % 1000000) / 1000); break;
+            case 4 : putString (e_, m_shape.m_string, random_); break;
+        }
+    }
+
+    if (m_shape.m_list) {
+        e_.putDescriptor (m_list.m_descriptor);
+        e_.beginList();
+        for (size_t i { 0 } ; i < m_shape.m_list ; ++i) {
+            e_.putInt (static_cast<int32_t>(random_()));
+        }
+        e_.endList();
+    }
+
+    if (m_shape.m_map) {
+        e_.putDescriptor (m_map.m_descriptor);
+        e_.beginMap();
+        for (size_t i { 0 } ; i < m_shape.m_map ; ++i) {
+            // keys have to be unique, the index keeps them so
+            e_.putString ("k" + std::to_string (i));
+            e_.putInt (static_cast<int32_t>(random_()));
+        }
+        e_.endMap();
+    }
+
+    if (m_shape.m_array) {
+        e_.putDescriptor (m_array.m_descriptor);
+        e_.beginList();
+        for (size_t i { 0 } ; i < m_shape.m_array ; ++i) {
+            e_.putInt (static_cast<int32_t>(random_()));
+        }
+        e_.endList();
+    }
+
+    if (m_shape.m_choices) {
+        const auto ordinal = random_() % m_shape.m_choices;
+
+        e_.putDescriptor (m_enum.m_descriptor);
+        e_.beginList();
+        e_.putString (m_enum.m_choices[ordinal]);
+        e_.putInt (static_cast<int32_t>(ordinal));
+        e_.endList();
+    }
+
+    if (level_ > 0) {
+        write (e_, level_ - 1, random_);
+    }
+
+    e_.endList();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Synthetic::write (std::string & out_, uint64_t seed_) const {
+    std::mt19937_64 random (seed_);
+
+    out_.append (amqp::AMQP_HEADER.data(), amqp::AMQP_HEADER.size());
+    out_.push_back (static_cast<char>(amqp::DATA_AND_STOP));
+
+    Encoder e (out_);
+
+    e.putDescriptor (descriptors::DESCRIPTOR_TOP_32BITS | descriptors::ENVELOPE);
+    e.beginList();
+
+    write (e, m_shape.m_depth - 1, random);
+
+    m_types.encode (e);
+
+    e.putDescriptor (descriptors::DESCRIPTOR_TOP_32BITS | descriptors::TRANSFORM_SCHEMA);
+    e.beginMap();
+    e.endMap();
+
+    e.endList();
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::encoder::
+Synthetic::blob (uint64_t seed_) const {
+    std::string rtn;
+
+    write (rtn, seed_);
+
+    return rtn;
+}
+
+/******************************************************************************/
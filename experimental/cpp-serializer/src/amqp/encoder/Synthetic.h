@@ -0,0 +1,92 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "TypeSet.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    class Encoder;
+
+    /**
+     * What a synthetic blob looks like. Its payload is [depth] nested
+     * composites, each holding
+     *
+     *   [fields] scalars, ints, longs, bools, doubles and strings in turn
+     *   a list of [list] ints, if any
+     *   a map of [map] strings to ints, if any
+     *   an array of [array] ints, if any
+     *   an enum of [choices] constants, if any
+     *   the next composite in, but for the innermost
+     *
+     * Its schema describes those and then, should that come to fewer than
+     * [types] types, enough unused composites to make up the difference.
+     */
+    struct Shape {
+        size_t m_fields { 4 };
+        size_t m_depth { 1 };
+        size_t m_list { 0 };
+        size_t m_map { 0 };
+        size_t m_array { 0 };
+        size_t m_choices { 0 };
+        size_t m_types { 0 };
+
+        /**
+         * Length of every string value
+         */
+        size_t m_string { 8 };
+    };
+
+    /**
+     * Writes Corda blobs to a given shape, header, payload and schema, as
+     * the JVM would lay them out. The types are worked out once, the values
+     * are drawn afresh for each blob from the seed it's asked for with, so
+     * a corpus is reproducible from the shape and a starting seed.
+     */
+    class Synthetic {
+        private :
+            Shape m_shape;
+
+            TypeNotation m_list;
+            TypeNotation m_map;
+            TypeNotation m_array;
+            TypeNotation m_enum;
+
+            /**
+             * Innermost first, then the padding. Held still as the type
+             * set points into it
+             */
+            std::vector<TypeNotation> m_composites;
+
+            TypeSet m_types;
+
+            template<class Random>
+            void write (Encoder &, size_t, Random &) const;
+
+        public :
+            explicit Synthetic (const Shape &);
+
+            Synthetic (const Synthetic &) = delete;
+            Synthetic & operator = (const Synthetic &) = delete;
+
+            /**
+             * Append a blob, values drawn from [seed_], to [out_]
+             */
+            void write (std::string & out_, uint64_t seed_) const;
+
+            std::string blob (uint64_t seed_) const;
+
+            const Shape & shape() const { return m_shape; }
+
+            size_t types() const { return m_types.size(); }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,319 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <cstdint>
+#include <type_traits>
+
+#include "Encoder.h"
+#include "TypeSet.h"
+#include "decoder/Scalars.h"
+
+/******************************************************************************/
+
+namespace serialiser {
+
+    template<class T>
+    struct Class;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    /**
+     * How a C++ type is named in the schema, what it adds to the schema
+     * and how it's written:
+     *
+     *   name()         what fields holding one give as their type
+     *   restricted     whether those fields name it through requires
+     *   describe(set)  add it, and whatever it uses, to a blob's schema
+     *   write(enc, v)  encode a value
+     *
+     * The primitives Corda knows about map onto their fixed width C++
+     * equivalents, or the decoder's types for those with none, a byte[]
+     * onto a vector of std::byte, other vectors onto java.util.List, maps and vectors of pairs
+     * onto java.util.Map, and anything with a serialiser::Class
+     * specialisation onto the class it names.
+     */
+    template<class T, class = void>
+    struct Type;
+
+    template<class M>
+    FieldNotation
+    fieldNotation (const char * name_) {
+        if constexpr (Type<M>::restricted) {
+            return { name_, "*", Type<M>::name() };
+        } else {
+            return { name_, Type<M>::name(), "" };
+        }
+    }
+
+    /**
+     * Shared by the primitives which need no schema of their own
+     */
+    struct Primitive {
+        static constexpr bool restricted = false;
+
+        static void describe (TypeSet &) { }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Primitives
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    template<>
+    struct Type<int32_t> : Primitive {
+        static std::string name() { return "int"; }
+        static void write (Encoder & e_, int32_t v_) { e_.putInt (v_); }
+    };
+
+    template<>
+    struct Type<int64_t> : Primitive {
+        static std::string name() { return "long"; }
+        static void write (Encoder & e_, int64_t v_) { e_.putLong (v_); }
+    };
+
+    template<>
+    struct Type<bool> : Primitive {
+        static std::string name() { return "boolean"; }
+        static void write (Encoder & e_, bool v_) { e_.putBool (v_); }
+    };
+
+    template<>
+    struct Type<double> : Primitive {
+        static std::string name() { return "double"; }
+        static void write (Encoder & e_, double v_) { e_.putDouble (v_); }
+    };
+
+    template<>
+    struct Type<std::string> : Primitive {
+        static std::string name() { return "string"; }
+        static void write (Encoder & e_, const std::string & v_) { e_.putString (v_); }
+    };
+
+    template<>
+    struct Type<int8_t> : Primitive {
+        static std::string name() { return "byte"; }
+        static void write (Encoder & e_, int8_t v_) { e_.putByte (v_); }
+    };
+
+    template<>
+    struct Type<int16_t> : Primitive {
+        static std::string name() { return "short"; }
+        static void write (Encoder & e_, int16_t v_) { e_.putShort (v_); }
+    };
+
+    template<>
+    struct Type<char32_t> : Primitive {
+        static std::string name() { return "char"; }
+        static void write (Encoder & e_, char32_t v_) { e_.putChar (v_); }
+    };
+
+    template<>
+    struct Type<float> : Primitive {
+        static std::string name() { return "float"; }
+        static void write (Encoder & e_, float v_) { e_.putFloat (v_); }
+    };
+
+    template<>
+    struct Type<decoder::Timestamp> : Primitive {
+        static std::string name() { return "timestamp"; }
+        static void write (Encoder & e_, decoder::Timestamp v_) {
+            e_.putTimestamp (v_.time_since_epoch().count());
+        }
+    };
+
+    template<>
+    struct Type<decoder::Uuid> : Primitive {
+        static std::string name() { return "uuid"; }
+        static void write (Encoder & e_, const decoder::Uuid & v_) { e_.putUuid (v_.m_bytes); }
+    };
+
+    /**
+     * Written at whatever width it was read as, named as the widest
+     * since the readers take any of them for any other
+     */
+    template<>
+    struct Type<decoder::Decimal> : Primitive {
+        static std::string name() { return "decimal128"; }
+        static void write (Encoder & e_, const decoder::Decimal & v_) {
+            switch (v_.m_type) {
+                case decoder::Type::decimal32_t :
+                    e_.putDecimal32 (static_cast<uint32_t>(v_.m_low));
+                    break;
+                case decoder::Type::decimal64_t :
+                    e_.putDecimal64 (v_.m_low);
+                    break;
+                case decoder::Type::decimal128_t :
+                    e_.putDecimal128 (v_.m_high, v_.m_low);
+                    break;
+                default :
+                    e_.putNull();
+            }
+        }
+    };
+
+    template<>
+    struct Type<std::vector<std::byte>> : Primitive {
+        static std::string name() { return "binary"; }
+        static void write (Encoder & e_, const std::vector<std::byte> & v_) {
+            e_.putBinary ({ reinterpret_cast<const char *>(v_.data()), v_.size() });
+        }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Restricted types
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    /**
+     * [Derived] gives us its name, the source it's restricted from and
+     * the element types it holds
+     */
+    template<class Derived, class ... Elements>
+    struct Restricted {
+        static constexpr bool restricted = true;
+
+        static const TypeNotation & notation() {
+            static const TypeNotation notation = [] {
+                TypeNotation rtn { Derived::name(), "", Derived::source, { } };
+                rtn.m_descriptor = fingerprint (rtn);
+                return rtn;
+            }();
+
+            return notation;
+        }
+
+        static void describe (TypeSet & set_) {
+            if (set_.add (notation())) {
+                (Type<Elements>::describe (set_), ...);
+            }
+        }
+    };
+
+    template<class T>
+    struct Type<std::vector<T>> : Restricted<Type<std::vector<T>>, T> {
+        static constexpr const char * source = "list";
+
+        static std::string name() {
+            return "java.util.List<" + Type<T>::name() + ">";
+        }
+
+        static void write (Encoder & e_, const std::vector<T> & v_) {
+            e_.putDescriptor (Type::notation().m_descriptor);
+            e_.beginList();
+            for (const auto & element : v_) {
+                Type<T>::write (e_, element);
+            }
+            e_.endList();
+        }
+    };
+
+    /**
+     * Entries are written in the order they're held, so a map read back
+     * as a vector of pairs is written exactly as it was read
+     */
+    template<class K, class V, class Container>
+    struct MapType : Restricted<Type<Container>, K, V> {
+        static constexpr const char * source = "map";
+
+        static std::string name() {
+            return "java.util.Map<" + Type<K>::name() + ", " + Type<V>::name() + ">";
+        }
+
+        static void write (Encoder & e_, const Container & v_) {
+            e_.putDescriptor (MapType::notation().m_descriptor);
+            e_.beginMap();
+            for (const auto & entry : v_) {
+                Type<K>::write (e_, entry.first);
+                Type<V>::write (e_, entry.second);
+            }
+            e_.endMap();
+        }
+    };
+
+    template<class K, class V>
+    struct Type<std::map<K, V>> : MapType<K, V, std::map<K, V>> { };
+
+    template<class K, class V>
+    struct Type<std::vector<std::pair<K, V>>>
+        : MapType<K, V, std::vector<std::pair<K, V>>> { };
+
+}
+
+/******************************************************************************
+ *
+ * Composites
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    template<class T>
+    struct Type<T, std::void_t<decltype (serialiser::Class<T>::name)>> {
+        static constexpr bool restricted = false;
+
+        using Class = serialiser::Class<T>;
+
+        static std::string name() { return Class::name; }
+
+        static const TypeNotation & notation() {
+            static const TypeNotation notation = [] {
+                TypeNotation rtn { name(), "", "", { } };
+
+                std::apply ([&rtn](const auto & ... fields_) {
+                    (rtn.m_fields.push_back (
+                        fieldNotation<typename std::decay_t<decltype (fields_)>::type> (
+                            fields_.m_name)), ...);
+                }, Class::fields);
+
+                rtn.m_descriptor = fingerprint (rtn);
+                return rtn;
+            }();
+
+            return notation;
+        }
+
+        static void describe (TypeSet & set_) {
+            if (set_.add (notation())) {
+                std::apply ([&set_](const auto & ... fields_) {
+                    (Type<typename std::decay_t<decltype (fields_)>::type>::describe (set_), ...);
+                }, Class::fields);
+            }
+        }
+
+        static void write (Encoder & e_, const T & v_) {
+            e_.putDescriptor (notation().m_descriptor);
+            e_.beginList();
+
+            std::apply ([&e_, &v_](const auto & ... fields_) {
+                (Type<typename std::decay_t<decltype (fields_)>::type>::write (
+                    e_, v_.*(fields_.m_member)), ...);
+            }, Class::fields);
+
+            e_.endList();
+        }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,225 @@
+#include "TypeSet.h"
+
+#include <array>
+#include <cstdint>
+
+#include "Encoder.h"
+
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace descriptors = amqp::schema::descriptors;
+
+    /**
+     * FNV-1a over everything in the notation, run twice from different
+     * starting points to get 128 bits. Field boundaries are marked so
+     * moving a character from one to the next changes the result.
+     */
+    class Hash {
+        private :
+            std::array<uint64_t, 2> m_state {
+                { 0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL }
+            };
+
+        public :
+            Hash & operator << (const std::string & str_) {
+                for (auto & h : m_state) {
+                    for (auto c : str_) {
+                        h ^= static_cast<uint8_t>(c);
+                        h *= 0x100000001b3ULL;
+                    }
+
+                    h ^= 0xff;
+                    h *= 0x100000001b3ULL;
+                }
+
+                return *this;
+            }
+
+            std::array<uint8_t, 16> bytes() const {
+                std::array<uint8_t, 16> rtn { };
+
+                for (size_t i { 0 } ; i < rtn.size() ; ++i) {
+                    rtn[i] = static_cast<uint8_t>(m_state[i / 8] >> (56 - 8 * (i % 8)));
+                }
+
+                return rtn;
+            }
+    };
+
+    std::string
+    base64 (const std::array<uint8_t, 16> & bytes_) {
+        static const char alphabet[] =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string rtn;
+
+        for (size_t i { 0 } ; i < bytes_.size() ; i += 3) {
+            uint32_t chunk = bytes_[i] << 16u;
+            size_t n { 1 };
+
+            if (i + 1 < bytes_.size()) { chunk |= bytes_[i + 1] << 8u; ++n; }
+            if (i + 2 < bytes_.size()) { chunk |= bytes_[i + 2]; ++n; }
+
+            for (size_t j { 0 } ; j < 4 ; ++j) {
+                rtn += j <= n ? alphabet[(chunk >> (18 - 6 * j)) & 0x3f] : '=';
+            }
+        }
+
+        return rtn;
+    }
+
+    constexpr uint64_t
+    described (int id_) {
+        return descriptors::DESCRIPTOR_TOP_32BITS | static_cast<uint64_t>(id_);
+    }
+
+    /**
+     * Described by OBJECT, the symbol and a null we've no use for
+     */
+    void
+    descriptor (
+        amqp::internal::encoder::Encoder & encoder_,
+        const std::string & descriptor_
+    ) {
+        encoder_.putDescriptor (described (descriptors::OBJECT));
+        encoder_.beginList();
+        encoder_.putSymbol (descriptor_);
+        encoder_.putNull();
+        encoder_.endList();
+    }
+
+    void
+    field (
+        amqp::internal::encoder::Encoder & encoder_,
+        const amqp::internal::encoder::FieldNotation & field_
+    ) {
+        encoder_.putDescriptor (described (descriptors::FIELD));
+        encoder_.beginList();
+
+        encoder_.putString (field_.m_name);
+        encoder_.putString (field_.m_type);
+
+        encoder_.beginList();
+        if (!field_.m_requires.empty()) {
+            encoder_.putString (field_.m_requires);
+        }
+        encoder_.endList();
+
+        encoder_.putNull();      // default
+        encoder_.putNull();      // label
+        encoder_.putBool (true); // mandatory
+        encoder_.putBool (false);// multiple
+
+        encoder_.endList();
+    }
+
+    /**
+     * An enum constant by name and ordinal, the latter as a string
+     */
+    void
+    choice (
+        amqp::internal::encoder::Encoder & encoder_,
+        const std::string & name_,
+        size_t ordinal_
+    ) {
+        encoder_.putDescriptor (described (descriptors::CHOICE));
+        encoder_.beginList();
+        encoder_.putString (name_);
+        encoder_.putString (std::to_string (ordinal_));
+        encoder_.endList();
+    }
+
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::encoder::
+fingerprint (const TypeNotation & type_) {
+    Hash hash;
+
+    hash << type_.m_name << type_.m_source;
+
+    for (const auto & field : type_.m_fields) {
+        hash << field.m_name << field.m_type << field.m_requires;
+    }
+
+    for (const auto & choice : type_.m_choices) {
+        hash << choice;
+    }
+
+    return "net.corda:" + base64 (hash.bytes());
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::encoder::
+TypeSet::add (const TypeNotation & type_) {
+    if (!m_names.insert (type_.m_name).second) {
+        return false;
+    }
+
+    m_types.push_back (&type_);
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Laid out as the JVM lays it out, a list holding a list of composite
+ * and restricted types each described by their own descriptor
+ */
+void
+amqp::internal::encoder::
+TypeSet::encode (Encoder & encoder_) const {
+    encoder_.putDescriptor (described (descriptors::SCHEMA));
+    encoder_.beginList();
+    encoder_.beginList();
+
+    for (const auto * type : m_types) {
+        const bool composite = type->m_source.empty();
+
+        encoder_.putDescriptor (described (
+                composite ? descriptors::COMPOSITE_TYPE
+                          : descriptors::RESTRICTED_TYPE));
+        encoder_.beginList();
+
+        encoder_.putString (type->m_name);
+        encoder_.putNull();      // label
+        encoder_.beginList();    // provides
+        encoder_.endList();
+
+        if (composite) {
+            descriptor (encoder_, type->m_descriptor);
+
+            encoder_.beginList();
+            for (const auto & f : type->m_fields) {
+                field (encoder_, f);
+            }
+            encoder_.endList();
+        } else {
+            encoder_.putString (type->m_source);
+
+            descriptor (encoder_, type->m_descriptor);
+
+            encoder_.beginList(); // choices
+            for (size_t i { 0 } ; i < type->m_choices.size() ; ++i) {
+                choice (encoder_, type->m_choices[i], i);
+            }
+            encoder_.endList();
+        }
+
+        encoder_.endList();
+    }
+
+    encoder_.endList();
+    encoder_.endList();
+}
+
+/******************************************************************************/
@@ -0,0 +1,83 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <set>
+#include <string>
+#include <vector>
+
+/******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    class Encoder;
+
+    struct FieldNotation {
+        std::string m_name;
+
+        /**
+         * The type of the field or, for lists and maps, "*" with the
+         * restricted type it actually holds in m_requires
+         */
+        std::string m_type;
+        std::string m_requires;
+    };
+
+    /**
+     * What the schema says about one of the types we're writing
+     */
+    struct TypeNotation {
+        std::string m_name;
+        std::string m_descriptor;
+
+        /**
+         * "list" or "map" for a restricted type, empty for a composite
+         */
+        std::string m_source;
+
+        std::vector<FieldNotation> m_fields;
+
+        /**
+         * The constants of an enum, restricted from "list", in ordinal
+         * order
+         */
+        std::vector<std::string> m_choices;
+    };
+
+    /**
+     * @return a descriptor for the type, a base64 encoded 128 bit hash of
+     * everything in its notation.
+     *
+     * This isn't the fingerprint the JVM would compute, that depends on
+     * the Java class rather than anything we can see from here, but like
+     * it two types differing in any way we write them get different
+     * descriptors and the same type always gets the same one.
+     */
+    std::string fingerprint (const TypeNotation &);
+
+    /**
+     * The types in a blob's schema in the order they were found
+     */
+    class TypeSet {
+        private :
+            std::vector<const TypeNotation *> m_types;
+            std::set<std::string> m_names;
+
+        public :
+            /**
+             * @return false if we already had a type of that name,
+             * in which case its dependencies have been added too
+             */
+            bool add (const TypeNotation &);
+
+            size_t size() const { return m_types.size(); }
+
+            /**
+             * Write the whole described schema section
+             */
+            void encode (Encoder &) const;
+    };
+
+}
+
+/******************************************************************************/
@@ -10,6 +10,8 @@
 #include "Reader.h"
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "Profile.h"
 
 /******************************************************************************/
 
@@ -27,10 +29,20 @@ CompositeReader::m_name { // NOLINT
 amqp::internal::reader::
 CompositeReader::CompositeReader (
         std::string type_,
-        sVec<std::weak_ptr<Reader>> & readers_
+        std::string descriptor_,
+        sVec<std::weak_ptr<Reader>> & readers_,
+        sVec<std::string> fieldNames_
 ) : m_readers (readers_)
+  , m_fieldNames (std::move (fieldNames_))
   , m_type (std::move (type_))
+  , m_descriptor (std::move (descriptor_))
 {
+    assert (m_readers.size() == m_fieldNames.size());
+
+    for (size_t i { 0 } ; i < m_fieldNames.size() ; ++i) {
+        m_fieldIndex.emplace (m_fieldNames[i], i);
+    }
+
     DBG ("MAKE CompositeReader: " << m_type << ": " << m_readers.size() << std::endl); // NOLINT
     for (auto const reader : m_readers) {
         assert (reader.lock());
@@ -58,10 +70,29 @@ CompositeReader::type() const  {
 
 /******************************************************************************/
 
-std::any
+size_t
 amqp::internal::reader::
-CompositeReader::read (pn_data_t * data_) const {
-    return std::any(1);
+CompositeReader::fieldIndex (const std::string & name_) const {
+    auto it = m_fieldIndex.find (name_);
+
+    if (it == m_fieldIndex.end()) {
+        throw std::runtime_error (
+                "No field \"" + name_ + "\" in " + m_type);
+    }
+
+    return it->second;
+}
+
+/******************************************************************************/
+
+std::shared_ptr<amqp::internal::reader::Reader>
+amqp::internal::reader::
+CompositeReader::field (size_t index_) const {
+    if (auto reader = m_readers.at (index_).lock()) {
+        return reader;
+    }
+
+    throw std::runtime_error ("null field reader: " + m_fieldNames[index_]);
 }
 
 /******************************************************************************/
@@ -93,8 +124,10 @@ CompositeReader::_dump (
     proton::is_described (data_);
     proton::auto_enter ae (data_);
 
+    // the view is into proton's buffer, good for as long as the probe
+    const auto symbol = proton::get_symbol<pn_bytes_t> (data_);
     const auto & it = schema_.fromDescriptor (
-            proton::get_symbol<std::string>(data_));
+            std::string_view (symbol.start, symbol.size));
 
     auto & fields = dynamic_cast<schema::Composite &> (
             *(it->second.get())).fields();
@@ -162,3 +195,50 @@ CompositeReader::dump (
 
 /******************************************************************************/
 
+
+void
+amqp::internal::reader::
+CompositeReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    if (dereference (*this, cursor_, schema_, visitor_)) {
+        return;
+    }
+
+    auto recorder = Recorder::of (visitor_);
+    auto begun = start (cursor_, recorder);
+
+    decoder::auto_next an (cursor_);
+
+    decoder::is_described (cursor_);
+    decoder::auto_enter ae (cursor_);
+
+    // we already know our fields, provided it's really us
+    decoder::is_descriptor (cursor_, m_descriptor);
+    cursor_.next();
+    decoder::is_list (cursor_);
+
+    visitor_.startObject();
+    {
+        decoder::auto_enter ae2 (cursor_);
+
+        for (size_t i { 0 } ; i < m_readers.size() ; ++i) {
+            if (auto l = m_readers[i].lock()) {
+                visitor_.field (m_fieldNames[i]);
+                l->visit (cursor_, schema_, visitor_);
+            } else {
+                throw std::runtime_error (
+                        "null field reader: " + m_fieldNames[i]);
+            }
+        }
+    }
+    visitor_.endObject();
+
+    remember (cursor_, recorder, begun);
+}
+
+/******************************************************************************/
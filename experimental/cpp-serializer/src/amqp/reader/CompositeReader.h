@@ -4,7 +4,7 @@
 
 #include "Reader.h"
 
-#include <any>
+#include <map>
 #include <vector>
 #include <iostream>
 #include <amqp/schema/described-types/Schema.h>
@@ -17,19 +17,38 @@ namespace amqp::internal::reader {
         private :
             std::vector<std::weak_ptr<Reader>> m_readers;
 
+            /**
+             * Names of the fields the readers above are for, captured from
+             * the schema we were built from so walking a blob doesn't need
+             * to look the type back up
+             */
+            std::vector<std::string> m_fieldNames;
+
+            /**
+             * Position of each field within the encoded list, precomputed
+             * so a projection can go straight to the field it wants
+             */
+            std::map<std::string, size_t> m_fieldIndex;
+
             static const std::string m_name;
 
             std::string m_type;
 
+            /**
+             * What a blob describes values of our type as, checked
+             * against each one we read
+             */
+            std::string m_descriptor;
+
         public :
             CompositeReader (
                 std::string,
-                std::vector<std::weak_ptr<Reader>> &);
+                std::string,
+                std::vector<std::weak_ptr<Reader>> &,
+                std::vector<std::string>);
 
             ~CompositeReader() override = default;
 
-            std::any read (pn_data_t *) const override;
-
             std::string readString (pn_data_t *) const override;
 
             std::unique_ptr<amqp::reader::IValue> dump(
@@ -41,8 +60,20 @@ namespace amqp::internal::reader {
                 pn_data_t *,
                 const SchemaType &) const override;
 
+            void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
             const std::string & name() const override;
             const std::string & type() const override;
+            const std::string & descriptor() const { return m_descriptor; }
+
+            size_t fieldIndex (const std::string &) const;
+            std::shared_ptr<Reader> field (size_t) const;
+
+            size_t fieldCount() const { return m_readers.size(); }
+            const std::string & fieldName (size_t i_) const { return m_fieldNames.at (i_); }
 
         private :
             std::vector<std::unique_ptr<amqp::reader::IValue>> _dump (
@@ -0,0 +1,271 @@
+#include "Json.h"
+
+#include <cmath>
+
+#include "Sink.h"
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr char DIGITS[] = "0123456789abcdef";
+
+    /**
+     * The length of the well formed UTF-8 sequence [bytes_] starts
+     * with, 0 if it doesn't start with one. The ranges are those of
+     * table 3-7 of the Unicode standard, the second byte's range
+     * depending on the first.
+     */
+    size_t
+    sequence (const uint8_t * bytes_, size_t size_) {
+        const auto lead = bytes_[0];
+
+        if (lead < 0x80) return 1;
+
+        size_t length;
+        uint8_t low { 0x80 };
+        uint8_t high { 0xbf };
+
+        if (lead >= 0xc2 && lead <= 0xdf) {
+            length = 2;
+        } else if (lead >= 0xe0 && lead <= 0xef) {
+            length = 3;
+            if (lead == 0xe0) low = 0xa0;
+            if (lead == 0xed) high = 0x9f;
+        } else if (lead >= 0xf0 && lead <= 0xf4) {
+            length = 4;
+            if (lead == 0xf0) low = 0x90;
+            if (lead == 0xf4) high = 0x8f;
+        } else {
+            return 0;
+        }
+
+        if (size_ < length || bytes_[1] < low || bytes_[1] > high) {
+            return 0;
+        }
+
+        for (size_t i { 2 } ; i < length ; ++i) {
+            if (bytes_[i] < 0x80 || bytes_[i] > 0xbf) {
+                return 0;
+            }
+        }
+
+        return length;
+    }
+
+    /**
+     * How far from [in_] the first byte that isn't printable ASCII, a
+     * quote or a backslash is, or [end_] if there isn't one. Bytes
+     * compare signed so those from 0x80 up are caught with the
+     * controls.
+     */
+    const uint8_t *
+    clean (const uint8_t * in_, const uint8_t * end_) {
+#if defined (__SSE2__)
+        const auto space = _mm_set1_epi8 (0x20);
+        const auto quote = _mm_set1_epi8 ('"');
+        const auto backslash = _mm_set1_epi8 ('\\');
+
+        for ( ; end_ - in_ >= 16 ; in_ += 16) {
+            auto bytes = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_));
+
+            auto mask = _mm_movemask_epi8 (_mm_or_si128 (
+                _mm_cmplt_epi8 (bytes, space),
+                _mm_or_si128 (
+                    _mm_cmpeq_epi8 (bytes, quote),
+                    _mm_cmpeq_epi8 (bytes, backslash))));
+
+            if (mask) {
+                return in_ + __builtin_ctz (static_cast<unsigned>(mask));
+            }
+        }
+#endif
+
+        for ( ; in_ != end_ ; ++in_) {
+            if (*in_ < 0x20 || *in_ >= 0x80 || *in_ == '"' || *in_ == '\\') {
+                break;
+            }
+        }
+
+        return in_;
+    }
+
+    /**
+     * How far from [in_] the first byte that isn't ASCII is
+     */
+    const uint8_t *
+    ascii (const uint8_t * in_, const uint8_t * end_) {
+#if defined (__SSE2__)
+        for ( ; end_ - in_ >= 16 ; in_ += 16) {
+            auto mask = _mm_movemask_epi8 (
+                _mm_loadu_si128 (reinterpret_cast<const __m128i *>(in_)));
+
+            if (mask) {
+                return in_ + __builtin_ctz (static_cast<unsigned>(mask));
+            }
+        }
+#endif
+
+        while (in_ != end_ && *in_ < 0x80) ++in_;
+
+        return in_;
+    }
+
+    void
+    escape (uint8_t char_, amqp::reader::ISink & sink_) {
+        switch (char_) {
+            case '"' : sink_ << "\\\""; return;
+            case '\\' : sink_ << "\\\\"; return;
+            case '\b' : sink_ << "\\b"; return;
+            case '\f' : sink_ << "\\f"; return;
+            case '\n' : sink_ << "\\n"; return;
+            case '\r' : sink_ << "\\r"; return;
+            case '\t' : sink_ << "\\t"; return;
+            default : {
+                const char escaped[] {
+                    '\\', 'u', '0', '0', DIGITS[char_ >> 4], DIGITS[char_ & 0xf] };
+                sink_.write (escaped, sizeof (escaped));
+            }
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * Numbers
+ *
+ ******************************************************************************/
+
+namespace {
+
+    template<class T>
+    size_t
+    real (T value_, char (& buffer_)[amqp::internal::reader::json::NUMBER]) {
+        if (!std::isfinite (value_)) {
+            std::string_view text = std::isnan (value_)
+                ? "\"NaN\""
+                : value_ < 0 ? "\"-Infinity\"" : "\"Infinity\"";
+
+            text.copy (buffer_, text.size());
+
+            return text.size();
+        }
+
+        auto res = std::to_chars (buffer_, buffer_ + sizeof (buffer_), value_);
+        return static_cast<size_t>(res.ptr - buffer_);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * The shortest round trip form of a double is at most 24 chars, a sign,
+ * seventeen digits, a point and a four char exponent
+ */
+size_t
+amqp::internal::reader::json::
+number (double value_, char (& buffer_)[NUMBER]) {
+    return real (value_, buffer_);
+}
+
+/******************************************************************************/
+
+/**
+ * Shortest as a float, so 0.1f is 0.1 where widened to a double it
+ * would be 0.10000000149011612
+ */
+size_t
+amqp::internal::reader::json::
+number (float value_, char (& buffer_)[NUMBER]) {
+    return real (value_, buffer_);
+}
+
+/******************************************************************************
+ *
+ * Strings
+ *
+ ******************************************************************************/
+
+bool
+amqp::internal::reader::json::
+valid (std::string_view bytes_) {
+    auto in = reinterpret_cast<const uint8_t *>(bytes_.data());
+    const auto end = in + bytes_.size();
+
+    while ((in = ascii (in, end)) != end) {
+        auto n = sequence (in, static_cast<size_t>(end - in));
+
+        if (n == 0) {
+            return false;
+        }
+
+        in += n;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * What's clean, printable ASCII and well formed multi byte sequences, is
+ * gathered up and written in one go before whatever interrupts it
+ */
+void
+amqp::internal::reader::json::
+quote (std::string_view value_, amqp::reader::ISink & sink_) {
+    auto in = reinterpret_cast<const uint8_t *>(value_.data());
+    const auto end = in + value_.size();
+    auto run = in;
+
+    auto flush = [&sink_, &run](const uint8_t * to_) {
+        if (to_ != run) {
+            sink_.write (reinterpret_cast<const char *>(run), static_cast<size_t>(to_ - run));
+        }
+    };
+
+    sink_ << "\"";
+
+    while ((in = clean (in, end)) != end) {
+        if (*in >= 0x80) {
+            if (auto n = sequence (in, static_cast<size_t>(end - in))) {
+                in += n;
+                continue;
+            }
+
+            flush (in);
+            sink_ << "\\ufffd";
+        } else {
+            flush (in);
+            escape (*in, sink_);
+        }
+
+        run = ++in;
+    }
+
+    flush (end);
+
+    sink_ << "\"";
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::json::
+quote (std::string_view value_) {
+    std::string rtn;
+    rtn.reserve (value_.size() + 2);
+
+    StringSink sink (rtn);
+    quote (value_, sink);
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,69 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+
+#include "amqp/reader/ISink.h"
+
+/******************************************************************************/
+
+/**
+ * The scalars of our JSON, shared by the visitor and the IValue dump path
+ * so the two write exactly the same text.
+ */
+namespace amqp::internal::reader::json {
+
+    /**
+     * Room for the longest number any of the below write
+     */
+    constexpr size_t NUMBER = 32;
+
+    /**
+     * Integers via std::to_chars and doubles and floats as the shortest
+     * text that reads back as the same value, 0.1 rather than 0.100000,
+     * floats as floats rather than as the double they widen to. JSON has
+     * no NaN or infinities so those are written as the strings Java
+     * gives them. Each returns how many chars it wrote.
+     */
+    template<class T>
+    std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, size_t>
+    number (T value_, char (& buffer_)[NUMBER]) {
+        auto res = std::to_chars (buffer_, buffer_ + NUMBER, value_);
+        return static_cast<size_t>(res.ptr - buffer_);
+    }
+
+    size_t number (double, char (&)[NUMBER]);
+    size_t number (float, char (&)[NUMBER]);
+
+    template<class T>
+    std::string
+    number (T value_) {
+        char buffer[NUMBER];
+        return std::string (buffer, number (value_, buffer));
+    }
+
+    /**
+     * Whether [bytes_] is well formed UTF-8, no overlong forms, no
+     * surrogates and nothing past U+10FFFF
+     */
+    bool valid (std::string_view bytes_);
+
+    /**
+     * [value_] as a JSON string, in quotes with quotes, backslashes and
+     * control characters escaped. Anything that isn't well formed UTF-8
+     * is written a byte at a time as U+FFFD. Runs of clean ASCII are
+     * found sixteen bytes at a time and written to the sink as they are.
+     */
+    void quote (std::string_view value_, amqp::reader::ISink &);
+
+    std::string quote (std::string_view value_);
+
+}
+
+/******************************************************************************/
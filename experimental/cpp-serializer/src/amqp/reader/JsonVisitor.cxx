@@ -0,0 +1,243 @@
+#include "JsonVisitor.h"
+
+#include "Json.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::JsonVisitor
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+JsonVisitor::JsonVisitor (amqp::reader::ISink & sink_)
+    : m_sink (sink_)
+{
+    m_levels.reserve (64);
+}
+
+/******************************************************************************/
+
+/**
+ * Called before anything that produces a value. Object members are
+ * separated when their field is named so there's nothing to do for them
+ * here, list elements are comma separated and map entries alternate
+ * between key and value.
+ */
+void
+amqp::internal::reader::
+JsonVisitor::separate() {
+    if (m_levels.empty()) {
+        return;
+    }
+
+    auto & level = m_levels.back();
+
+    switch (level.m_scope) {
+        case Scope::object_t : {
+            break;
+        }
+        case Scope::list_t : {
+            if (level.m_count++) m_sink << ", ";
+            break;
+        }
+        case Scope::map_t : {
+            if (level.m_count % 2) {
+                m_sink << " : ";
+            } else if (level.m_count) {
+                m_sink << ", ";
+            }
+            ++level.m_count;
+            break;
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::open (Scope scope_, const char * token_) {
+    separate();
+    m_sink << token_;
+    m_levels.push_back ({ scope_, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::close (const char * token_) {
+    m_levels.pop_back();
+    m_sink << token_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::startObject() {
+    open (Scope::object_t, "{ ");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::endObject() {
+    close (" }");
+}
+
+/******************************************************************************/
+
+/**
+ * A field outside of any object is allowed so callers can splice a blob
+ * into an object of their own making
+ */
+void
+amqp::internal::reader::
+JsonVisitor::field (std::string_view name_) {
+    if (!m_levels.empty() && m_levels.back().m_count++) {
+        m_sink << ", ";
+    }
+
+    m_sink << name_ << " : ";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::startList() {
+    open (Scope::list_t, "[ ");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::endList() {
+    close (" ]");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::startMap() {
+    open (Scope::map_t, "{ ");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::endMap() {
+    close (" }");
+}
+
+/******************************************************************************/
+
+/**
+ * Matches std::to_string on a bool as used by the IValue path
+ */
+void
+amqp::internal::reader::
+JsonVisitor::value (bool value_) {
+    separate();
+    m_sink << (value_ ? "1" : "0");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::value (int32_t value_) {
+    separate();
+
+    char buffer[json::NUMBER];
+    m_sink.write (buffer, json::number (value_, buffer));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::value (float value_) {
+    separate();
+
+    char buffer[json::NUMBER];
+    m_sink.write (buffer, json::number (value_, buffer));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::value (int64_t value_) {
+    separate();
+
+    char buffer[json::NUMBER];
+    m_sink.write (buffer, json::number (value_, buffer));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::value (double value_) {
+    separate();
+
+    char buffer[json::NUMBER];
+    m_sink.write (buffer, json::number (value_, buffer));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::value (std::string_view value_) {
+    separate();
+    json::quote (value_, m_sink);
+}
+
+/******************************************************************************/
+
+/**
+ * As hex, in a string, a chunk at a time so nothing is allocated however
+ * large it is
+ */
+void
+amqp::internal::reader::
+JsonVisitor::binary (std::string_view value_) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+
+    separate();
+    m_sink << "\"";
+
+    char buffer[256];
+
+    for (size_t i { 0 } ; i < value_.size() ; ) {
+        size_t n { 0 };
+
+        for ( ; n < sizeof (buffer) && i < value_.size() ; ++i) {
+            auto byte = static_cast<uint8_t>(value_[i]);
+            buffer[n++] = DIGITS[byte >> 4];
+            buffer[n++] = DIGITS[byte & 0xf];
+        }
+
+        m_sink.write (buffer, n);
+    }
+
+    m_sink << "\"";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::enumValue (std::string_view value_) {
+    separate();
+    m_sink << value_;
+}
+
+/******************************************************************************/
@@ -0,0 +1,65 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstdint>
+
+#include "amqp/reader/ISink.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Turns visitor events into the same text the IValue dump path
+     * produces, written straight into a sink. The only allocation is the
+     * nesting stack, which is reserved up front and reused across blobs.
+     */
+    class JsonVisitor : public amqp::reader::IVisitor {
+        private :
+            enum class Scope : uint8_t { object_t, list_t, map_t };
+
+            struct Level {
+                Scope m_scope;
+                uint32_t m_count;
+            };
+
+            amqp::reader::ISink & m_sink;
+
+            std::vector<Level> m_levels;
+
+            void separate();
+            void open (Scope, const char *);
+            void close (const char *);
+
+        public :
+            explicit JsonVisitor (amqp::reader::ISink &);
+
+            void startObject() override;
+            void endObject() override;
+
+            void field (std::string_view) override;
+
+            void startList() override;
+            void endList() override;
+
+            void startMap() override;
+            void endMap() override;
+
+            void value (bool) override;
+            void value (int32_t) override;
+            void value (int64_t) override;
+            void value (double) override;
+            void value (std::string_view) override;
+            void value (float) override;
+
+            void binary (std::string_view) override;
+
+            void enumValue (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,152 @@
+#include "Profile.h"
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+
+#include "decoder/Cursor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Every thread's profile, owned here rather than by the thread so
+     * they outlive the pool threads that filled them
+     */
+    struct Profiles {
+        std::mutex m_lock;
+        std::vector<std::unique_ptr<amqp::internal::reader::Profile>> m_profiles;
+    };
+
+    Profiles &
+    profiles() {
+        static Profiles profiles;
+        return profiles;
+    }
+
+}
+
+/******************************************************************************/
+
+std::atomic<bool>
+amqp::internal::reader::
+Profile::s_enabled { false };
+
+/******************************************************************************/
+
+amqp::internal::reader::Profile &
+amqp::internal::reader::
+Profile::local() {
+    thread_local Profile * profile = [] {
+        auto & all = profiles();
+        std::lock_guard<std::mutex> l (all.m_lock);
+
+        all.m_profiles.emplace_back (std::make_unique<Profile>());
+        return all.m_profiles.back().get();
+    }();
+
+    return *profile;
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::reader::Profile::Entry>
+amqp::internal::reader::
+Profile::report() {
+    std::map<std::string, Entry> merged;
+
+    {
+        auto & all = profiles();
+        std::lock_guard<std::mutex> l (all.m_lock);
+
+        for (const auto & profile : all.m_profiles) {
+            for (const auto & entry : profile->m_entries) {
+                auto & into = merged[entry.second.m_type];
+
+                into.m_type = entry.second.m_type;
+                into.m_calls += entry.second.m_calls;
+                into.m_inclusive += entry.second.m_inclusive;
+                into.m_exclusive += entry.second.m_exclusive;
+                into.m_bytes += entry.second.m_bytes;
+            }
+        }
+    }
+
+    std::vector<Entry> rtn;
+    rtn.reserve (merged.size());
+
+    for (auto & entry : merged) {
+        rtn.emplace_back (std::move (entry.second));
+    }
+
+    std::stable_sort (rtn.begin(), rtn.end(), [](const Entry & lhs_, const Entry & rhs_) {
+        return lhs_.m_exclusive > rhs_.m_exclusive;
+    });
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Profile::reset() {
+    auto & all = profiles();
+    std::lock_guard<std::mutex> l (all.m_lock);
+
+    for (auto & profile : all.m_profiles) {
+        profile->m_entries.clear();
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Profile::Scope
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::reader::
+Profile::Scope::open (const std::string & type_, decoder::Cursor & cursor_) {
+    m_profile = &local();
+    m_parent = m_profile->m_open;
+    m_type = &type_;
+    m_children = std::chrono::nanoseconds::zero();
+    m_bytes = cursor_.raw().size();
+
+    m_profile->m_open = this;
+
+    m_start = std::chrono::steady_clock::now();
+}
+
+/******************************************************************************/
+
+/**
+ * Our time counts against our parent's children, so what's left of its
+ * own is exclusive to it
+ */
+void
+amqp::internal::reader::
+Profile::Scope::close() {
+    const auto elapsed = std::chrono::steady_clock::now() - m_start;
+
+    auto & entry = m_profile->m_entries[m_type];
+
+    if (entry.m_calls++ == 0) {
+        entry.m_type = *m_type;
+    }
+
+    entry.m_inclusive += elapsed;
+    entry.m_exclusive += elapsed - m_children;
+    entry.m_bytes += m_bytes;
+
+    if (m_parent) {
+        m_parent->m_children += elapsed;
+    }
+
+    m_profile->m_open = m_parent;
+}
+
+/******************************************************************************/
@@ -0,0 +1,122 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    class Cursor;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Where decoding time goes, by schema type.
+     *
+     * Readers open a Scope for each value they read. With profiling off,
+     * the default, that's a load of a flag and nothing else, so unlike DBG
+     * this is always compiled in and switched on at runtime. With it on,
+     * every value read is counted against its type along with how long
+     * it took, with and without the values inside it, and how many
+     * encoded bytes it covered.
+     *
+     * Each thread records into its own profile, there's no sharing while
+     * decoding, and report merges them. They should only be merged or
+     * reset once decoding has finished.
+     */
+    class Profile {
+        public :
+            struct Entry {
+                std::string m_type;
+                uint64_t m_calls { 0 };
+                std::chrono::nanoseconds m_inclusive { 0 };
+                std::chrono::nanoseconds m_exclusive { 0 };
+                uint64_t m_bytes { 0 };
+            };
+
+            class Scope;
+
+        private :
+            static std::atomic<bool> s_enabled;
+
+            /**
+             * Keyed on the address of the reader's type name, which is
+             * fixed for the reader's life and shared by readers of the
+             * same primitive, so each value costs no more than hashing a
+             * pointer
+             */
+            std::unordered_map<const std::string *, Entry> m_entries;
+
+            /**
+             * The innermost open scope, for exclusive times
+             */
+            Scope * m_open { nullptr };
+
+            static Profile & local();
+
+        public :
+            static void enable (bool enabled_) {
+                s_enabled.store (enabled_, std::memory_order_relaxed);
+            }
+
+            static bool enabled() {
+                return s_enabled.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Every thread's profile merged by type name, most exclusive
+             * time first
+             */
+            static std::vector<Entry> report();
+
+            static void reset();
+    };
+
+    /**
+     * Times the reading of one value from construction to destruction
+     */
+    class Profile::Scope {
+        private :
+            Profile * m_profile;
+            Scope * m_parent;
+            const std::string * m_type;
+            std::chrono::steady_clock::time_point m_start;
+            std::chrono::nanoseconds m_children;
+            uint64_t m_bytes;
+
+            void open (const std::string &, decoder::Cursor &);
+            void close();
+
+        public :
+            Scope (const std::string & type_, decoder::Cursor & cursor_)
+                : m_profile (nullptr)
+            {
+                if (enabled()) {
+                    open (type_, cursor_);
+                }
+            }
+
+            Scope (const Scope &) = delete;
+            Scope & operator = (const Scope &) = delete;
+
+            ~Scope() {
+                if (m_profile) {
+                    close();
+                }
+            }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,810 @@
+#include "Program.h"
+
+#include <map>
+#include <array>
+#include <stdexcept>
+
+#include "debug.h"
+
+#include "decoder/Cursor.h"
+#include "decoder/Window.h"
+#include "amqp/reader/IVisitor.h"
+
+#include "CompositeReader.h"
+#include "restricted-readers/MapReader.h"
+#include "restricted-readers/ListReader.h"
+#include "restricted-readers/ArrayReader.h"
+#include "property-readers/IntPropertyReader.h"
+#include "property-readers/BoolPropertyReader.h"
+#include "property-readers/LongPropertyReader.h"
+#include "property-readers/DoublePropertyReader.h"
+#include "property-readers/StringPropertyReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Bounds both the call and loop stacks, kept on the C++ stack so
+     * running a program never allocates
+     */
+    constexpr size_t MAX_DEPTH = 256;
+
+    /**
+     * Whether [bytes_] starts with a back reference, if enough has
+     * arrived to tell
+     */
+    std::optional<bool>
+    reference (std::string_view bytes_) {
+        if (bytes_.empty()) {
+            return std::nullopt;
+        }
+
+        if (bytes_[0] != 0x00) {
+            return false;
+        }
+
+        const auto descriptor = amqp::internal::decoder::referenceDescriptor();
+
+        if (bytes_.size() < 1 + descriptor.size()) {
+            return std::nullopt;
+        }
+
+        return bytes_.substr (1, descriptor.size()) == descriptor;
+    }
+
+    /**
+     * Everything up to the elements of a described list or map, the
+     * descriptor and the list or map's own size and count
+     */
+    struct Header {
+        size_t m_size;
+        size_t m_count;
+
+        /**
+         * Bytes of elements following the header
+         */
+        size_t m_body;
+    };
+
+    size_t
+    be (std::string_view bytes_, size_t width_) {
+        size_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < width_ ; ++i) {
+            rtn = (rtn << 8u) | static_cast<uint8_t>(bytes_[i]);
+        }
+
+        return rtn;
+    }
+
+    std::optional<Header>
+    header (std::string_view bytes_, bool map_) {
+        if (bytes_.empty()) {
+            return std::nullopt;
+        }
+
+        if (bytes_[0] != 0x00) {
+            throw std::runtime_error ("Expected a described type");
+        }
+
+        auto descriptor = amqp::internal::decoder::Window::extent (bytes_.substr (1));
+
+        if (!descriptor || 1 + *descriptor >= bytes_.size()) {
+            return std::nullopt;
+        }
+
+        const auto offset = 1 + *descriptor;
+        const auto code = static_cast<uint8_t>(bytes_[offset]);
+
+        // the size prefix counts the count, the body is what's left
+        size_t width;
+        switch (code) {
+            case 0x45 : if (!map_) return Header { offset + 1, 0, 0 }; width = 0; break;
+            case 0xc0 : width = map_ ? 0 : 1; break;
+            case 0xd0 : width = map_ ? 0 : 4; break;
+            case 0xc1 : width = map_ ? 1 : 0; break;
+            case 0xd1 : width = map_ ? 4 : 0; break;
+            default : width = 0;
+        }
+
+        if (width == 0) {
+            throw std::runtime_error (map_ ? "Expected a map" : "Expected a list");
+        }
+
+        if (bytes_.size() < offset + 1 + 2 * width) {
+            return std::nullopt;
+        }
+
+        return Header {
+            offset + 1 + 2 * width,
+            be (bytes_.substr (offset + 1 + width), width),
+            be (bytes_.substr (offset + 1), width) - width };
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Program::Compiler
+ *
+ ******************************************************************************/
+
+/**
+ * Each compound reader becomes one block, compiled in the order we first
+ * come across them. Calls are emitted against a block's number and
+ * patched with its address once every block has been laid down, so
+ * a reader reachable from several places, or from itself, is only
+ * compiled once.
+ */
+class amqp::internal::reader::
+Program::Compiler {
+    private :
+        Program & m_program;
+
+        std::map<const IReader *, uint32_t> m_ids;
+        std::vector<std::shared_ptr<IReader>> m_blocks;
+        std::vector<uint32_t> m_starts;
+
+        /**
+         * Positions of the call ops still holding a block number
+         */
+        std::vector<size_t> m_calls;
+
+        uint32_t here() const {
+            return static_cast<uint32_t>(m_program.m_ops.size());
+        }
+
+        void emit (OpCode code_, uint32_t arg_ = 0) {
+            m_program.m_ops.push_back (Op { code_, arg_ });
+        }
+
+        static std::shared_ptr<IReader> require (std::shared_ptr<IReader> reader_) {
+            if (!reader_) {
+                throw std::runtime_error ("Cannot compile a null reader");
+            }
+
+            return reader_;
+        }
+
+        static bool compound (const IReader &);
+
+        uint32_t block (const std::shared_ptr<IReader> &);
+
+        uint32_t reader (const std::shared_ptr<IReader> &);
+
+        void value (const std::shared_ptr<IReader> &, bool element_ = false);
+        void body (const IReader &);
+        void loop (const std::vector<std::shared_ptr<IReader>> &);
+        void elements (const std::shared_ptr<IReader> &);
+
+    public :
+        explicit Compiler (Program & program_) : m_program (program_) { }
+
+        void compile (const std::shared_ptr<IReader> &);
+};
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Program::Compiler::compound (const IReader & reader_) {
+    return dynamic_cast<const CompositeReader *>(&reader_)
+        || dynamic_cast<const ListReader *>(&reader_)
+        || dynamic_cast<const ArrayReader *>(&reader_)
+        || dynamic_cast<const MapReader *>(&reader_);
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::reader::
+Program::Compiler::block (const std::shared_ptr<IReader> & reader_) {
+    auto it = m_ids.find (reader_.get());
+
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+
+    auto id = static_cast<uint32_t>(m_blocks.size());
+
+    m_ids.emplace (reader_.get(), id);
+    m_blocks.push_back (reader_);
+
+    return id;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::reader::
+Program::Compiler::reader (const std::shared_ptr<IReader> & reader_) {
+    m_program.m_readers.push_back (reader_);
+
+    return static_cast<uint32_t>(m_program.m_readers.size() - 1);
+}
+
+/******************************************************************************/
+
+/**
+ * Whatever it takes to read one value with [reader_], [element_] if
+ * it's an element of a list or map rather than a field
+ */
+void
+amqp::internal::reader::
+Program::Compiler::value (
+    const std::shared_ptr<IReader> & reader_,
+    bool element_
+) {
+    const auto & reader = *reader_;
+
+    if (dynamic_cast<const IntPropertyReader *>(&reader)) {
+        emit (OpCode::read_int);
+    } else if (dynamic_cast<const LongPropertyReader *>(&reader)) {
+        emit (OpCode::read_long);
+    } else if (dynamic_cast<const BoolPropertyReader *>(&reader)) {
+        emit (OpCode::read_bool);
+    } else if (dynamic_cast<const DoublePropertyReader *>(&reader)) {
+        emit (OpCode::read_double);
+    } else if (dynamic_cast<const StringPropertyReader *>(&reader)) {
+        emit (element_ ? OpCode::read_remembered_string : OpCode::read_string);
+    } else if (compound (reader)) {
+        m_calls.push_back (here());
+        emit (OpCode::call, block (reader_));
+    } else if (element_ && rememberedElement (reader)) {
+        emit (OpCode::visit_remembered, this->reader (reader_));
+    } else {
+        emit (OpCode::visit, this->reader (reader_));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The body of a list or map, [readers_] being what reads each element
+ * or, for a map, each key and value in turn
+ */
+void
+amqp::internal::reader::
+Program::Compiler::loop (const std::vector<std::shared_ptr<IReader>> & readers_) {
+    auto top = here();
+    emit (OpCode::loop);
+
+    for (const auto & reader : readers_) {
+        value (reader, true);
+    }
+
+    emit (OpCode::repeat, top);
+    m_program.m_ops[top].m_arg = here();
+}
+
+/******************************************************************************/
+
+/**
+ * The body of a list or array
+ */
+void
+amqp::internal::reader::
+Program::Compiler::elements (const std::shared_ptr<IReader> & reader_) {
+    if (runnable (*reader_)) {
+        emit (OpCode::read_run, reader (reader_));
+    } else {
+        loop ({ reader_ });
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Program::Compiler::body (const IReader & reader_) {
+    if (auto composite = dynamic_cast<const CompositeReader *>(&reader_)) {
+        emit (OpCode::begin_object, static_cast<uint32_t>(m_program.m_names.size()));
+        m_program.m_names.push_back (composite->descriptor());
+
+        for (size_t i { 0 } ; i < composite->fieldCount() ; ++i) {
+            emit (OpCode::field, static_cast<uint32_t>(m_program.m_names.size()));
+            m_program.m_names.push_back (composite->fieldName (i));
+
+            value (composite->field (i));
+        }
+
+        emit (OpCode::end_object);
+    } else if (auto list = dynamic_cast<const ListReader *>(&reader_)) {
+        emit (OpCode::begin_list);
+        elements (require (list->elementReader()));
+        emit (OpCode::end_list);
+    } else if (auto array = dynamic_cast<const ArrayReader *>(&reader_)) {
+        emit (OpCode::begin_list);
+        elements (require (array->elementReader()));
+        emit (OpCode::end_list);
+    } else if (auto map = dynamic_cast<const MapReader *>(&reader_)) {
+        emit (OpCode::begin_map);
+        loop ({ require (map->keyReader()), require (map->valueReader()) });
+        emit (OpCode::end_map);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Program::Compiler::compile (const std::shared_ptr<IReader> & root_) {
+    /*
+     * A program for a single scalar, unlikely as that is, is just
+     * the one instruction
+     */
+    if (!compound (*require (root_))) {
+        value (root_);
+        emit (OpCode::ret);
+        return;
+    }
+
+    block (root_);
+
+    // bodies add to m_blocks as they find readers we've not seen before
+    for (size_t i { 0 } ; i < m_blocks.size() ; ++i) {
+        m_starts.push_back (here());
+        emit (OpCode::dereference, reader (m_blocks[i]));
+        body (*m_blocks[i]);
+        emit (OpCode::ret);
+    }
+
+    for (auto call : m_calls) {
+        auto & op = m_program.m_ops[call];
+        op.m_arg = m_starts[op.m_arg];
+    }
+
+    DBG ("Compiled " << root_->type() << " into " << m_blocks.size()
+        << " blocks, " << m_program.m_ops.size() << " ops" << std::endl); // NOLINT
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Program
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Program::Program (const std::shared_ptr<IReader> & reader_) {
+    Compiler (*this).compile (reader_);
+}
+
+/******************************************************************************/
+
+/**
+ * Each op does what the matching reader's visit would, in the same
+ * order, so errors on malformed input surface as they would there
+ */
+void
+amqp::internal::reader::
+Program::run (
+    decoder::Cursor & cursor_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    std::array<uint32_t, MAX_DEPTH> calls; // NOLINT
+    std::array<size_t, MAX_DEPTH> loops; // NOLINT
+    std::array<Start, MAX_DEPTH> objects; // NOLINT
+    size_t call { 0 };
+    size_t loop { 0 };
+    size_t object { 0 };
+
+    auto push = [&loops, &loop](size_t count_) {
+        if (loop == MAX_DEPTH) {
+            throw std::runtime_error ("Value nested too deeply");
+        }
+        loops[loop++] = count_;
+    };
+
+    auto recorder = Recorder::of (visitor_);
+
+    const Op * ops = m_ops.data();
+    uint32_t pc { 0 };
+
+    for (;;) {
+        const auto & op = ops[pc++];
+
+        switch (op.m_code) {
+            case OpCode::read_int :
+                visitor_.value (decoder::readAndNext<int32_t> (cursor_));
+                break;
+            case OpCode::read_long :
+                visitor_.value (decoder::readAndNext<int64_t> (cursor_));
+                break;
+            case OpCode::read_bool :
+                visitor_.value (decoder::readAndNext<bool> (cursor_));
+                break;
+            case OpCode::read_double :
+                visitor_.value (decoder::readAndNext<double> (cursor_));
+                break;
+            case OpCode::read_string :
+                visitor_.value (decoder::readAndNext<std::string_view> (cursor_));
+                break;
+            case OpCode::read_remembered_string :
+                if (cursor_.isReference()) {
+                    decoder::Cursor replay (cursor_.referenced(), cursor_);
+                    replay.next();
+                    visitor_.value (decoder::readAndNext<std::string_view> (replay));
+                    cursor_.next();
+                } else {
+                    auto raw = cursor_.raw();
+                    visitor_.value (decoder::readAndNext<std::string_view> (cursor_));
+                    cursor_.remember (raw);
+                }
+                break;
+            case OpCode::field :
+                visitor_.field (m_names[op.m_arg]);
+                break;
+            case OpCode::dereference :
+                if (dereference (*m_readers[op.m_arg], cursor_, schema_, visitor_)) {
+                    if (call == 0) {
+                        return;
+                    }
+                    pc = calls[--call];
+                } else {
+                    if (object == MAX_DEPTH) {
+                        throw std::runtime_error ("Value nested too deeply");
+                    }
+                    objects[object++] = start (cursor_, recorder);
+                }
+                break;
+            case OpCode::begin_object :
+                decoder::is_described (cursor_);
+                cursor_.enter();
+                cursor_.next();
+                decoder::is_descriptor (cursor_, m_names[op.m_arg]);
+                cursor_.next();
+                decoder::is_list (cursor_);
+                visitor_.startObject();
+                cursor_.enter();
+                cursor_.next();
+                break;
+            case OpCode::end_object :
+                cursor_.exit();
+                visitor_.endObject();
+                cursor_.exit();
+                remember (cursor_, recorder, objects[--object]);
+                cursor_.next();
+                break;
+            case OpCode::begin_list :
+                decoder::is_described (cursor_);
+                visitor_.startList();
+                cursor_.enter();
+                cursor_.next();
+                cursor_.next();
+                push (cursor_.elementCount());
+                cursor_.enter();
+                cursor_.next();
+                break;
+            case OpCode::end_list :
+                cursor_.exit();
+                cursor_.exit();
+                visitor_.endList();
+                remember (cursor_, recorder, objects[--object]);
+                cursor_.next();
+                break;
+            case OpCode::begin_map :
+                decoder::is_described (cursor_);
+                visitor_.startMap();
+                cursor_.enter();
+                cursor_.next();
+                cursor_.next();
+                // keys and values alternate, one iteration covers both
+                push ((cursor_.mapCount() + 1) / 2);
+                cursor_.enter();
+                cursor_.next();
+                break;
+            case OpCode::end_map :
+                cursor_.exit();
+                cursor_.exit();
+                visitor_.endMap();
+                remember (cursor_, recorder, objects[--object]);
+                cursor_.next();
+                break;
+            case OpCode::read_run :
+                --loop;
+                visitElements (*m_readers[op.m_arg], loops[loop], cursor_, schema_, visitor_);
+                break;
+            case OpCode::loop :
+                if (loops[loop - 1] == 0) {
+                    --loop;
+                    pc = op.m_arg;
+                } else {
+                    --loops[loop - 1];
+                }
+                break;
+            case OpCode::repeat :
+                pc = op.m_arg;
+                break;
+            case OpCode::call :
+                if (call == MAX_DEPTH) {
+                    throw std::runtime_error ("Value nested too deeply");
+                }
+                calls[call++] = pc;
+                pc = op.m_arg;
+                break;
+            case OpCode::ret :
+                if (call == 0) {
+                    return;
+                }
+                pc = calls[--call];
+                break;
+            case OpCode::visit :
+                m_readers[op.m_arg]->visit (cursor_, schema_, visitor_);
+                break;
+            case OpCode::visit_remembered :
+                visitRemembered (*m_readers[op.m_arg], cursor_, schema_, visitor_);
+                break;
+        }
+    }
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Program::Resumable
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Program::Resumable::Resumable (
+    const Program & program_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) : m_program (program_)
+  , m_schema (schema_)
+  , m_visitor (visitor_)
+  , m_pc (0)
+  , m_wanted (0)
+{
+    m_calls.reserve (MAX_DEPTH);
+    m_loops.reserve (MAX_DEPTH);
+    m_ends.reserve (MAX_DEPTH);
+}
+
+/******************************************************************************/
+
+/**
+ * The size of the value [bytes_] starts with if it's all arrived,
+ * otherwise note how much more we need
+ */
+std::optional<size_t>
+amqp::internal::reader::
+Program::Resumable::whole (std::string_view bytes_) {
+    auto extent = decoder::Window::extent (bytes_);
+
+    if (!extent) {
+        m_wanted = bytes_.size() + 1;
+        return std::nullopt;
+    }
+
+    if (*extent > bytes_.size()) {
+        m_wanted = *extent;
+        return std::nullopt;
+    }
+
+    return extent;
+}
+
+/******************************************************************************/
+
+/**
+ * Past whatever's left of the innermost compound, a composite written
+ * with more fields than we know of, say. Skipped bytes needn't be held
+ * so we take what there is and ask for more.
+ */
+bool
+amqp::internal::reader::
+Program::Resumable::skip (decoder::Window & window_) {
+    const auto remaining = m_ends.back() - window_.position();
+    const auto available = std::min<uint64_t> (remaining, window_.size());
+
+    window_.consume (available);
+
+    if (available < remaining) {
+        m_wanted = 1;
+        return false;
+    }
+
+    m_ends.pop_back();
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Op for op as run, but where run steps into a compound with the cursor
+ * we consume its header and remember where it ends
+ */
+bool
+amqp::internal::reader::
+Program::Resumable::resume (decoder::Window & window_) {
+    /*
+     * Scalars and anything handed to a reader are decoded as run would
+     * once they've arrived whole, with a cursor over just their bytes
+     */
+    auto read = [this, &window_](auto read_) {
+        auto bytes = window_.bytes();
+        auto size = this->whole (bytes);
+
+        if (!size) {
+            return false;
+        }
+
+        decoder::Cursor cursor (bytes.substr (0, *size));
+        cursor.next();
+
+        read_ (cursor);
+
+        window_.consume (*size);
+
+        return true;
+    };
+
+    auto enter = [this, &window_](
+            bool map_,
+            std::string_view descriptor_ = { }) -> std::optional<size_t>
+    {
+        auto h = header (window_.bytes(), map_);
+
+        if (!h) {
+            m_wanted = window_.size() + 1;
+            return std::nullopt;
+        }
+
+        // the header's only there if the descriptor arrived whole
+        if (!descriptor_.empty()) {
+            auto bytes = window_.bytes().substr (1);
+
+            decoder::Cursor cursor (bytes.substr (0, *decoder::Window::extent (bytes)));
+            cursor.next();
+            decoder::is_descriptor (cursor, descriptor_);
+        }
+
+        if (m_ends.size() == MAX_DEPTH) {
+            throw std::runtime_error ("Value nested too deeply");
+        }
+
+        window_.consume (h->m_size);
+        m_ends.push_back (window_.position() + h->m_body);
+
+        return h->m_count;
+    };
+
+    const auto & names = m_program.m_names;
+    const auto & readers = m_program.m_readers;
+
+    for (;;) {
+        const auto & op = m_program.m_ops[m_pc];
+        auto next = m_pc + 1;
+
+        switch (op.m_code) {
+            case OpCode::read_int :
+                if (!read ([this](decoder::Cursor & c_) {
+                    m_visitor.value (decoder::readAndNext<int32_t> (c_));
+                })) return false;
+                break;
+            case OpCode::read_long :
+                if (!read ([this](decoder::Cursor & c_) {
+                    m_visitor.value (decoder::readAndNext<int64_t> (c_));
+                })) return false;
+                break;
+            case OpCode::read_bool :
+                if (!read ([this](decoder::Cursor & c_) {
+                    m_visitor.value (decoder::readAndNext<bool> (c_));
+                })) return false;
+                break;
+            case OpCode::read_double :
+                if (!read ([this](decoder::Cursor & c_) {
+                    m_visitor.value (decoder::readAndNext<double> (c_));
+                })) return false;
+                break;
+            case OpCode::read_string :
+            case OpCode::read_remembered_string :
+                if (!read ([this](decoder::Cursor & c_) {
+                    if (c_.isReference()) {
+                        throw std::runtime_error (
+                                "Cannot follow a back reference when streaming");
+                    }
+                    m_visitor.value (decoder::readAndNext<std::string_view> (c_));
+                })) return false;
+                break;
+            case OpCode::field :
+                m_visitor.field (names[op.m_arg]);
+                break;
+            case OpCode::dereference : {
+                auto isReference = reference (window_.bytes());
+                if (!isReference) {
+                    m_wanted = 1 + decoder::referenceDescriptor().size();
+                    return false;
+                }
+                if (*isReference) {
+                    throw std::runtime_error (
+                            "Cannot follow a back reference when streaming");
+                }
+                break;
+            }
+            case OpCode::begin_object :
+                if (!enter (false, names[op.m_arg])) return false;
+                m_visitor.startObject();
+                break;
+            case OpCode::end_object :
+                if (!skip (window_)) return false;
+                m_visitor.endObject();
+                break;
+            case OpCode::begin_list : {
+                auto count = enter (false);
+                if (!count) return false;
+                m_visitor.startList();
+                m_loops.push_back (*count);
+                break;
+            }
+            case OpCode::end_list :
+                if (!skip (window_)) return false;
+                m_visitor.endList();
+                break;
+            case OpCode::begin_map : {
+                auto count = enter (true);
+                if (!count) return false;
+                m_visitor.startMap();
+                m_loops.push_back ((*count + 1) / 2);
+                break;
+            }
+            case OpCode::end_map :
+                if (!skip (window_)) return false;
+                m_visitor.endMap();
+                break;
+            case OpCode::read_run :
+                // a value at a time, as they arrive
+                for ( ; m_loops.back() > 0 ; --m_loops.back()) {
+                    if (!read ([this, &readers, &op](decoder::Cursor & c_) {
+                        readers[op.m_arg]->visit (c_, m_schema, m_visitor);
+                    })) return false;
+                }
+                m_loops.pop_back();
+                break;
+            case OpCode::loop :
+                if (m_loops.back() == 0) {
+                    m_loops.pop_back();
+                    next = op.m_arg;
+                } else {
+                    --m_loops.back();
+                }
+                break;
+            case OpCode::repeat :
+                next = op.m_arg;
+                break;
+            case OpCode::call :
+                if (m_calls.size() == MAX_DEPTH) {
+                    throw std::runtime_error ("Value nested too deeply");
+                }
+                m_calls.push_back (next);
+                next = op.m_arg;
+                break;
+            case OpCode::ret :
+                if (m_calls.empty()) {
+                    return true;
+                }
+                next = m_calls.back();
+                m_calls.pop_back();
+                break;
+            case OpCode::visit :
+            case OpCode::visit_remembered :
+                if (!read ([this, &readers, &op](decoder::Cursor & c_) {
+                    if (c_.isReference()) {
+                        throw std::runtime_error (
+                                "Cannot follow a back reference when streaming");
+                    }
+                    readers[op.m_arg]->visit (c_, m_schema, m_visitor);
+                })) return false;
+                break;
+        }
+
+        m_pc = next;
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,216 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    class Window;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The reader graph for a type lowered into a flat array of
+     * instructions and run by a single interpreter loop.
+     *
+     * Walking the graph costs a weak_ptr lock and a virtual call for
+     * every value. Here each composite, list, map and array reader is
+     * compiled once into a block, called from wherever it's used. The
+     * scalar reads are inlined into the blocks that use them, and lists
+     * of primitives read a run at a time rather than looped over. Anything
+     * we don't know how to lower, enums for instance, is called through
+     * its reader as before.
+     *
+     * A program produces exactly what visiting the reader it was compiled
+     * from would, leaves the cursor in the same place, and like the
+     * readers it's immutable once built so can be shared between threads.
+     */
+    class Program {
+        public :
+            enum class OpCode : uint8_t {
+                /**
+                 * Read a scalar, hand it to the visitor, move on
+                 */
+                read_int,
+                read_long,
+                read_bool,
+                read_double,
+                read_string,
+
+                /**
+                 * A string as an element of a list or map, which unlike
+                 * a field can be a back reference and is remembered
+                 */
+                read_remembered_string,
+
+                /**
+                 * Name the next field of an object, arg indexes m_names
+                 */
+                field,
+
+                /**
+                 * Starts every block. If the cursor's on a back reference
+                 * hand what it refers to to m_readers[arg] and return,
+                 * otherwise note where the value starts so the end op
+                 * can remember it once it's been read
+                 */
+                dereference,
+
+                /**
+                 * Step into the field list of a described composite
+                 * and back out again, moving on to the next value. The
+                 * begin op checks the descriptor is m_names[arg], the
+                 * fields being laid out for that type alone
+                 */
+                begin_object,
+                end_object,
+
+                /**
+                 * As above for the elements of a described list or array
+                 * and the entries of a map, the begin ops push the number
+                 * of iterations onto the loop stack
+                 */
+                begin_list,
+                end_list,
+                begin_map,
+                end_map,
+
+                /**
+                 * The whole body of a list or array of ints, doubles and
+                 * the like, the count popped off the loop stack. Runs of
+                 * them are read into a buffer and handed over at once,
+                 * m_readers[arg] reading any that can't be
+                 */
+                read_run,
+
+                /**
+                 * Pop the loop stack and jump to arg if it's run out,
+                 * otherwise count down and fall through into the body
+                 */
+                loop,
+
+                /**
+                 * Jump back to the loop at arg
+                 */
+                repeat,
+
+                call,
+                ret,
+
+                /**
+                 * Hand the value to m_readers[arg]
+                 */
+                visit,
+
+                /**
+                 * As visit for a value the JVM remembers as an element,
+                 * a date or a UUID in a list say, following and keeping
+                 * back references as read_remembered_string does
+                 */
+                visit_remembered
+            };
+
+            struct Op {
+                OpCode m_code;
+                uint32_t m_arg;
+            };
+
+        private :
+            std::vector<Op> m_ops;
+            std::vector<std::string> m_names;
+
+            /**
+             * Those we couldn't lower, and those each block was compiled
+             * from for replaying references, held so they outlive us
+             */
+            std::vector<std::shared_ptr<const IReader>> m_readers;
+
+            class Compiler;
+
+        public :
+            explicit Program (const std::shared_ptr<IReader> &);
+
+            /**
+             * With the cursor on a value of the type we were compiled
+             * for, as with IReader::visit
+             */
+            void run (
+                decoder::Cursor &,
+                const IReader::SchemaType &,
+                amqp::reader::IVisitor &) const;
+
+            const std::vector<Op> & ops() const { return m_ops; }
+
+            class Resumable;
+    };
+
+    /**
+     * Runs a program over a stream of bytes that arrive a chunk at a time.
+     *
+     * Each op is carried out only once everything it reads has arrived
+     * and otherwise we stop, to carry on from the same op when there's
+     * more. Compound values are entered on the strength of their headers
+     * alone so the only values ever held whole are the scalars, and the
+     * enums and the like handed off to their readers.
+     *
+     * Nothing read is kept, so unlike run a back reference can't be
+     * followed and is an error.
+     */
+    class Program::Resumable {
+        private :
+            const Program & m_program;
+            const IReader::SchemaType & m_schema;
+            amqp::reader::IVisitor & m_visitor;
+
+            uint32_t m_pc;
+            std::vector<uint32_t> m_calls;
+            std::vector<size_t> m_loops;
+
+            /**
+             * Where in the stream each compound we're within ends
+             */
+            std::vector<uint64_t> m_ends;
+
+            size_t m_wanted;
+
+            std::optional<size_t> whole (std::string_view);
+            bool skip (decoder::Window &);
+
+        public :
+            Resumable (
+                const Program &,
+                const IReader::SchemaType &,
+                amqp::reader::IVisitor &);
+
+            /**
+             * Carry on with what's in [window_], consuming as we go
+             *
+             * @return true once the value has been read
+             */
+            bool resume (decoder::Window & window_);
+
+            /**
+             * How many bytes the window has to hold before the op we
+             * stopped at can be carried out, at least as far as we
+             * can tell from what's there already
+             */
+            size_t wanted() const { return m_wanted; }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,118 @@
+#include "Projection.h"
+
+#include <stdexcept>
+
+#include "CompositeReader.h"
+#include "decoder/Cursor.h"
+
+/******************************************************************************/
+
+amqp::internal::reader::
+Projection::Projection (
+    std::shared_ptr<IReader> reader_,
+    std::string_view path_
+) : m_path (path_)
+  , m_reader (std::move (reader_))
+{
+    while (!path_.empty()) {
+        auto dot = path_.find ('.');
+        auto name = std::string (path_.substr (0, dot));
+
+        auto composite = dynamic_cast<const CompositeReader *>(m_reader.get());
+
+        if (!composite) {
+            throw std::runtime_error (
+                    "Cannot select \"" + name + "\" from " + m_reader->type()
+                        + ", it is not a composite");
+        }
+
+        auto index = composite->fieldIndex (name);
+
+        m_offsets.push_back (index);
+        m_reader = composite->field (index);
+
+        path_ = dot == std::string_view::npos
+            ? std::string_view { }
+            : path_.substr (dot + 1);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Projection::visit (
+    decoder::Cursor & cursor_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    if (m_offsets.empty()) {
+        m_reader->visit (cursor_, schema_, visitor_);
+    } else {
+        walk (cursor_, schema_, visitor_, 0);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Enter the composite at step [step_] of the path and skip to the field
+ * it names. The fields we pass over are never decoded, each is stepped
+ * over in one go using its size prefix.
+ */
+void
+amqp::internal::reader::
+Projection::walk (
+    decoder::Cursor & cursor_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_,
+    size_t step_
+) const {
+    decoder::auto_next an (cursor_);
+
+    // follow a back reference to the object it names and carry on there
+    if (cursor_.isReference()) {
+        decoder::Cursor replay (cursor_.referenced(), cursor_);
+        replay.next();
+
+        walk (replay, schema_, visitor_, step_);
+        return;
+    }
+
+    if (cursor_.type() == decoder::Type::null_t) {
+        throw std::runtime_error ("Cannot select " + m_path + " through a null value");
+    }
+
+    decoder::is_described (cursor_);
+    decoder::auto_enter ae (cursor_);
+
+    cursor_.next();
+    decoder::is_list (cursor_);
+
+    decoder::auto_list_enter ale (cursor_, true);
+
+    if (m_offsets[step_] >= ale.elements()) {
+        throw std::runtime_error ("Cannot select " + m_path + ", field missing from blob");
+    }
+
+    /*
+     * Nothing we step over is remembered so the cursor can no longer
+     * resolve references, which only matters if the value we select
+     * holds one
+     */
+    if (m_offsets[step_] > 0) {
+        cursor_.forget();
+    }
+
+    for (size_t i { 0 } ; i < m_offsets[step_] ; ++i) {
+        cursor_.next();
+    }
+
+    if (step_ + 1 == m_offsets.size()) {
+        m_reader->visit (cursor_, schema_, visitor_);
+    } else {
+        walk (cursor_, schema_, visitor_, step_ + 1);
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,64 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <string_view>
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A dotted path, "owner.name", through nested composites compiled
+     * against the readers for a type. Each step is resolved up front to
+     * the field's position in its composite's list so walking a blob
+     * only has to step over the fields ahead of it, using their size
+     * prefixes, and enter the one it wants. Nothing outside the path is
+     * decoded.
+     *
+     * An empty path selects the whole value.
+     */
+    class Projection {
+        private :
+            std::string m_path;
+
+            /**
+             * Field position at each step of the path
+             */
+            std::vector<size_t> m_offsets;
+
+            /**
+             * Reader for whatever the path ends at
+             */
+            std::shared_ptr<IReader> m_reader;
+
+            void walk (
+                decoder::Cursor &,
+                const IReader::SchemaType &,
+                amqp::reader::IVisitor &,
+                size_t) const;
+
+        public :
+            Projection (std::shared_ptr<IReader>, std::string_view);
+
+            const std::string & path() const { return m_path; }
+
+            /**
+             * With the cursor on the value the projection was compiled
+             * for visit only the selected field, the cursor is left on
+             * the following value as with IReader::visit
+             */
+            void visit (
+                decoder::Cursor &,
+                const IReader::SchemaType &,
+                amqp::reader::IVisitor &) const;
+    };
+
+}
+
+/******************************************************************************/
@@ -5,11 +5,21 @@
 #include "amqp/reader/property-readers/LongPropertyReader.h"
 #include "amqp/reader/property-readers/StringPropertyReader.h"
 #include "amqp/reader/property-readers/DoublePropertyReader.h"
+#include "amqp/reader/property-readers/BytePropertyReader.h"
+#include "amqp/reader/property-readers/ShortPropertyReader.h"
+#include "amqp/reader/property-readers/CharPropertyReader.h"
+#include "amqp/reader/property-readers/FloatPropertyReader.h"
+#include "amqp/reader/property-readers/TimestampPropertyReader.h"
+#include "amqp/reader/property-readers/UuidPropertyReader.h"
+#include "amqp/reader/property-readers/BinaryPropertyReader.h"
+#include "amqp/reader/property-readers/SymbolPropertyReader.h"
+#include "amqp/reader/property-readers/DecimalPropertyReader.h"
 
 #include <map>
 #include <string>
 #include <iostream>
 #include <functional>
+#include <stdexcept>
 
 #include <proton/codec.h>
 
@@ -21,7 +31,7 @@ namespace {
 
     using namespace amqp::internal::reader;
 
-    std::map<
+    const std::map<
             std::string,
             std::shared_ptr<amqp::internal::reader::PropertyReader>(*)()
     > propertyMap = { // NOLINT
@@ -49,9 +59,82 @@ namespace {
             "double", []() -> std::shared_ptr<PropertyReader> {
                 return std::make_shared<DoublePropertyReader> ();
             }
+        },
+        {
+            "byte", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<BytePropertyReader> ();
+            }
+        },
+        {
+            "short", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<ShortPropertyReader> ();
+            }
+        },
+        {
+            "char", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<CharPropertyReader> ();
+            }
+        },
+        {
+            "float", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<FloatPropertyReader> ();
+            }
+        },
+        {
+            "timestamp", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<TimestampPropertyReader> ();
+            }
+        },
+        {
+            "uuid", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<UuidPropertyReader> ();
+            }
+        },
+        {
+            "binary", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<BinaryPropertyReader> ();
+            }
+        },
+        {
+            "symbol", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<SymbolPropertyReader> ();
+            }
+        },
+        {
+            "decimal32", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<DecimalPropertyReader> (
+                        amqp::internal::decoder::Type::decimal32_t);
+            }
+        },
+        {
+            "decimal64", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<DecimalPropertyReader> (
+                        amqp::internal::decoder::Type::decimal64_t);
+            }
+        },
+        {
+            "decimal128", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<DecimalPropertyReader> (
+                        amqp::internal::decoder::Type::decimal128_t);
+            }
         }
     };
 
+    /**
+     * The map is shared between threads so we must never use operator[]
+     * on it as that would insert a null factory for unknown types
+     */
+    std::shared_ptr<PropertyReader>
+    makeProperty (const std::string & type_) {
+        auto it = propertyMap.find (type_);
+
+        if (it == propertyMap.end()) {
+            throw std::runtime_error ("No property reader for type " + type_);
+        }
+
+        return it->second();
+    }
+
 }
 
 /******************************************************************************
@@ -63,7 +146,7 @@ namespace {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const FieldPtr & field_) {
-    return propertyMap[field_->type()]();
+    return makeProperty (field_->type());
 }
 
 /******************************************************************************/
@@ -71,7 +154,7 @@ PropertyReader::make (const FieldPtr & field_) {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const std::string & type_) {
-    return propertyMap[type_]();
+    return makeProperty (type_);
 }
 
 /******************************************************************************/
@@ -79,7 +162,7 @@ PropertyReader::make (const std::string & type_) {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const internal::schema::Field & field_) {
-    return propertyMap[field_.type()]();
+    return makeProperty (field_.type());
 }
 
 /******************************************************************************/
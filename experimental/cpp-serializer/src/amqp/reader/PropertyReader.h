@@ -27,8 +27,6 @@ namespace amqp::internal::reader {
 
             std::string readString (pn_data_t *) const override = 0;
 
-            std::any read (pn_data_t *) const override = 0;
-
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
                 pn_data_t *,
@@ -40,6 +38,11 @@ namespace amqp::internal::reader {
                 const SchemaType &
             ) const override = 0;
 
+            void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
+
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
     };
@@ -0,0 +1,466 @@
+#include "Pull.h"
+
+#include <stdexcept>
+
+#include "CompositeReader.h"
+#include "property-readers/IntPropertyReader.h"
+#include "property-readers/LongPropertyReader.h"
+#include "property-readers/BoolPropertyReader.h"
+#include "property-readers/DoublePropertyReader.h"
+#include "property-readers/StringPropertyReader.h"
+#include "property-readers/BytePropertyReader.h"
+#include "property-readers/ShortPropertyReader.h"
+#include "property-readers/CharPropertyReader.h"
+#include "property-readers/FloatPropertyReader.h"
+#include "property-readers/TimestampPropertyReader.h"
+#include "property-readers/UuidPropertyReader.h"
+#include "property-readers/BinaryPropertyReader.h"
+#include "property-readers/SymbolPropertyReader.h"
+#include "property-readers/DecimalPropertyReader.h"
+#include "restricted-readers/EnumReader.h"
+#include "restricted-readers/ListReader.h"
+#include "restricted-readers/ArrayReader.h"
+#include "restricted-readers/MapReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string EMPTY; // NOLINT
+
+    template<class T>
+    const amqp::internal::reader::IReader *
+    locked (const std::shared_ptr<T> & reader_) {
+        if (!reader_) {
+            throw std::runtime_error ("null reader");
+        }
+
+        return reader_.get();
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Pull::Kind
+amqp::internal::reader::
+Pull::kind (const IReader & reader_) {
+    if (dynamic_cast<const IntPropertyReader *>(&reader_)) return Kind::int_t;
+    if (dynamic_cast<const LongPropertyReader *>(&reader_)) return Kind::long_t;
+    if (dynamic_cast<const BoolPropertyReader *>(&reader_)) return Kind::bool_t;
+    if (dynamic_cast<const DoublePropertyReader *>(&reader_)) return Kind::double_t;
+    if (dynamic_cast<const StringPropertyReader *>(&reader_)) return Kind::string_t;
+    if (dynamic_cast<const BytePropertyReader *>(&reader_)) return Kind::byte_t;
+    if (dynamic_cast<const ShortPropertyReader *>(&reader_)) return Kind::short_t;
+    if (dynamic_cast<const CharPropertyReader *>(&reader_)) return Kind::char_t;
+    if (dynamic_cast<const FloatPropertyReader *>(&reader_)) return Kind::float_t;
+    if (dynamic_cast<const TimestampPropertyReader *>(&reader_)) return Kind::timestamp_t;
+    if (dynamic_cast<const UuidPropertyReader *>(&reader_)) return Kind::uuid_t;
+    if (dynamic_cast<const BinaryPropertyReader *>(&reader_)) return Kind::binary_t;
+    if (dynamic_cast<const SymbolPropertyReader *>(&reader_)) return Kind::symbol_t;
+    if (dynamic_cast<const DecimalPropertyReader *>(&reader_)) return Kind::decimal_t;
+    if (dynamic_cast<const EnumReader *>(&reader_)) return Kind::enum_t;
+    if (dynamic_cast<const CompositeReader *>(&reader_)) return Kind::composite_t;
+    if (dynamic_cast<const ListReader *>(&reader_)) return Kind::list_t;
+    if (dynamic_cast<const ArrayReader *>(&reader_)) return Kind::list_t;
+    if (dynamic_cast<const MapReader *>(&reader_)) return Kind::map_t;
+
+    throw std::runtime_error ("Cannot pull a " + reader_.type());
+}
+
+/******************************************************************************/
+
+/**
+ * Which cursor to walk, the one we were given or, if that's on a back
+ * reference, one over the object it refers to
+ */
+amqp::internal::decoder::Cursor &
+amqp::internal::reader::
+Pull::open (decoder::Cursor & cursor_) {
+    if (cursor_.isReference()) {
+        m_replay.emplace (cursor_.referenced(), cursor_);
+        m_replay->next();
+
+        return *m_replay;
+    }
+
+    m_raw = cursor_.raw();
+
+    return cursor_;
+}
+
+/******************************************************************************/
+
+/**
+ * Leaves the cursor just inside the list or map holding the values so
+ * the first call to next() puts it on the first of them
+ */
+amqp::internal::reader::
+Pull::Pull (const IReader & reader_, decoder::Cursor & cursor_)
+    : m_outer (cursor_)
+    , m_cursor (open (cursor_))
+    , m_reader (reader_)
+    , m_composite (nullptr)
+    , m_kind (kind (reader_))
+    , m_first (nullptr)
+    , m_second (nullptr)
+    , m_count (0)
+    , m_index (0)
+    , m_current (nullptr)
+    , m_consumed (true)
+    , m_exceptions (std::uncaught_exceptions())
+{
+    switch (m_kind) {
+        case Kind::composite_t :
+            m_composite = static_cast<const CompositeReader *>(&reader_);
+            break;
+        case Kind::list_t :
+            if (auto list = dynamic_cast<const ListReader *>(&reader_)) {
+                m_first = locked (list->elementReader());
+            } else {
+                m_first = locked (static_cast<const ArrayReader &>(reader_).elementReader());
+            }
+            break;
+        case Kind::map_t : {
+            const auto & map = static_cast<const MapReader &>(reader_);
+            m_first = locked (map.keyReader());
+            m_second = locked (map.valueReader());
+            break;
+        }
+        default :
+            throw std::runtime_error (
+                "Cannot pull from a " + reader_.type()
+                    + ", it's not a composite, list, array or map");
+    }
+
+    decoder::is_described (m_cursor);
+
+    // onto the descriptor, which the reader already accounts for, then
+    // the list or map after it
+    m_cursor.enter();
+    m_cursor.next();
+    m_cursor.next();
+
+    if (m_composite) {
+        decoder::is_list (m_cursor);
+        m_count = m_composite->fieldCount();
+    } else if (m_kind == Kind::map_t) {
+        m_count = m_cursor.mapCount();
+    } else {
+        m_count = m_cursor.elementCount();
+    }
+
+    m_cursor.enter();
+}
+
+/******************************************************************************/
+
+/**
+ * Steps over whatever wasn't read and leaves the cursor on whatever
+ * follows the value, remembering it for any back references to it as
+ * visiting it would have. Nothing is moved if we're being destroyed by
+ * an exception, the bytes are likely malformed.
+ */
+amqp::internal::reader::
+Pull::~Pull() noexcept (false) {
+    if (!m_consumed || m_index < m_count) {
+        m_cursor.forget();
+    }
+
+    m_cursor.exit();
+    m_cursor.exit();
+
+    if (std::uncaught_exceptions() != m_exceptions) {
+        return;
+    }
+
+    if (m_replay) {
+        m_outer.next();
+    } else {
+        m_cursor.remember (m_raw);
+        m_cursor.next();
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Pull::next() {
+    if (!m_consumed) {
+        m_cursor.next();
+        m_cursor.forget();
+        m_consumed = true;
+    }
+
+    if (m_index == m_count) {
+        m_current = nullptr;
+        return false;
+    }
+
+    if (m_index == 0) {
+        m_cursor.next();
+    }
+
+    if (m_composite) {
+        auto field = m_composite->field (m_index);
+
+        if (!field) {
+            throw std::runtime_error (
+                "null field reader: " + m_composite->fieldName (m_index));
+        }
+
+        m_current = field.get();
+    } else {
+        m_current = (m_index % 2) && m_second ? m_second : m_first;
+    }
+
+    ++m_index;
+    m_consumed = false;
+
+    return true;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+Pull::name() const {
+    if (!m_composite || !m_current) {
+        return EMPTY;
+    }
+
+    return m_composite->fieldName (m_index - 1);
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::IReader &
+amqp::internal::reader::
+Pull::current() const {
+    if (!m_current) {
+        throw std::runtime_error ("Not on a value, call next() first");
+    }
+
+    return *m_current;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Pull::consume() {
+    if (m_consumed) {
+        throw std::runtime_error ("Not on a value, call next() first");
+    }
+
+    m_consumed = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Pull::mismatch (const char * as_) const {
+    auto field = name().empty() ? std::string { } : " " + name();
+
+    throw std::runtime_error (
+        "Cannot get " + current().type() + field + " as " + as_);
+}
+
+/******************************************************************************/
+
+template<>
+int32_t
+amqp::internal::reader::
+Pull::get<int32_t>() {
+    if (currentKind() != Kind::int_t) mismatch ("int32_t");
+
+    consume();
+
+    return static_cast<const IntPropertyReader *>(m_current)->get (m_cursor);
+}
+
+/******************************************************************************/
+
+template<>
+int64_t
+amqp::internal::reader::
+Pull::get<int64_t>() {
+    if (currentKind() != Kind::long_t) mismatch ("int64_t");
+
+    consume();
+
+    return static_cast<const LongPropertyReader *>(m_current)->get (m_cursor);
+}
+
+/******************************************************************************/
+
+template<>
+bool
+amqp::internal::reader::
+Pull::get<bool>() {
+    if (currentKind() != Kind::bool_t) mismatch ("bool");
+
+    consume();
+
+    return static_cast<const BoolPropertyReader *>(m_current)->get (m_cursor);
+}
+
+/******************************************************************************/
+
+template<>
+double
+amqp::internal::reader::
+Pull::get<double>() {
+    if (currentKind() != Kind::double_t) mismatch ("double");
+
+    consume();
+
+    return static_cast<const DoublePropertyReader *>(m_current)->get (m_cursor);
+}
+
+/******************************************************************************/
+
+/**
+ * The value we're on read by its reader, an [R]. Those the JVM remembers
+ * as elements, strings and dates say, are remembered within a list, array
+ * or map and may be back references themselves, as when visiting them.
+ */
+template<class R>
+auto
+amqp::internal::reader::
+Pull::read (Kind kind_, const char * as_) {
+    if (currentKind() != kind_) mismatch (as_);
+
+    consume();
+
+    const auto & reader = *static_cast<const R *>(m_current);
+
+    if (m_composite || !rememberedElement (reader)) {
+        return reader.get (m_cursor);
+    }
+
+    if (m_cursor.isReference()) {
+        decoder::Cursor replay (m_cursor.referenced(), m_cursor);
+        replay.next();
+
+        auto rtn = reader.get (replay);
+        m_cursor.next();
+
+        return rtn;
+    }
+
+    auto raw = m_cursor.raw();
+    auto rtn = reader.get (m_cursor);
+    m_cursor.remember (raw);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+template<>
+int8_t
+amqp::internal::reader::
+Pull::get<int8_t>() {
+    return read<BytePropertyReader> (Kind::byte_t, "int8_t");
+}
+
+/******************************************************************************/
+
+template<>
+int16_t
+amqp::internal::reader::
+Pull::get<int16_t>() {
+    return read<ShortPropertyReader> (Kind::short_t, "int16_t");
+}
+
+/******************************************************************************/
+
+template<>
+char32_t
+amqp::internal::reader::
+Pull::get<char32_t>() {
+    return read<CharPropertyReader> (Kind::char_t, "char32_t");
+}
+
+/******************************************************************************/
+
+template<>
+float
+amqp::internal::reader::
+Pull::get<float>() {
+    return read<FloatPropertyReader> (Kind::float_t, "float");
+}
+
+/******************************************************************************/
+
+template<>
+amqp::internal::decoder::Timestamp
+amqp::internal::reader::
+Pull::get<amqp::internal::decoder::Timestamp>() {
+    return read<TimestampPropertyReader> (Kind::timestamp_t, "decoder::Timestamp");
+}
+
+/******************************************************************************/
+
+template<>
+amqp::internal::decoder::Uuid
+amqp::internal::reader::
+Pull::get<amqp::internal::decoder::Uuid>() {
+    return read<UuidPropertyReader> (Kind::uuid_t, "decoder::Uuid");
+}
+
+/******************************************************************************/
+
+template<>
+amqp::internal::decoder::Binary
+amqp::internal::reader::
+Pull::get<amqp::internal::decoder::Binary>() {
+    return read<BinaryPropertyReader> (Kind::binary_t, "decoder::Binary");
+}
+
+/******************************************************************************/
+
+template<>
+amqp::internal::decoder::Decimal
+amqp::internal::reader::
+Pull::get<amqp::internal::decoder::Decimal>() {
+    return read<DecimalPropertyReader> (Kind::decimal_t, "decoder::Decimal");
+}
+
+/******************************************************************************/
+
+template<>
+std::string_view
+amqp::internal::reader::
+Pull::get<std::string_view>() {
+    switch (currentKind()) {
+        case Kind::enum_t :
+            consume();
+            return static_cast<const EnumReader *>(m_current)->get (m_cursor);
+        case Kind::symbol_t :
+            return read<SymbolPropertyReader> (Kind::symbol_t, "std::string_view");
+        default :
+            return read<StringPropertyReader> (Kind::string_t, "std::string_view");
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Pull
+amqp::internal::reader::
+Pull::enter() {
+    auto kind = currentKind();
+
+    if (kind != Kind::composite_t && kind != Kind::list_t && kind != Kind::map_t) {
+        mismatch ("a composite, list, array or map");
+    }
+
+    consume();
+
+    return Pull (*m_current, m_cursor);
+}
+
+/******************************************************************************/
@@ -0,0 +1,189 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "decoder/Cursor.h"
+#include "decoder/Scalars.h"
+#include "reader/Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    class CompositeReader;
+
+    /**
+     * The constant of an enum, told apart from a string when dispatching
+     */
+    struct Constant {
+        std::string_view m_name;
+    };
+
+    /**
+     * Pulls typed values out of a composite, list, array or map straight
+     * off the encoded bytes, for C++ code that wants the values themselves
+     * rather than JSON or a tree of IValues.
+     *
+     * next() moves onto each field, element, or key then value, in turn,
+     * get<T>() reads it as T, which must be what its reader reads, and
+     * enter() opens a Pull over it if it's a compound itself. dispatch()
+     * hands the value to a callable as whichever type its reader reads.
+     * Anything not read before moving on is stepped over.
+     *
+     * Nothing is boxed and, back references aside, nothing allocated.
+     * Strings are views into the blob. A Pull must be finished with, and
+     * so destroyed, before the one it was entered from carries on, after
+     * which the cursor is on whatever follows the value.
+     *
+     * Where the reader's type is known statically its own get reads the
+     * value without any checking at all.
+     */
+    class Pull {
+        public :
+            enum class Kind : uint8_t {
+                int_t, long_t, bool_t, double_t, string_t,
+                byte_t, short_t, char_t, float_t, timestamp_t,
+                uuid_t, binary_t, symbol_t, decimal_t,
+                enum_t, composite_t, list_t, map_t
+            };
+
+            static Kind kind (const IReader &);
+
+        private :
+            /**
+             * Over the object a back reference refers to rather than
+             * the one we were given
+             */
+            std::optional<decoder::Cursor> m_replay;
+            std::string_view m_raw;
+
+            decoder::Cursor & m_outer;
+            decoder::Cursor & m_cursor;
+
+            const IReader & m_reader;
+            const CompositeReader * m_composite;
+            Kind m_kind;
+
+            /**
+             * Of a list or array's elements, of a map's keys and values
+             */
+            const IReader * m_first;
+            const IReader * m_second;
+
+            size_t m_count;
+            size_t m_index;
+
+            const IReader * m_current;
+            bool m_consumed;
+
+            int m_exceptions;
+
+            decoder::Cursor & open (decoder::Cursor &);
+
+            void consume();
+
+            template<class R>
+            auto read (Kind, const char *);
+
+            [[noreturn]] void mismatch (const char *) const;
+
+        public :
+            /**
+             * With [cursor_] on the value [reader_] reads
+             */
+            Pull (const IReader & reader_, decoder::Cursor & cursor_);
+
+            Pull (const Pull &) = delete;
+            Pull & operator = (const Pull &) = delete;
+
+            ~Pull() noexcept (false);
+
+            const IReader & reader() const { return m_reader; }
+
+            /**
+             * Fields, elements, or keys and values counted separately
+             */
+            size_t size() const { return m_count; }
+
+            bool next();
+
+            /**
+             * The field we're on, empty outside of a composite
+             */
+            const std::string & name() const;
+
+            /**
+             * What reads the value we're on
+             */
+            const IReader & current() const;
+            Kind currentKind() const { return kind (current()); }
+
+            template<class T>
+            T get();
+
+            Pull enter();
+
+            template<class F>
+            void dispatch (F &&);
+    };
+
+    template<> int32_t Pull::get<int32_t>();
+    template<> int64_t Pull::get<int64_t>();
+    template<> bool Pull::get<bool>();
+    template<> double Pull::get<double>();
+    template<> int8_t Pull::get<int8_t>();
+    template<> int16_t Pull::get<int16_t>();
+    template<> char32_t Pull::get<char32_t>();
+    template<> float Pull::get<float>();
+    template<> decoder::Timestamp Pull::get<decoder::Timestamp>();
+    template<> decoder::Uuid Pull::get<decoder::Uuid>();
+    template<> decoder::Binary Pull::get<decoder::Binary>();
+    template<> decoder::Decimal Pull::get<decoder::Decimal>();
+
+    /**
+     * A string, a symbol or the name of an enum's constant
+     */
+    template<> std::string_view Pull::get<std::string_view>();
+
+}
+
+/******************************************************************************/
+
+/**
+ * [f_] is called with whatever get would return for the value, a
+ * Constant for an enum or, for a compound, a Pull & over it, so a
+ * generic lambda covers everything
+ */
+template<class F>
+void
+amqp::internal::reader::
+Pull::dispatch (F && f_) {
+    switch (currentKind()) {
+        case Kind::int_t : f_ (get<int32_t>()); break;
+        case Kind::long_t : f_ (get<int64_t>()); break;
+        case Kind::bool_t : f_ (get<bool>()); break;
+        case Kind::double_t : f_ (get<double>()); break;
+        case Kind::string_t : f_ (get<std::string_view>()); break;
+        case Kind::byte_t : f_ (get<int8_t>()); break;
+        case Kind::short_t : f_ (get<int16_t>()); break;
+        case Kind::char_t : f_ (get<char32_t>()); break;
+        case Kind::float_t : f_ (get<float>()); break;
+        case Kind::timestamp_t : f_ (get<decoder::Timestamp>()); break;
+        case Kind::uuid_t : f_ (get<decoder::Uuid>()); break;
+        case Kind::binary_t : f_ (get<decoder::Binary>()); break;
+        case Kind::symbol_t : f_ (get<std::string_view>()); break;
+        case Kind::decimal_t : f_ (get<decoder::Decimal>()); break;
+        case Kind::enum_t : f_ (Constant { get<std::string_view>() }); break;
+        default : {
+            Pull pull (enter());
+            f_ (pull);
+        }
+    }
+}
+
+/******************************************************************************/
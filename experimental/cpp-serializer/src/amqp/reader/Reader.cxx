@@ -1,106 +1,121 @@
 #include "Reader.h"
+#include "Sink.h"
 
+#include "decoder/Cursor.h"
+#include "reader/Profile.h"
+
+#include <array>
 #include <memory>
-#include <sstream>
+#include <algorithm>
 
 /******************************************************************************/
 
 namespace {
 
     struct AutoMap {
-        std::stringstream & m_stream;
+        amqp::reader::ISink & m_sink;
 
         AutoMap (
                 const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : { ";
+                amqp::reader::ISink & sink_
+        ) : m_sink (sink_) {
+            m_sink << s << " : { ";
         }
 
-        explicit AutoMap (std::stringstream & stream_)
-            : m_stream (stream_)
+        explicit AutoMap (amqp::reader::ISink & sink_)
+            : m_sink (sink_)
         {
-            m_stream << "{ ";
+            m_sink << "{ ";
         }
 
         ~AutoMap() {
-            m_stream << " }";
+            m_sink << " }";
         }
     };
 
     struct AutoList {
-        std::stringstream & m_stream;
+        amqp::reader::ISink & m_sink;
 
         AutoList (
                 const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : [ ";
+                amqp::reader::ISink & sink_
+        ) : m_sink (sink_) {
+            m_sink << s << " : [ ";
         }
 
-        explicit AutoList (std::stringstream & stream_)
-            : m_stream (stream_)
+        explicit AutoList (amqp::reader::ISink & sink_)
+            : m_sink (sink_)
         {
-            m_stream << "[ ";
+            m_sink << "[ ";
         }
 
         ~AutoList() {
-            m_stream << " ]";
+            m_sink << " ]";
         }
     };
 
-    template<class Auto, class T>
-    std::string
-    dumpPair (const std::string & name_, const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (name_, rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
+    template<class T>
+    void
+    dumpElements (const T & begin_, const T & end_, amqp::reader::ISink & sink_) {
+        if (begin_ != end_) {
+            (*(begin_))->dump (sink_);
+            for (auto it(std::next(begin_)); it != end_; ++it) {
+                sink_ << ", ";
+                (*it)->dump (sink_);
             }
         }
-
-        return rtn.str();
     }
 
     template<class Auto, class T>
-    std::string
-    dumpSingle (const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
-            }
-        }
+    void
+    dumpPair (
+        const std::string & name_,
+        const T & begin_,
+        const T & end_,
+        amqp::reader::ISink & sink_
+    ) {
+        Auto am (name_, sink_);
+        dumpElements (begin_, end_, sink_);
+    }
 
-        return rtn.str();
+    template<class Auto, class T>
+    void
+    dumpSingle (const T & begin_, const T & end_, amqp::reader::ISink & sink_) {
+        Auto am (sink_);
+        dumpElements (begin_, end_, sink_);
     }
 
 }
 
 /******************************************************************************
  *
- * amqp::internal::reader::TypedValuePair
+ * amqp::internal::reader::Value
  *
  ******************************************************************************/
 
 std::string
 amqp::internal::reader::
-ValuePair::dump() const {
-    std::stringstream ss;
+Value::dump() const {
+    std::string rtn;
+    StringSink sink (rtn);
 
-    ss << m_key->dump() << " : " << m_value->dump();
+    dump (sink);
 
-    return ss.str();
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::TypedValuePair
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::reader::
+ValuePair::dump (amqp::reader::ISink & sink_) const {
+    m_key->dump (sink_);
+    sink_ << " : ";
+    m_value->dump (sink_);
 }
 
 /******************************************************************************
@@ -110,31 +125,39 @@ ValuePair::dump() const {
  ******************************************************************************/
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end(), sink_);
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end(), sink_);
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end(), sink_);
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpPair<AutoList> (m_property, m_value.begin(), m_value.end());
+TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpPair<AutoList> (m_property, m_value.begin(), m_value.end(), sink_);
 }
 
 /******************************************************************************
@@ -144,31 +167,228 @@ TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const {
  ******************************************************************************/
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpSingle<AutoList> (m_value.begin(), m_value.end());
+TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpSingle<AutoList> (m_value.begin(), m_value.end(), sink_);
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpSingle<AutoMap> (m_value.begin(), m_value.end());
+TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpSingle<AutoMap> (m_value.begin(), m_value.end(), sink_);
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const {
-    return ::dumpSingle<AutoList> (m_value.begin(), m_value.end());
+TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpSingle<AutoList> (m_value.begin(), m_value.end(), sink_);
 }
 
 template<>
-std::string
+void
+amqp::internal::reader::
+TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump (
+    amqp::reader::ISink & sink_
+) const {
+    ::dumpSingle<AutoMap> (m_value.begin(), m_value.end(), sink_);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+dereference (
+    const IReader & reader_,
+    decoder::Cursor & cursor_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) {
+    if (!cursor_.isReference()) {
+        return false;
+    }
+
+    if (auto recorder = Recorder::of (visitor_)) {
+        if (recorder->replay (cursor_.reference())) {
+            cursor_.next();
+            return true;
+        }
+    }
+
+    decoder::Cursor replay (cursor_.referenced(), cursor_);
+    replay.next();
+
+    reader_.visit (replay, schema_, visitor_);
+
+    cursor_.next();
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const {
-    return ::dumpSingle<AutoMap> (m_value.begin(), m_value.end());
+visitRemembered (
+    const IReader & reader_,
+    decoder::Cursor & cursor_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) {
+    if (!dereference (reader_, cursor_, schema_, visitor_)) {
+        auto recorder = Recorder::of (visitor_);
+        auto begun = start (cursor_, recorder);
+        reader_.visit (cursor_, schema_, visitor_);
+        remember (cursor_, recorder, begun);
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Start
+amqp::internal::reader::
+start (const decoder::Cursor & cursor_, const Recorder * recorder_) {
+    return { cursor_.raw(), recorder_ ? recorder_->events() : 0 };
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+remember (decoder::Cursor & cursor_, Recorder * recorder_, const Start & start_) {
+    const auto object = cursor_.objects();
+
+    cursor_.remember (start_.m_raw);
+
+    if (recorder_ && cursor_.objects() > object) {
+        recorder_->remember (object, start_.m_event);
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+rememberedElement (const IReader & reader_) {
+    const auto & type = reader_.type();
+
+    return type == "string"
+        || type == "timestamp"
+        || type == "uuid"
+        || type == "symbol"
+        || type == "decimal32"
+        || type == "decimal64"
+        || type == "decimal128";
+}
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    /**
+     * The encoding the elements [reader_] reads are read a run at a
+     * time as, null_t for those that aren't
+     */
+    decoder::Type
+    runType (const reader::IReader & reader_) {
+        const auto & type = reader_.type();
+
+        if (type == "int") return decoder::Type::int_t;
+        if (type == "long") return decoder::Type::long_t;
+        if (type == "double") return decoder::Type::double_t;
+        if (type == "boolean") return decoder::Type::bool_t;
+        if (type == "short") return decoder::Type::short_t;
+        if (type == "byte") return decoder::Type::byte_t;
+        if (type == "float") return decoder::Type::float_t;
+
+        return decoder::Type::null_t;
+    }
+
+    template<class T>
+    void
+    visitRun (
+        decoder::Type type_,
+        const reader::IReader & reader_,
+        size_t count_,
+        decoder::Cursor & cursor_,
+        const reader::IReader::SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+    ) {
+        std::array<T, 64> run; // NOLINT
+
+        for (size_t i { 0 } ; i < count_ ; ) {
+            auto n = cursor_.readRun (type_, run.data(), std::min (run.size(), count_ - i));
+
+            if (n) {
+                visitor_.values (run.data(), n);
+            } else {
+                reader_.visit (cursor_, schema_, visitor_);
+                n = 1;
+            }
+
+            i += n;
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+runnable (const IReader & reader_) {
+    return runType (reader_) != decoder::Type::null_t;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+visitElements (
+    const IReader & reader_,
+    size_t count_,
+    decoder::Cursor & cursor_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) {
+    if (!Profile::enabled()) {
+        switch (auto type = runType (reader_)) {
+            case decoder::Type::int_t :
+            case decoder::Type::short_t :
+            case decoder::Type::byte_t :
+                return visitRun<int32_t> (type, reader_, count_, cursor_, schema_, visitor_);
+            case decoder::Type::long_t :
+                return visitRun<int64_t> (type, reader_, count_, cursor_, schema_, visitor_);
+            case decoder::Type::double_t :
+                return visitRun<double> (type, reader_, count_, cursor_, schema_, visitor_);
+            case decoder::Type::float_t :
+                return visitRun<float> (type, reader_, count_, cursor_, schema_, visitor_);
+            case decoder::Type::bool_t :
+                return visitRun<bool> (type, reader_, count_, cursor_, schema_, visitor_);
+            default :
+                break;
+        }
+    }
+
+    const bool remembered = rememberedElement (reader_);
+
+    for (size_t i { 0 } ; i < count_ ; ++i) {
+        if (remembered) {
+            visitRemembered (reader_, cursor_, schema_, visitor_);
+        } else {
+            reader_.visit (cursor_, schema_, visitor_);
+        }
+    }
 }
 
 /******************************************************************************/
@@ -2,22 +2,26 @@
 
 /******************************************************************************/
 
-#include <any>
 #include <list>
 #include <string>
 #include <vector>
 #include <memory>
+#include <string_view>
 
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/reader/IReader.h"
 
+#include "Json.h"
+#include "Recorder.h"
+
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
     class Value : public amqp::reader::IValue {
         public :
-            std::string dump() const override = 0;
+            std::string dump() const override;
+            void dump (amqp::reader::ISink &) const override = 0;
 
             ~Value() override = default;
     };
@@ -37,7 +41,8 @@ namespace amqp::internal::reader {
      */
     class Single : public Value {
         public :
-            std::string dump() const override = 0;
+            using Value::dump;
+            void dump (amqp::reader::ISink &) const override = 0;
 
             ~Single() override = default;
     };
@@ -67,7 +72,8 @@ namespace amqp::internal::reader {
                 return m_value;
             }
 
-            std::string dump() const override;
+            using Single::dump;
+            void dump (amqp::reader::ISink &) const override;
     };
 
     /*
@@ -91,7 +97,8 @@ namespace amqp::internal::reader {
                 : m_property (std::move (pair_.m_property))
             { }
 
-            std::string dump() const override = 0;
+            using Value::dump;
+            void dump (amqp::reader::ISink &) const override = 0;
     };
 
 
@@ -120,7 +127,8 @@ namespace amqp::internal::reader {
                 return m_value;
             }
 
-            std::string dump() const override;
+            using Pair::dump;
+            void dump (amqp::reader::ISink &) const override;
     };
 
     /**
@@ -143,7 +151,8 @@ namespace amqp::internal::reader {
               , m_value (std::move (value_))
         { }
 
-        std::string dump() const override;
+        using Value::dump;
+        void dump (amqp::reader::ISink &) const override;
     };
 
 }
@@ -155,38 +164,38 @@ namespace amqp::internal::reader {
  ******************************************************************************/
 
 template<typename T>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedSingle<T>::dump() const {
-    return std::to_string (m_value);
+TypedSingle<T>::dump (amqp::reader::ISink & sink_) const {
+    sink_ << json::number (m_value);
 }
 
 template<>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedSingle<std::string>::dump() const {
-    return m_value;
+TypedSingle<std::string>::dump (amqp::reader::ISink & sink_) const {
+    sink_ << m_value;
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump (amqp::reader::ISink &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump (amqp::reader::ISink &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const;
+TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump (amqp::reader::ISink &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const;
+TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump (amqp::reader::ISink &) const;
 
 /******************************************************************************
  *
@@ -195,38 +204,38 @@ TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const;
  ******************************************************************************/
 
 template<typename T>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedPair<T>::dump() const {
-    return m_property + " : " + std::to_string (m_value);
+TypedPair<T>::dump (amqp::reader::ISink & sink_) const {
+    sink_ << m_property << " : " << json::number (m_value);
 }
 
 template<>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedPair<std::string>::dump() const {
-    return m_property + " : " + m_value;
+TypedPair<std::string>::dump (amqp::reader::ISink & sink_) const {
+    sink_ << m_property << " : " << m_value;
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump (amqp::reader::ISink &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump (amqp::reader::ISink &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump() const;
+TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump (amqp::reader::ISink &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const;
+TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump (amqp::reader::ISink &) const;
 
 /******************************************************************************
  *
@@ -256,7 +265,6 @@ namespace amqp::internal::reader  {
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
 
-            std::any read (struct pn_data_t *) const override = 0;
             std::string readString (struct pn_data_t *) const override = 0;
 
             uPtr<amqp::reader::IValue> dump(
@@ -267,8 +275,89 @@ namespace amqp::internal::reader  {
             uPtr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override = 0;
+
+            void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
     };
 
+    /**
+     * The JVM writes any object other than a string or boxed primitive a
+     * second time as a back reference to the first. With the cursor on
+     * one, give the same output as if the object it refers to had been
+     * written out in full and move past it. When visiting through a
+     * Recorder that's a replay of what it recorded for the object,
+     * otherwise [reader_] visits the object's bytes again.
+     *
+     * Composites, lists, maps, arrays and enums call this before visiting
+     * and, through start and remember, remember themselves on the cursor
+     * once they've been visited.
+     *
+     * @return whether the cursor was on a reference
+     */
+    bool dereference (
+        const IReader & reader_,
+        decoder::Cursor &,
+        const IReader::SchemaType &,
+        amqp::reader::IVisitor &);
+
+    /**
+     * Where an object began, both in the blob and in what a Recorder, if
+     * there is one, has been told
+     */
+    struct Start {
+        std::string_view m_raw;
+        size_t m_event;
+    };
+
+    Start start (const decoder::Cursor &, const Recorder *);
+
+    /**
+     * With the object begun at [start_] visited, remember it on the
+     * cursor and, if the cursor took it, on [recorder_] under the same
+     * number
+     */
+    void remember (decoder::Cursor &, Recorder * recorder_, const Start & start_);
+
+    /**
+     * Strings are remembered, and so can be referred back to, only as
+     * elements of a collection, so collections visit their string
+     * elements through here
+     */
+    void visitRemembered (
+        const IReader & reader_,
+        decoder::Cursor &,
+        const IReader::SchemaType &,
+        amqp::reader::IVisitor &);
+
+    /**
+     * Whether the JVM remembers the values [reader_] reads when they're
+     * elements of a collection. Strings, dates, UUIDs, symbols and
+     * decimals are objects to it, boxed primitives and byte[] aren't.
+     */
+    bool rememberedElement (const IReader & reader_);
+
+    /**
+     * Whether visitElements reads the elements [reader_] reads a run at
+     * a time rather than one by one
+     */
+    bool runnable (const IReader & reader_);
+
+    /**
+     * The [count_] elements of a list or array, the cursor on the first
+     * of them. Runs of ints, longs, doubles and the like are read into a
+     * buffer a block at a time and handed over whole, falling back to a
+     * value at a time for anything a run can't take, a null say. As
+     * profiling counts every value it forces the latter.
+     */
+    void visitElements (
+        const IReader & reader_,
+        size_t count_,
+        decoder::Cursor &,
+        const IReader::SchemaType &,
+        amqp::reader::IVisitor &);
+
 }
 
 /******************************************************************************/
@@ -0,0 +1,361 @@
+#include "Recorder.h"
+
+#include <array>
+#include <cstring>
+#include <typeinfo>
+#include <algorithm>
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Recorder
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Recorder::Recorder (amqp::reader::IVisitor & visitor_)
+    : m_visitor (visitor_)
+{ }
+
+/******************************************************************************/
+
+/**
+ * The class is final so comparing types is enough, and cheaper than a
+ * dynamic_cast for every object read
+ */
+amqp::internal::reader::Recorder *
+amqp::internal::reader::
+Recorder::of (amqp::reader::IVisitor & visitor_) {
+    return typeid (visitor_) == typeid (Recorder)
+        ? static_cast<Recorder *>(&visitor_)
+        : nullptr;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::remember (size_t object_, size_t first_) {
+    if (object_ >= m_objects.size()) {
+        m_objects.resize (object_ + 1);
+    }
+
+    m_objects[object_] = { first_, m_events.size() };
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Recorder::replay (size_t object_) {
+    if (object_ >= m_objects.size()) {
+        return false;
+    }
+
+    auto [first, last] = m_objects[object_];
+
+    if (first == last) {
+        return false;
+    }
+
+    // recording as we go grows m_events, so copy each event out first
+    for (size_t i { first } ; i < last ; ++i) {
+        Event event = m_events[i];
+        replay (event);
+        m_events.push_back (event);
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+template<class T>
+void
+amqp::internal::reader::
+Recorder::replayRun (const Event & event_) {
+    std::array<T, 256> run; // NOLINT
+
+    for (size_t done { 0 } ; done < event_.m_size ; ) {
+        auto n = std::min (run.size(), event_.m_size - done);
+
+        std::memcpy (run.data(), m_bytes.data() + event_.m_offset + done * sizeof (T),
+                     n * sizeof (T));
+
+        m_visitor.values (run.data(), n);
+        done += n;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::replay (const Event & event_) {
+    std::string_view text (m_bytes.data() + event_.m_offset, event_.m_size);
+
+    switch (event_.m_kind) {
+        case Kind::startObject : m_visitor.startObject(); break;
+        case Kind::endObject   : m_visitor.endObject(); break;
+        case Kind::field       : m_visitor.field (text); break;
+        case Kind::startList   : m_visitor.startList(); break;
+        case Kind::endList     : m_visitor.endList(); break;
+        case Kind::startMap    : m_visitor.startMap(); break;
+        case Kind::endMap      : m_visitor.endMap(); break;
+        case Kind::boolean     : m_visitor.value (event_.m_bool); break;
+        case Kind::int32       : m_visitor.value (event_.m_int32); break;
+        case Kind::int64       : m_visitor.value (event_.m_int64); break;
+        case Kind::real        : m_visitor.value (event_.m_double); break;
+        case Kind::single      : m_visitor.value (event_.m_float); break;
+        case Kind::string      : m_visitor.value (text); break;
+        case Kind::binary      : m_visitor.binary (text); break;
+        case Kind::enumValue   : m_visitor.enumValue (text); break;
+        case Kind::booleans    : replayRun<bool> (event_); break;
+        case Kind::int32s      : replayRun<int32_t> (event_); break;
+        case Kind::int64s      : replayRun<int64_t> (event_); break;
+        case Kind::reals       : replayRun<double> (event_); break;
+        case Kind::singles     : replayRun<float> (event_); break;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::record (Kind kind_) {
+    Event event { };
+    event.m_kind = kind_;
+
+    m_events.push_back (event);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::record (Kind kind_, std::string_view text_) {
+    record (kind_, text_.data(), text_.size(), 1);
+}
+
+/******************************************************************************/
+
+/**
+ * Runs are copied in whole elements, 8 byte aligned so none straddles
+ * what came before
+ */
+void
+amqp::internal::reader::
+Recorder::record (Kind kind_, const void * data_, size_t count_, size_t width_) {
+    if (width_ > 1) {
+        m_bytes.resize ((m_bytes.size() + 7) & ~size_t { 7 });
+    }
+
+    Event event { };
+    event.m_kind = kind_;
+    event.m_offset = m_bytes.size();
+    event.m_size = count_;
+
+    m_bytes.append (static_cast<const char *>(data_), count_ * width_);
+    m_events.push_back (event);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::startObject() {
+    record (Kind::startObject);
+    m_visitor.startObject();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::endObject() {
+    record (Kind::endObject);
+    m_visitor.endObject();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::field (std::string_view name_) {
+    record (Kind::field, name_);
+    m_visitor.field (name_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::startList() {
+    record (Kind::startList);
+    m_visitor.startList();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::endList() {
+    record (Kind::endList);
+    m_visitor.endList();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::startMap() {
+    record (Kind::startMap);
+    m_visitor.startMap();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::endMap() {
+    record (Kind::endMap);
+    m_visitor.endMap();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::value (bool value_) {
+    Event event { };
+    event.m_kind = Kind::boolean;
+    event.m_bool = value_;
+
+    m_events.push_back (event);
+    m_visitor.value (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::value (int32_t value_) {
+    Event event { };
+    event.m_kind = Kind::int32;
+    event.m_int32 = value_;
+
+    m_events.push_back (event);
+    m_visitor.value (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::value (int64_t value_) {
+    Event event { };
+    event.m_kind = Kind::int64;
+    event.m_int64 = value_;
+
+    m_events.push_back (event);
+    m_visitor.value (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::value (double value_) {
+    Event event { };
+    event.m_kind = Kind::real;
+    event.m_double = value_;
+
+    m_events.push_back (event);
+    m_visitor.value (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::value (float value_) {
+    Event event { };
+    event.m_kind = Kind::single;
+    event.m_float = value_;
+
+    m_events.push_back (event);
+    m_visitor.value (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::value (std::string_view value_) {
+    record (Kind::string, value_);
+    m_visitor.value (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::binary (std::string_view value_) {
+    record (Kind::binary, value_);
+    m_visitor.binary (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::values (const bool * values_, size_t count_) {
+    record (Kind::booleans, values_, count_, sizeof (bool));
+    m_visitor.values (values_, count_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::values (const int32_t * values_, size_t count_) {
+    record (Kind::int32s, values_, count_, sizeof (int32_t));
+    m_visitor.values (values_, count_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::values (const int64_t * values_, size_t count_) {
+    record (Kind::int64s, values_, count_, sizeof (int64_t));
+    m_visitor.values (values_, count_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::values (const double * values_, size_t count_) {
+    record (Kind::reals, values_, count_, sizeof (double));
+    m_visitor.values (values_, count_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::values (const float * values_, size_t count_) {
+    record (Kind::singles, values_, count_, sizeof (float));
+    m_visitor.values (values_, count_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Recorder::enumValue (std::string_view value_) {
+    record (Kind::enumValue, value_);
+    m_visitor.enumValue (value_);
+}
+
+/******************************************************************************/
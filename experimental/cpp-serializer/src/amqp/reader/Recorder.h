@@ -0,0 +1,128 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Passes everything it's told on to another visitor and keeps a copy,
+     * so that when the blob refers back to an object already visited what
+     * was said about it can be said again rather than its bytes decoded
+     * a second time.
+     *
+     * Readers find the recorder through of. Each object they finish is
+     * marked against its number in the cursor's table with remember and
+     * a reference to it replayed by number. Replayed output is recorded
+     * too, an object holding a reference replays in full.
+     */
+    class Recorder final : public amqp::reader::IVisitor {
+        private :
+            enum class Kind : uint8_t {
+                startObject, endObject, field,
+                startList, endList, startMap, endMap,
+                boolean, int32, int64, real, single, string, binary,
+                enumValue, booleans, int32s, int64s, reals, singles
+            };
+
+            /**
+             * Text and runs live in m_bytes, an event holds where
+             */
+            struct Event {
+                Kind m_kind;
+                union {
+                    bool m_bool;
+                    int32_t m_int32;
+                    int64_t m_int64;
+                    double m_double;
+                    float m_float;
+                };
+                size_t m_offset;
+                size_t m_size;
+            };
+
+            amqp::reader::IVisitor & m_visitor;
+
+            std::vector<Event> m_events;
+            std::string m_bytes;
+
+            /**
+             * By object number the events, first and last, it produced.
+             * Empty for one visited without the recorder knowing.
+             */
+            std::vector<std::pair<size_t, size_t>> m_objects;
+
+            void record (Kind);
+            void record (Kind, std::string_view);
+            void record (Kind, const void *, size_t, size_t);
+
+            template<class T>
+            void replayRun (const Event &);
+
+            void replay (const Event &);
+
+        public :
+            explicit Recorder (amqp::reader::IVisitor &);
+
+            /**
+             * [visitor_] as a recorder if it is one
+             */
+            static Recorder * of (amqp::reader::IVisitor & visitor_);
+
+            /**
+             * How many events have been recorded so far
+             */
+            size_t events() const { return m_events.size(); }
+
+            /**
+             * Object [object_] is everything recorded since event [first_]
+             */
+            void remember (size_t object_, size_t first_);
+
+            /**
+             * Tell the visitor again what it was told about object
+             * [object_], false if that wasn't recorded
+             */
+            bool replay (size_t object_);
+
+            void startObject() override;
+            void endObject() override;
+
+            void field (std::string_view) override;
+
+            void startList() override;
+            void endList() override;
+
+            void startMap() override;
+            void endMap() override;
+
+            void value (bool) override;
+            void value (int32_t) override;
+            void value (int64_t) override;
+            void value (double) override;
+            void value (std::string_view) override;
+            void value (float) override;
+
+            void binary (std::string_view) override;
+
+            void values (const bool *, size_t) override;
+            void values (const int32_t *, size_t) override;
+            void values (const int64_t *, size_t) override;
+            void values (const double *, size_t) override;
+            void values (const float *, size_t) override;
+
+            void enumValue (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
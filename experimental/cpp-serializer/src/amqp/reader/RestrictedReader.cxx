@@ -24,14 +24,6 @@ RestrictedReader::m_name { // NOLINT
 
 /******************************************************************************/
 
-std::any
-amqp::internal::reader::
-RestrictedReader::read (pn_data_t *) const {
-    return std::any(1);
-}
-
-/******************************************************************************/
-
 std::string
 amqp::internal::reader::
 RestrictedReader::readString (pn_data_t * data_) const {
@@ -4,7 +4,6 @@
 
 #include "Reader.h"
 
-#include <any>
 #include <vector>
 
 #include "amqp/schema/restricted-types/Restricted.h"
@@ -26,8 +25,6 @@ namespace amqp::internal::reader {
             explicit RestrictedReader (std::string);
             ~RestrictedReader() override = default;
 
-            std::any read (pn_data_t *) const override ;
-
             std::string readString (pn_data_t *) const override;
 
             std::unique_ptr<amqp::reader::IValue> dump(
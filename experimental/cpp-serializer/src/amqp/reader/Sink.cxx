@@ -0,0 +1,102 @@
+#include "Sink.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    writeAll (int fd_, const char * bytes_, size_t size_) {
+        while (size_ > 0) {
+            auto written = ::write (fd_, bytes_, size_);
+
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error (
+                        std::string ("Failed to write: ") + std::strerror (errno));
+            }
+
+            bytes_ += written;
+            size_ -= static_cast<size_t>(written);
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::StringSink
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::reader::
+StringSink::write (const char * bytes_, size_t size_) {
+    m_buffer.append (bytes_, size_);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::FileSink
+ *
+ ******************************************************************************/
+
+void
+amqp::internal::reader::
+FileSink::write (const char * bytes_, size_t size_) {
+    if (std::fwrite (bytes_, 1, size_, m_file) != size_) {
+        throw std::runtime_error ("Failed to write");
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::FdSink
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+FdSink::~FdSink() {
+    try {
+        flush();
+    } catch (...) {
+        // nowhere left to report it
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+FdSink::write (const char * bytes_, size_t size_) {
+    if (m_used + size_ > m_buffer.size()) {
+        flush();
+
+        // too big to be worth buffering
+        if (size_ > m_buffer.size()) {
+            writeAll (m_fd, bytes_, size_);
+            return;
+        }
+    }
+
+    std::memcpy (m_buffer.data() + m_used, bytes_, size_);
+    m_used += size_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+FdSink::flush() {
+    auto used = m_used;
+    m_used = 0;
+
+    writeAll (m_fd, m_buffer.data(), used);
+}
+
+/******************************************************************************/
@@ -0,0 +1,76 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <string>
+#include <cstdio>
+
+#include "amqp/reader/ISink.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Appends to a caller owned string, reserve it up front to avoid
+     * any reallocation at all
+     */
+    class StringSink : public amqp::reader::ISink {
+        private :
+            std::string & m_buffer;
+
+        public :
+            explicit StringSink (std::string & buffer_)
+                : m_buffer (buffer_)
+            { }
+
+            void write (const char *, size_t) override;
+    };
+
+    /**
+     * Writes through stdio, which does its own buffering
+     */
+    class FileSink : public amqp::reader::ISink {
+        private :
+            FILE * m_file;
+
+        public :
+            explicit FileSink (FILE * file_)
+                : m_file (file_)
+            { }
+
+            void write (const char *, size_t) override;
+    };
+
+    /**
+     * Writes to a raw file descriptor. Output is gathered into a fixed
+     * buffer so we make one system call per buffer full rather than one
+     * per token; anything still buffered is written when the sink is
+     * flushed or destroyed.
+     */
+    class FdSink : public amqp::reader::ISink {
+        private :
+            int m_fd;
+            size_t m_used;
+            std::array<char, 64 * 1024> m_buffer;
+
+        public :
+            explicit FdSink (int fd_)
+                : m_fd (fd_)
+                , m_used (0)
+            { }
+
+            FdSink (const FdSink &) = delete;
+            FdSink & operator = (const FdSink &) = delete;
+
+            ~FdSink() override;
+
+            void write (const char *, size_t) override;
+
+            void flush();
+    };
+
+}
+
+/******************************************************************************/
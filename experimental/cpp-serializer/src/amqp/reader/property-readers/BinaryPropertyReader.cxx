@@ -0,0 +1,123 @@
+#include "BinaryPropertyReader.h"
+
+#include <string>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "decoder/Scalars.h"
+#include "amqp/reader/IReader.h"
+#include "reader/Profile.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    std::string
+    text (pn_data_t * data_) {
+        proton::auto_next an (data_);
+        auto bytes = pn_data_get_binary (data_);
+        return decoder::hex ({ bytes.start, bytes.size });
+    }
+
+}
+
+/******************************************************************************
+ *
+ * BinaryPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader::m_name { // NOLINT
+    "Binary Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader::m_type { // NOLINT
+    "binary"
+};
+
+/******************************************************************************
+ *
+ * BinaryPropertyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::Binary
+amqp::internal::reader::
+BinaryPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<decoder::Binary> (cursor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+BinaryPropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BinaryPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            "\"" + text (data_) + "\"");
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BinaryPropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+            "\"" + text (data_) + "\"");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+BinaryPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.binary (get (cursor_).m_bytes);
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -0,0 +1,49 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+#include "decoder/Scalars.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A byte[], the JVM writes no other array this way
+     */
+    class BinaryPropertyReader : public PropertyReader {
+    private :
+        static const std::string m_name;
+        static const std::string m_type;
+
+    public :
+        ~BinaryPropertyReader() override = default;
+
+        std::string readString (pn_data_t *) const override;
+
+        amqp::internal::decoder::Binary get (amqp::internal::decoder::Cursor &) const;
+
+        uPtr <amqp::reader::IValue> dump(
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &
+        ) const override;
+
+        uPtr <amqp::reader::IValue> dump(
+                pn_data_t *,
+                const SchemaType &
+        ) const override;
+
+        void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+        const std::string &name() const override;
+        const std::string &type() const override;
+    };
+}
+
+/******************************************************************************/
@@ -1,6 +1,8 @@
 #include "BoolPropertyReader.h"
 
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "reader/Profile.h"
 
 /******************************************************************************
  *
@@ -19,7 +21,7 @@ BoolPropertyReader::m_name { // NOLINT
 const std::string
 amqp::internal::reader::
 BoolPropertyReader::m_type { // NOLINT
-        "bool"
+        "boolean"
 };
 
 /******************************************************************************
@@ -28,10 +30,10 @@ BoolPropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
-std::any
+bool
 amqp::internal::reader::
-BoolPropertyReader::read (pn_data_t * data_) const {
-    return std::any (proton::readAndNext<bool> (data_));
+BoolPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<bool> (cursor_);
 }
 
 /******************************************************************************/
@@ -70,6 +72,20 @@ BoolPropertyReader::dump (
 
 /******************************************************************************/
 
+void
+amqp::internal::reader::
+BoolPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (get (cursor_));
+}
+
+/******************************************************************************/
+
 const std::string &
 amqp::internal::reader::
 BoolPropertyReader::name() const {
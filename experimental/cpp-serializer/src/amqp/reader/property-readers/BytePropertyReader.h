@@ -0,0 +1,44 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    class BytePropertyReader : public PropertyReader {
+    private :
+        static const std::string m_name;
+        static const std::string m_type;
+
+    public :
+        ~BytePropertyReader() override = default;
+
+        std::string readString (pn_data_t *) const override;
+
+        int8_t get (amqp::internal::decoder::Cursor &) const;
+
+        uPtr <amqp::reader::IValue> dump(
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &
+        ) const override;
+
+        uPtr <amqp::reader::IValue> dump(
+                pn_data_t *,
+                const SchemaType &
+        ) const override;
+
+        void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+        const std::string &name() const override;
+        const std::string &type() const override;
+    };
+}
+
+/******************************************************************************/
@@ -0,0 +1,123 @@
+#include "CharPropertyReader.h"
+
+#include <string>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "decoder/Scalars.h"
+#include "amqp/reader/IReader.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    std::string
+    text (pn_data_t * data_) {
+        proton::auto_next an (data_);
+        return std::string (decoder::text (char32_t { pn_data_get_char (data_) }).view());
+    }
+
+}
+
+/******************************************************************************
+ *
+ * CharPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+CharPropertyReader::m_name { // NOLINT
+    "Char Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+CharPropertyReader::m_type { // NOLINT
+    "char"
+};
+
+/******************************************************************************
+ *
+ * CharPropertyReader
+ *
+ ******************************************************************************/
+
+char32_t
+amqp::internal::reader::
+CharPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<char32_t> (cursor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+CharPropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+CharPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            json::quote (text (data_)));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+CharPropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+            json::quote (text (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CharPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (decoder::text (get (cursor_)).view());
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+CharPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+CharPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
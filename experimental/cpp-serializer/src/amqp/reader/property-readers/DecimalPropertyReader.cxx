@@ -0,0 +1,188 @@
+#include "DecimalPropertyReader.h"
+
+#include <string>
+#include <stdexcept>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "amqp/reader/IReader.h"
+#include "reader/Profile.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    uint64_t
+    bigEndian (const char * bytes_) {
+        uint64_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < 8 ; ++i) {
+            rtn = (rtn << 8) | static_cast<uint8_t>(bytes_[i]);
+        }
+
+        return rtn;
+    }
+
+    std::string
+    text (pn_data_t * data_) {
+        proton::auto_next an (data_);
+
+        decoder::Decimal decimal { decoder::Type::null_t, 0, 0 };
+
+        switch (pn_data_type (data_)) {
+            case PN_DECIMAL32 :
+                decimal = { decoder::Type::decimal32_t, 0, pn_data_get_decimal32 (data_) };
+                break;
+            case PN_DECIMAL64 :
+                decimal = { decoder::Type::decimal64_t, 0, pn_data_get_decimal64 (data_) };
+                break;
+            case PN_DECIMAL128 : {
+                auto bytes = pn_data_get_decimal128 (data_);
+                decimal = {
+                    decoder::Type::decimal128_t,
+                    bigEndian (bytes.bytes),
+                    bigEndian (bytes.bytes + 8) };
+                break;
+            }
+            default :
+                break;
+        }
+
+        return std::string (decoder::text (decimal).view());
+    }
+
+}
+
+/******************************************************************************
+ *
+ * DecimalPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+DecimalPropertyReader::m_name { // NOLINT
+    "Decimal Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+DecimalPropertyReader::m_decimal32 { // NOLINT
+    "decimal32"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+DecimalPropertyReader::m_decimal64 { // NOLINT
+    "decimal64"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+DecimalPropertyReader::m_decimal128 { // NOLINT
+    "decimal128"
+};
+
+/******************************************************************************
+ *
+ * DecimalPropertyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+DecimalPropertyReader::DecimalPropertyReader (decoder::Type type_)
+    : m_type (type_ == decoder::Type::decimal32_t
+        ? m_decimal32
+        : type_ == decoder::Type::decimal64_t ? m_decimal64 : m_decimal128)
+{
+    if (type_ != decoder::Type::decimal32_t
+        && type_ != decoder::Type::decimal64_t
+        && type_ != decoder::Type::decimal128_t)
+    {
+        throw std::runtime_error (
+            "Not a decimal: " + std::string (decoder::typeName (type_)));
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Decimal
+amqp::internal::reader::
+DecimalPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<decoder::Decimal> (cursor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+DecimalPropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+DecimalPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            "\"" + text (data_) + "\"");
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+DecimalPropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+            "\"" + text (data_) + "\"");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+DecimalPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (decoder::text (get (cursor_)).view());
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+DecimalPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+DecimalPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
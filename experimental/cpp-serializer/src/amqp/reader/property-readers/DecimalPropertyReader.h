@@ -0,0 +1,56 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+#include "decoder/Scalars.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * One reader for each of decimal32, decimal64 and decimal128, they
+     * differ only in width and all go out as text, BigDecimal's form of
+     * them, so nothing is lost to a double
+     */
+    class DecimalPropertyReader : public PropertyReader {
+    private :
+        static const std::string m_name;
+        static const std::string m_decimal32;
+        static const std::string m_decimal64;
+        static const std::string m_decimal128;
+
+        const std::string & m_type;
+
+    public :
+        explicit DecimalPropertyReader (amqp::internal::decoder::Type);
+        ~DecimalPropertyReader() override = default;
+
+        std::string readString (pn_data_t *) const override;
+
+        amqp::internal::decoder::Decimal get (amqp::internal::decoder::Cursor &) const;
+
+        uPtr <amqp::reader::IValue> dump(
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &
+        ) const override;
+
+        uPtr <amqp::reader::IValue> dump(
+                pn_data_t *,
+                const SchemaType &
+        ) const override;
+
+        void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+        const std::string &name() const override;
+        const std::string &type() const override;
+    };
+}
+
+/******************************************************************************/
@@ -1,6 +1,9 @@
 #include "DoublePropertyReader.h"
 
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
 
 /******************************************************************************
  *
@@ -26,10 +29,10 @@ DoublePropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
-std::any
+double
 amqp::internal::reader::
-DoublePropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<double> (data_) };
+DoublePropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<double> (cursor_);
 }
 
 /******************************************************************************/
@@ -37,7 +40,7 @@ DoublePropertyReader::read (pn_data_t * data_) const {
 std::string
 amqp::internal::reader::
 DoublePropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<double> (data_));
+    return json::number (proton::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
@@ -51,7 +54,7 @@ DoublePropertyReader::dump (
 {
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<double> (data_)));
+            json::number (proton::readAndNext<double> (data_)));
 }
 
 /******************************************************************************/
@@ -63,7 +66,21 @@ DoublePropertyReader::dump (
         const SchemaType & schema_) const
 {
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<double> (data_)));
+            json::number (proton::readAndNext<double> (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+DoublePropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (get (cursor_));
 }
 
 /******************************************************************************/
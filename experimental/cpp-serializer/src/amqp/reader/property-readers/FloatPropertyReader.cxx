@@ -0,0 +1,122 @@
+#include "FloatPropertyReader.h"
+
+#include <string>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "amqp/reader/IReader.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    std::string
+    text (pn_data_t * data_) {
+        proton::auto_next an (data_);
+        return reader::json::number (pn_data_get_float (data_));
+    }
+
+}
+
+/******************************************************************************
+ *
+ * FloatPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+FloatPropertyReader::m_name { // NOLINT
+    "Float Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+FloatPropertyReader::m_type { // NOLINT
+    "float"
+};
+
+/******************************************************************************
+ *
+ * FloatPropertyReader
+ *
+ ******************************************************************************/
+
+float
+amqp::internal::reader::
+FloatPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<float> (cursor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+FloatPropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+FloatPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            text (data_));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+FloatPropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+            text (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+FloatPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (get (cursor_));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+FloatPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+FloatPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -1,12 +1,14 @@
 
 #include "IntPropertyReader.h"
 
-#include <any>
 #include <string>
 #include <proton/codec.h>
 
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
 #include "amqp/reader/IReader.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
 
 /******************************************************************************
  *
@@ -34,10 +36,10 @@ IntPropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
-std::any
+int32_t
 amqp::internal::reader::
-IntPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<int> (data_) };
+IntPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<int32_t> (cursor_);
 }
 
 /******************************************************************************/
@@ -45,7 +47,7 @@ IntPropertyReader::read (pn_data_t * data_) const {
 std::string
 amqp::internal::reader::
 IntPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<int> (data_));
+    return json::number (proton::readAndNext<int> (data_));
 }
 
 /******************************************************************************/
@@ -59,7 +61,7 @@ IntPropertyReader::dump (
 {
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<int> (data_)));
+            json::number (proton::readAndNext<int> (data_)));
 }
 
 /******************************************************************************/
@@ -71,7 +73,21 @@ IntPropertyReader::dump (
     const SchemaType & schema_) const
 {
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<int> (data_)));
+            json::number (proton::readAndNext<int> (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+IntPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (get (cursor_));
 }
 
 /******************************************************************************/
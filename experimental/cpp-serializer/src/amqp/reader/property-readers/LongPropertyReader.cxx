@@ -1,6 +1,9 @@
 #include "LongPropertyReader.h"
 
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
 
 /******************************************************************************
  *
@@ -28,10 +31,10 @@ LongPropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
-std::any
+int64_t
 amqp::internal::reader::
-LongPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<long> (data_) };
+LongPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<int64_t> (cursor_);
 }
 
 /******************************************************************************/
@@ -39,7 +42,7 @@ LongPropertyReader::read (pn_data_t * data_) const {
 std::string
 amqp::internal::reader::
 LongPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<long> (data_));
+    return json::number (static_cast<int64_t>(proton::readAndNext<long> (data_)));
 }
 
 /******************************************************************************/
@@ -53,7 +56,7 @@ LongPropertyReader::dump (
 {
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            std::to_string (proton::readAndNext<long> (data_)));
+            json::number (static_cast<int64_t>(proton::readAndNext<long> (data_))));
 }
 
 /******************************************************************************/
@@ -65,7 +68,21 @@ LongPropertyReader::dump (
     const SchemaType & schema_) const
 {
     return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<long> (data_)));
+            json::number (static_cast<int64_t>(proton::readAndNext<long> (data_))));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+LongPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (get (cursor_));
 }
 
 /******************************************************************************/
@@ -3,6 +3,9 @@
 #include <proton/codec.h>
 
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
 
 /******************************************************************************
  *
@@ -30,10 +33,10 @@ StringPropertyReader::m_name { // NOLINT
  *
  ******************************************************************************/
 
-std::any
+std::string_view
 amqp::internal::reader::
-StringPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<std::string> (data_) };
+StringPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<std::string_view> (cursor_);
 }
 
 /******************************************************************************/
@@ -55,7 +58,7 @@ StringPropertyReader::dump (
 {
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            json::quote (proton::readAndNext<std::string> (data_)));
 }
 
 /******************************************************************************/
@@ -67,7 +70,21 @@ StringPropertyReader::dump (
         const SchemaType & schema_) const
 {
     return std::make_unique<TypedSingle<std::string>> (
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            json::quote (proton::readAndNext<std::string> (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StringPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (get (cursor_));
 }
 
 /******************************************************************************/
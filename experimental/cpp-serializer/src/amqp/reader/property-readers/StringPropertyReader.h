@@ -16,7 +16,7 @@ namespace amqp::internal::reader {
         public :
             std::string readString (pn_data_t *) const override;
 
-            std::any read (pn_data_t *) const override;
+            std::string_view get (amqp::internal::decoder::Cursor &) const;
 
             uPtr<amqp::reader::IValue> dump (
                 const std::string &,
@@ -29,6 +29,11 @@ namespace amqp::internal::reader {
                 const SchemaType &
             ) const override;
 
+            void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
             const std::string & name() const override;
             const std::string & type() const override;
     };
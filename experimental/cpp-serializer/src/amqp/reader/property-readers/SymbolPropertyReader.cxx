@@ -0,0 +1,119 @@
+#include "SymbolPropertyReader.h"
+
+#include <string>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "amqp/reader/IReader.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    text (pn_data_t * data_) {
+        return proton::readAndNext<std::string> (data_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * SymbolPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+SymbolPropertyReader::m_name { // NOLINT
+    "Symbol Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+SymbolPropertyReader::m_type { // NOLINT
+    "symbol"
+};
+
+/******************************************************************************
+ *
+ * SymbolPropertyReader
+ *
+ ******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+SymbolPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<std::string_view> (cursor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+SymbolPropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+SymbolPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            json::quote (text (data_)));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+SymbolPropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+            json::quote (text (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+SymbolPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (get (cursor_));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+SymbolPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+SymbolPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -0,0 +1,123 @@
+#include "TimestampPropertyReader.h"
+
+#include <string>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "decoder/Scalars.h"
+#include "amqp/reader/IReader.h"
+#include "reader/Json.h"
+#include "reader/Profile.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    std::string
+    text (pn_data_t * data_) {
+        proton::auto_next an (data_);
+        return reader::json::number (pn_data_get_timestamp (data_));
+    }
+
+}
+
+/******************************************************************************
+ *
+ * TimestampPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+TimestampPropertyReader::m_name { // NOLINT
+    "Timestamp Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+TimestampPropertyReader::m_type { // NOLINT
+    "timestamp"
+};
+
+/******************************************************************************
+ *
+ * TimestampPropertyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::Timestamp
+amqp::internal::reader::
+TimestampPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<decoder::Timestamp> (cursor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+TimestampPropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+TimestampPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            text (data_));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+TimestampPropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+            text (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TimestampPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (int64_t { get (cursor_).time_since_epoch().count() });
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+TimestampPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+TimestampPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -0,0 +1,128 @@
+#include "UuidPropertyReader.h"
+
+#include <cstring>
+#include <string>
+#include <proton/codec.h>
+
+#include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "decoder/Scalars.h"
+#include "amqp/reader/IReader.h"
+#include "reader/Profile.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    std::string
+    text (pn_data_t * data_) {
+        proton::auto_next an (data_);
+        auto uuid = pn_data_get_uuid (data_);
+
+        decoder::Uuid rtn { };
+        std::memcpy (rtn.m_bytes.data(), uuid.bytes, rtn.m_bytes.size());
+
+        return std::string (decoder::text (rtn).view());
+    }
+
+}
+
+/******************************************************************************
+ *
+ * UuidPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+UuidPropertyReader::m_name { // NOLINT
+    "UUID Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+UuidPropertyReader::m_type { // NOLINT
+    "uuid"
+};
+
+/******************************************************************************
+ *
+ * UuidPropertyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::Uuid
+amqp::internal::reader::
+UuidPropertyReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    return decoder::readAndNext<decoder::Uuid> (cursor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+UuidPropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+UuidPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+            name_,
+            "\"" + text (data_) + "\"");
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+UuidPropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+            "\"" + text (data_) + "\"");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+UuidPropertyReader::visit (
+    amqp::internal::decoder::Cursor & cursor_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
+{
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.value (decoder::text (get (cursor_)).view());
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+UuidPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+UuidPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -4,6 +4,8 @@
 #include "amqp/schema/Descriptors.h"
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "reader/Profile.h"
 
 /******************************************************************************/
 
@@ -21,7 +23,10 @@ EnumReader::EnumReader (
 
 namespace {
 
-    std::string
+    /**
+     * The view is into the proton tree so is only good as long as it is
+     */
+    std::string_view
     getValue (pn_data_t * data_) {
         proton::is_described (data_);
 
@@ -31,8 +36,9 @@ namespace {
             /*
              * Referenced objects are added to a stream when the serialiser
              * notices it's writing a value it's already written, so to save
-             * space it will just link back to that. Currently we have
-             * no mechanism for decoding that so just throw an error
+             * space it will just link back to that. Resolving one needs
+             * the table of objects read so far that only a Cursor keeps,
+             * so reading through proton we can only throw an error
              */
             if (pn_data_type (data_) == PN_ULONG) {
                 if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
@@ -43,11 +49,11 @@ namespace {
                 }
             }
 
-            auto fingerprint = proton::readAndNext<std::string>(data_);
+            pn_data_next (data_);
 
             proton::auto_list_enter ale (data_, true);
 
-            return proton::readAndNext<std::string>(data_);
+            return proton::readAndNext<std::string_view>(data_);
 
             /*
              * After a string representation of the enumerated value
@@ -58,6 +64,26 @@ namespace {
             // auto idx = proton::readAndNext<int>(data_);
         }
     }
+
+    /**
+     * As above but reading the encoded bytes in place, the view is into
+     * the buffer the cursor walks. References never reach here, get
+     * resolves them against the cursor's table first.
+     */
+    std::string_view
+    getValue (amqp::internal::decoder::Cursor & cursor_) {
+        namespace decoder = amqp::internal::decoder;
+
+        decoder::is_described (cursor_);
+
+        decoder::auto_enter ae (cursor_);
+
+        cursor_.next();
+
+        decoder::auto_list_enter ale (cursor_, true);
+
+        return decoder::readAndNext<std::string_view> (cursor_);
+    }
 }
 
 /******************************************************************************/
@@ -74,7 +100,7 @@ EnumReader::dump (
 
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            getValue(data_));
+            std::string (getValue(data_)));
 }
 
 /******************************************************************************/
@@ -88,7 +114,49 @@ EnumReader::dump(
     proton::auto_next an (data_);
     proton::is_described (data_);
 
-    return std::make_unique<TypedSingle<std::string>> (getValue(data_));
+    return std::make_unique<TypedSingle<std::string>> (
+            std::string (getValue(data_)));
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+EnumReader::get (amqp::internal::decoder::Cursor & cursor_) const {
+    if (cursor_.isReference()) {
+        decoder::Cursor replay (cursor_.referenced(), cursor_);
+        replay.next();
+
+        auto rtn = getValue (replay);
+
+        cursor_.next();
+
+        return rtn;
+    }
+
+    auto raw = cursor_.raw();
+
+    decoder::auto_next an (cursor_);
+
+    auto rtn = getValue (cursor_);
+
+    cursor_.remember (raw);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+EnumReader::visit (
+        amqp::internal::decoder::Cursor & cursor_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    Profile::Scope scope (type(), cursor_);
+
+    visitor_.enumValue (get (cursor_));
 }
 
 /******************************************************************************/
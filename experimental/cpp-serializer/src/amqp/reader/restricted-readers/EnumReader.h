@@ -12,6 +12,15 @@ namespace amqp::internal::reader {
         public :
             EnumReader (std::string, std::vector<std::string>);
 
+            const std::vector<std::string> & choices() const { return m_choices; }
+
+            /**
+             * The name of the constant the cursor's on, following it if
+             * it's a back reference. The view is into the buffer the
+             * cursor walks.
+             */
+            std::string_view get (amqp::internal::decoder::Cursor &) const;
+
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
                 pn_data_t *,
@@ -20,6 +29,11 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
     };
 
 }
@@ -1,6 +1,8 @@
 #include "ListReader.h"
 
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "reader/Profile.h"
 
 /******************************************************************************
  *
@@ -58,7 +60,7 @@ ListReader::dump_(
 
     {
         proton::auto_enter ae (data_);
-        schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+        schema_.fromDescriptor (proton::readAndNext<std::string_view>(data_));
 
         {
             proton::auto_list_enter ale (data_, true);
@@ -73,3 +75,43 @@ ListReader::dump_(
 }
 
 /******************************************************************************/
+
+/**
+ * As with dump_ we don't need anything from the schema, the type of the
+ * elements was fixed when this reader was built
+ */
+void
+amqp::internal::reader::
+ListReader::visit (
+        amqp::internal::decoder::Cursor & cursor_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    Profile::Scope scope (type(), cursor_);
+
+    if (dereference (*this, cursor_, schema_, visitor_)) {
+        return;
+    }
+
+    auto recorder = Recorder::of (visitor_);
+    auto begun = start (cursor_, recorder);
+
+    decoder::auto_next an (cursor_);
+    decoder::is_described (cursor_);
+
+    visitor_.startList();
+    {
+        decoder::auto_enter ae (cursor_);
+        cursor_.next();
+
+        auto reader = m_reader.lock();
+        decoder::auto_list_enter ale (cursor_, true);
+
+        visitElements (*reader, ale.elements(), cursor_, schema_, visitor_);
+    }
+    visitor_.endList();
+
+    remember (cursor_, recorder, begun);
+}
+
+/******************************************************************************/
@@ -29,6 +29,8 @@ namespace amqp::internal::reader {
 
             internal::schema::Restricted::RestrictedTypes restrictedType() const;
 
+            std::shared_ptr<Reader> elementReader() const { return m_reader.lock(); }
+
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
                 pn_data_t *,
@@ -37,6 +39,11 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
     };
 
 }
@@ -3,6 +3,8 @@
 #include "Reader.h"
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
+#include "decoder/Cursor.h"
+#include "reader/Profile.h"
 
 /******************************************************************************/
 
@@ -28,7 +30,7 @@ MapReader::dump_(
     // and don't need context from the schema as there isn't
     // any. Maps have a Key and a Value, they aren't named
     // parameters, unlike composite types.
-    schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+    schema_.fromDescriptor (proton::readAndNext<std::string_view>(data_));
 
     {
         proton::auto_map_enter am (data_, true);
@@ -37,9 +39,10 @@ MapReader::dump_(
         rtn.reserve (am.elements() / 2);
 
         for (int i {0} ; i < am.elements() ; i += 2) {
+            auto key = m_keyReader.lock()->dump (data_, schema_);
             rtn.emplace_back (
                 std::make_unique<ValuePair> (
-                    m_keyReader.lock()->dump (data_, schema_),
+                    std::move (key),
                     m_valueReader.lock()->dump (data_, schema_)
                 )
             );
@@ -80,3 +83,55 @@ MapReader::dump(
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+MapReader::visit (
+        amqp::internal::decoder::Cursor & cursor_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    Profile::Scope scope (type(), cursor_);
+
+    if (dereference (*this, cursor_, schema_, visitor_)) {
+        return;
+    }
+
+    auto recorder = Recorder::of (visitor_);
+    auto begun = start (cursor_, recorder);
+
+    decoder::auto_next an (cursor_);
+    decoder::is_described (cursor_);
+
+    visitor_.startMap();
+    {
+        decoder::auto_enter ae (cursor_);
+        cursor_.next();
+
+        auto keyReader = m_keyReader.lock();
+        auto valueReader = m_valueReader.lock();
+        decoder::auto_map_enter am (cursor_, true);
+
+        const bool rememberedKeys = rememberedElement (*keyReader);
+        const bool rememberedValues = rememberedElement (*valueReader);
+
+        for (size_t i { 0 } ; i < am.elements() ; i += 2) {
+            if (rememberedKeys) {
+                visitRemembered (*keyReader, cursor_, schema_, visitor_);
+            } else {
+                keyReader->visit (cursor_, schema_, visitor_);
+            }
+
+            if (rememberedValues) {
+                visitRemembered (*valueReader, cursor_, schema_, visitor_);
+            } else {
+                valueReader->visit (cursor_, schema_, visitor_);
+            }
+        }
+    }
+    visitor_.endMap();
+
+    remember (cursor_, recorder, begun);
+}
+
+/******************************************************************************/
@@ -32,6 +32,9 @@ namespace amqp::internal::reader {
 
             internal::schema::Restricted::RestrictedTypes restrictedType() const;
 
+            std::shared_ptr<Reader> keyReader() const { return m_keyReader.lock(); }
+            std::shared_ptr<Reader> valueReader() const { return m_valueReader.lock(); }
+
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
                 pn_data_t *,
@@ -40,6 +43,11 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            void visit (
+                amqp::internal::decoder::Cursor &,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
     };
 
 }
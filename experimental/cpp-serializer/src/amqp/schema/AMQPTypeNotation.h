@@ -53,7 +53,7 @@ namespace amqp::internal::schema {
 
             const std::string & descriptor() const;
 
-            const std::string & name() const;
+            const std::string & name() const override;
 
             virtual Type type() const = 0;
 
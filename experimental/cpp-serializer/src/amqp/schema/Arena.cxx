@@ -0,0 +1,107 @@
+#include "Arena.h"
+
+#include <new>
+
+#include "amqp/AMQPDescribed.h"
+
+/******************************************************************************/
+
+namespace {
+
+    thread_local std::pmr::memory_resource * t_current = nullptr;
+
+    /**
+     * Every described type carries a record of where it came from just
+     * ahead of it so delete can hand it back to the right place. Padded
+     * out so the object itself keeps new's usual alignment.
+     */
+    struct alignas (alignof (std::max_align_t)) Header {
+        std::pmr::memory_resource * m_resource;
+        std::size_t m_size;
+    };
+
+    /**
+     * Block size the arena starts with, enough for a small schema in one
+     * allocation, it grows geometrically from there
+     */
+    constexpr std::size_t INITIAL_BLOCK = 16 * 1024;
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::Arena
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Arena::Arena (std::pmr::memory_resource * upstream_)
+    : m_resource (INITIAL_BLOCK, upstream_)
+{
+}
+
+/******************************************************************************/
+
+std::pmr::memory_resource *
+amqp::internal::schema::
+Arena::current() {
+    return t_current;
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Arena::Scope::Scope (Arena & arena_)
+    : m_previous (t_current)
+{
+    t_current = arena_.resource();
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Arena::Scope::~Scope() {
+    t_current = m_previous;
+}
+
+/******************************************************************************
+ *
+ * amqp::AMQPDescribed
+ *
+ ******************************************************************************/
+
+void *
+amqp::
+AMQPDescribed::operator new (std::size_t size_) {
+    const auto size = sizeof (Header) + size_;
+
+    void * memory = t_current
+        ? t_current->allocate (size, alignof (Header))
+        : ::operator new (size);
+
+    auto header = new (memory) Header { t_current, size };
+
+    return header + 1;
+}
+
+/******************************************************************************/
+
+/**
+ * Returning memory to a monotonic resource is a no-op, it's all released
+ * when the arena goes
+ */
+void
+amqp::
+AMQPDescribed::operator delete (void * ptr_) noexcept {
+    if (!ptr_) return;
+
+    auto header = static_cast<Header *>(ptr_) - 1;
+
+    if (header->m_resource) {
+        header->m_resource->deallocate (header, header->m_size, alignof (Header));
+    } else {
+        ::operator delete (header);
+    }
+}
+
+/******************************************************************************/
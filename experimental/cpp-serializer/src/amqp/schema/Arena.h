@@ -0,0 +1,56 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+#include <memory_resource>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A monotonic memory resource the schema graph is allocated from, so
+     * building a schema of hundreds of types costs a handful of block
+     * allocations rather than one per type, field and descriptor, and
+     * freeing it costs the same.
+     *
+     * An arena is installed for the current thread with a Scope, every
+     * described type built while it's in place comes from it. Whoever
+     * owns the resulting graph, an Envelope or a free standing Schema,
+     * owns the arena and must destroy it after the graph.
+     */
+    class Arena {
+        private :
+            std::pmr::monotonic_buffer_resource m_resource;
+
+        public :
+            explicit Arena (
+                std::pmr::memory_resource * = std::pmr::new_delete_resource());
+
+            Arena (const Arena &) = delete;
+            Arena & operator = (const Arena &) = delete;
+
+            std::pmr::memory_resource * resource() { return &m_resource; }
+
+            /**
+             * The arena in scope on this thread, if any
+             */
+            static std::pmr::memory_resource * current();
+
+            class Scope {
+                private :
+                    std::pmr::memory_resource * m_previous;
+
+                public :
+                    explicit Scope (Arena &);
+                    ~Scope();
+
+                    Scope (const Scope &) = delete;
+                    Scope & operator = (const Scope &) = delete;
+            };
+    };
+
+}
+
+/******************************************************************************/
@@ -1,8 +1,11 @@
 #pragma once
 
-#include <list>
+#include <string>
+#include <vector>
 #include <ostream>
 #include <iostream>
+#include <string_view>
+#include <unordered_map>
 
 #include "debug.h"
 #include "types.h"
@@ -36,6 +39,15 @@ namespace amqp::internal::schema {
         public :
             virtual ~OrderedTypeNotation() = default;
 
+            virtual const std::string & name() const = 0;
+
+            /**
+             * Appends the names of the types that must be ordered ahead of
+             * this one, names that aren't part of the set being ordered
+             * (primitives for instance) are simply ignored
+             */
+            virtual void dependencies (std::vector<std::string_view> &) const = 0;
+
             virtual int dependsOn (const OrderedTypeNotation &) const = 0;
     };
 
@@ -45,34 +57,116 @@ namespace amqp::internal::schema {
 
 namespace amqp::internal::schema {
 
+    /**
+     * Orders a set of types so that every type comes after all of the
+     * types it depends on, grouped into levels where a type's level is
+     * one past the deepest of its dependencies.
+     *
+     * Types are collected by insert and sorted all at once the first
+     * time the set is iterated, a Kahn style topological sort over the
+     * graph built from each type's dependency names, so O(V+E) overall
+     * rather than comparing every pair. The result is held in a single
+     * contiguous vector, levels being ranges within it, and within a
+     * level types keep the order they were inserted in.
+     *
+     * Anything caught in a dependency cycle can't be ordered, such types
+     * are put in a final level of their own in insertion order.
+     *
+     * As sorting happens on first use a set should be iterated once
+     * before it's shared between threads, Schema does so as it's built.
+     */
     template<class T>
     class OrderedTypeNotations {
-        private:
-            std::list<std::list<uPtr<T>>> m_schemas;
+        private :
+            mutable std::vector<uPtr<T>> m_types;
 
-        public :
-            typedef decltype(m_schemas.begin()) iterator;
+            /**
+             * Offsets into m_types of the start of each level plus one
+             * past the end of the last
+             */
+            mutable std::vector<size_t> m_levels;
+
+            mutable bool m_sorted { true };
 
-        private:
-            void insert (uPtr<T> &&, iterator);
-            void insertNewList (uPtr<T> &&);
-            void insertNewList (
-                    uPtr<T> &&,
-                    typename std::list<std::list<uPtr<T>>>::iterator &);
+            void sort() const;
 
         public :
+            class Level {
+                private :
+                    const uPtr<T> * m_begin;
+                    const uPtr<T> * m_end;
+
+                public :
+                    Level (const uPtr<T> * begin_, const uPtr<T> * end_)
+                        : m_begin (begin_), m_end (end_)
+                    { }
+
+                    const uPtr<T> * begin() const { return m_begin; }
+                    const uPtr<T> * end() const { return m_end; }
+
+                    size_t size() const { return m_end - m_begin; }
+            };
+
+            class const_iterator {
+                private :
+                    const OrderedTypeNotations * m_types;
+                    size_t m_level;
+
+                public :
+                    const_iterator (const OrderedTypeNotations * types_, size_t level_)
+                        : m_types (types_), m_level (level_)
+                    { }
+
+                    Level operator * () const {
+                        const auto * base = m_types->m_types.data();
+
+                        return Level (
+                                base + m_types->m_levels[m_level],
+                                base + m_types->m_levels[m_level + 1]);
+                    }
+
+                    const_iterator & operator ++ () {
+                        ++m_level;
+                        return *this;
+                    }
+
+                    bool operator == (const const_iterator & rhs_) const {
+                        return m_level == rhs_.m_level;
+                    }
+
+                    bool operator != (const const_iterator & rhs_) const {
+                        return m_level != rhs_.m_level;
+                    }
+            };
+
+            using iterator = const_iterator;
+
+            OrderedTypeNotations() = default;
+
+            OrderedTypeNotations (OrderedTypeNotations &&) noexcept = default;
+            OrderedTypeNotations & operator = (OrderedTypeNotations &&) noexcept = default;
+
             void insert (uPtr<T> && ptr);
 
+            /**
+             * Every type in dependency order, ignoring levels
+             */
+            const std::vector<uPtr<T>> & types() const;
+
+            size_t size() const { return m_types.size(); }
+
             friend std::ostream & ::operator << <> (
                     std::ostream &,
                     const amqp::internal::schema::OrderedTypeNotations<T> &);
 
-            decltype (m_schemas.cbegin()) begin() const {
-                return m_schemas.cbegin();
+            const_iterator begin() const {
+                sort();
+                return const_iterator (this, 0);
             }
 
-            decltype (m_schemas.cend()) end() const {
-                return m_schemas.cend();
+            const_iterator end() const {
+                sort();
+                return const_iterator (this, m_levels.empty() ? 0 : m_levels.size() - 1);
             }
     };
 
@@ -87,9 +181,9 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<T> &otn_
 ) {
     int idx1 {0};
-    for (const auto &i : otn_.m_schemas) {
+    for (const auto & i : otn_) {
         stream_ << "level " << ++idx1 << std::endl;
-        for (const auto &j : i) {
+        for (const auto & j : i) {
             stream_ << "    * " << j->name() << std::endl;
         }
         stream_ << std::endl;
@@ -103,106 +197,144 @@ operator << (
 template<class T>
 void
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(uPtr<T> && ptr) {
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.emplace_back(std::move (l));
+OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
+    DBG ("Insert: " << ptr->name() << std::endl);
+
+    m_types.emplace_back (std::move (ptr));
+    m_sorted = false;
 }
 
 /******************************************************************************/
 
-/**
- * This could be a bit more space efficient by checking the previous element
- * for dependendies again as its possible we are moving multiple elements "up"
- * but the extra checks probably don't make it worth it.
- */
 template<class T>
-void
+const std::vector<uPtr<T>> &
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(
-        uPtr<T> && ptr,
-        typename std::list<std::list<uPtr<T>>>::iterator & here_)
-{
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.insert(here_, std::move (l));
+OrderedTypeNotations<T>::types() const {
+    sort();
+    return m_types;
 }
 
 /******************************************************************************/
 
+/**
+ * Kahn's algorithm, recording for each type the length of the longest
+ * chain of dependencies leading to it as we go. That's its level, and a
+ * counting sort on level over the types in insertion order then lays
+ * them out with each level's types kept in the order they were added.
+ */
 template<class T>
 void
 amqp::internal::schema::
-OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
-    return insert (std::move (ptr), m_schemas.begin());
-}
+OrderedTypeNotations<T>::sort() const {
+    if (m_sorted) {
+        return;
+    }
 
-/******************************************************************************/
+    const size_t n = m_types.size();
+
+    std::unordered_map<std::string_view, size_t> byName;
+    byName.reserve (n);
+
+    for (size_t i { 0 } ; i < n ; ++i) {
+        byName.emplace (m_types[i]->name(), i);
+    }
 
-template<class T>
-void
-amqp::internal::schema::
-OrderedTypeNotations<T>::insert (
-        uPtr<T> && ptr,
-        amqp::internal::schema::OrderedTypeNotations<T>::iterator l_
-) {
-    DBG ("Insert: " << ptr->name() << std::endl);
     /*
-     * First we find where this element needs to be added
+     * Edges run from a type to those that depend on it, held as one
+     * flat adjacency array indexed by per type offsets
      */
-    amqp::internal::schema::OrderedTypeNotations<T>::iterator insertionPoint { l_ };
-
-    for (auto i = l_ ; i != m_schemas.end() ; ++i) {
-        for (const auto & j : *i) {
-            /*
-             * A score of 0 means no dependencies at all
-             * A score of 1 means "j" has a dependency on what's being inserted
-             * A score of 2 means what's being inserted depends on "j"
-             */
-            auto score = j->dependsOn(*ptr);
+    std::vector<std::vector<std::string_view>> names (n);
+    std::vector<size_t> offsets (n + 1, 0);
+    std::vector<size_t> inDegree (n, 0);
+
+    for (size_t i { 0 } ; i < n ; ++i) {
+        m_types[i]->dependencies (names[i]);
+
+        for (const auto & name : names[i]) {
+            auto it = byName.find (name);
 
-            if (score == 1) {
-                insertionPoint = std::next(i);
-            } else if (score == 2) {
-                insertionPoint = i;
-                goto done;
+            if (it != byName.end() && it->second != i) {
+                ++offsets[it->second + 1];
+                ++inDegree[i];
             }
         }
     }
-done:
+
+    for (size_t i { 0 } ; i < n ; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<size_t> dependents (offsets[n]);
+    {
+        auto fill = offsets;
+
+        for (size_t i { 0 } ; i < n ; ++i) {
+            for (const auto & name : names[i]) {
+                auto it = byName.find (name);
+
+                if (it != byName.end() && it->second != i) {
+                    dependents[fill[it->second]++] = i;
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> ready;
+    std::vector<size_t> level (n, 0);
+    ready.reserve (n);
+
+    for (size_t i { 0 } ; i < n ; ++i) {
+        if (inDegree[i] == 0) ready.push_back (i);
+    }
+
+    size_t depth { 0 };
+
+    for (size_t r { 0 } ; r < ready.size() ; ++r) {
+        auto i = ready[r];
+        depth = std::max (depth, level[i] + 1);
+
+        for (size_t e { offsets[i] } ; e < offsets[i + 1] ; ++e) {
+            auto d = dependents[e];
+            level[d] = std::max (level[d], level[i] + 1);
+
+            if (--inDegree[d] == 0) ready.push_back (d);
+        }
+    }
 
     /*
-     * Now we insert it and work out if anything requires shuffling
+     * Whatever never became ready is part of, or depends on, a cycle
      */
-    if (insertionPoint == m_schemas.end()) {
-        insertNewList (std::move(ptr));
-    } else {
-        const auto & insertedPtr = insertionPoint->emplace_front (std::move(ptr));
-
-        for (auto j = std::next (insertionPoint->begin()) ; j != insertionPoint->end() ; ) {
-            auto toErase = j++;
-
-            auto score { insertedPtr->dependsOn (**toErase) };
-
-            if (score > 0) {
-                uPtr<T> tmpPtr{std::move(*toErase)};
-                insertionPoint->erase (toErase);
-                switch (score) {
-                    // Needs to go after the element we're adding
-                    case 1: {
-                        insert(std::move(tmpPtr), std::next(insertionPoint));
-                        break;
-                    }
-                    // Needs to go before the element we're adding
-                    case 2: {
-                        insertNewList (std::move(tmpPtr), insertionPoint);
-                        break;
-                    }
-                }
+    if (ready.size() != n) {
+        DBG ("Dependency cycle in " << (n - ready.size()) << " types" << std::endl); // NOLINT
 
-            }
+        for (size_t i { 0 } ; i < n ; ++i) {
+            if (inDegree[i] != 0) level[i] = depth;
         }
+
+        ++depth;
     }
+
+    m_levels.assign (depth + 1, 0);
+
+    for (size_t i { 0 } ; i < n ; ++i) {
+        ++m_levels[level[i] + 1];
+    }
+
+    for (size_t l { 0 } ; l < depth ; ++l) {
+        m_levels[l + 1] += m_levels[l];
+    }
+
+    std::vector<uPtr<T>> sorted (n);
+    {
+        auto fill = m_levels;
+
+        for (size_t i { 0 } ; i < n ; ++i) {
+            sorted[fill[level[i]]++] = std::move (m_types[i]);
+        }
+    }
+
+    m_types = std::move (sorted);
+    m_sorted = true;
 }
 
 /******************************************************************************/
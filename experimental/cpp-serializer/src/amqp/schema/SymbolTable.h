@@ -0,0 +1,171 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * Interns a fixed set of symbols, the descriptors of the types in a
+     * schema for instance, and maps them to a value through a flat open
+     * addressed hash table keyed on the raw bytes.
+     *
+     * Built once as a schema is loaded and read only afterwards, the point
+     * being a lookup with a view straight into the encoded blob is a hash
+     * and a probe or two along a contiguous array, no string has to be
+     * built and nothing is allocated.
+     */
+    template<class T>
+    class SymbolTable {
+        private :
+            struct Slot {
+                uint64_t         m_hash;
+                std::string_view m_key;
+                size_t           m_value;
+            };
+
+            /**
+             * The one copy of each symbol, a deque so the views held
+             * in the slots stay good as we grow
+             */
+            std::deque<std::string> m_symbols;
+            std::vector<T> m_values;
+
+            /**
+             * Always a power of two in size and never more than half full
+             */
+            std::vector<Slot> m_slots;
+
+            static constexpr size_t npos = SIZE_MAX;
+
+            static uint64_t hash (std::string_view);
+
+            size_t probe (uint64_t, std::string_view) const;
+
+            void grow();
+
+        public :
+            SymbolTable() : m_slots (16, Slot { 0, { }, npos }) { }
+
+            /**
+             * @return the interned copy of the symbol, inserting it with
+             * the given value if it isn't already present. The value of
+             * an existing symbol is left alone.
+             */
+            std::string_view intern (std::string_view, T);
+
+            /**
+             * @return the value held against the symbol or nullptr if
+             * it's not one we know about
+             */
+            const T * find (std::string_view) const;
+
+            size_t size() const { return m_values.size(); }
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * FNV-1a, descriptors are short and share long prefixes (a net.corda
+ * namespace followed by a base64 fingerprint) so mixing every byte
+ * matters more than throughput
+ */
+template<class T>
+uint64_t
+amqp::internal::schema::
+SymbolTable<T>::hash (std::string_view key_) {
+    uint64_t h { 0xcbf29ce484222325ULL };
+
+    for (auto c : key_) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ULL;
+    }
+
+    return h;
+}
+
+/******************************************************************************/
+
+/**
+ * @return the slot holding the key or the empty slot it would go in
+ */
+template<class T>
+size_t
+amqp::internal::schema::
+SymbolTable<T>::probe (uint64_t hash_, std::string_view key_) const {
+    const size_t mask = m_slots.size() - 1;
+
+    for (size_t i = hash_ & mask ; ; i = (i + 1) & mask) {
+        const auto & slot = m_slots[i];
+
+        if (slot.m_value == npos
+            || (slot.m_hash == hash_ && slot.m_key == key_))
+        {
+            return i;
+        }
+    }
+}
+
+/******************************************************************************/
+
+template<class T>
+void
+amqp::internal::schema::
+SymbolTable<T>::grow() {
+    std::vector<Slot> slots (m_slots.size() * 2, Slot { 0, { }, npos });
+    std::swap (slots, m_slots);
+
+    for (const auto & slot : slots) {
+        if (slot.m_value != npos) {
+            m_slots[probe (slot.m_hash, slot.m_key)] = slot;
+        }
+    }
+}
+
+/******************************************************************************/
+
+template<class T>
+std::string_view
+amqp::internal::schema::
+SymbolTable<T>::intern (std::string_view key_, T value_) {
+    const auto h = hash (key_);
+    auto i = probe (h, key_);
+
+    if (m_slots[i].m_value != npos) {
+        return m_slots[i].m_key;
+    }
+
+    if ((m_values.size() + 1) * 2 > m_slots.size()) {
+        grow();
+        i = probe (h, key_);
+    }
+
+    std::string_view symbol { m_symbols.emplace_back (key_) };
+
+    m_slots[i] = Slot { h, symbol, m_values.size() };
+    m_values.emplace_back (std::move (value_));
+
+    return symbol;
+}
+
+/******************************************************************************/
+
+template<class T>
+const T *
+amqp::internal::schema::
+SymbolTable<T>::find (std::string_view key_) const {
+    const auto & slot = m_slots[probe (hash (key_), key_)];
+
+    return slot.m_value == npos ? nullptr : &m_values[slot.m_value];
+}
+
+/******************************************************************************/
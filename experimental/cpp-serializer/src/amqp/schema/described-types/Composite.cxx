@@ -67,6 +67,20 @@ Composite::type() const {
 
 /******************************************************************************/
 
+/**
+ * A composite can only be built once the types of all of its fields have
+ * been, primitives won't be in the schema and are skipped when ordering
+ */
+void
+amqp::internal::schema::
+Composite::dependencies (std::vector<std::string_view> & names_) const {
+    for (const auto & field : m_fields) {
+        names_.emplace_back (field->resolvedType());
+    }
+}
+
+/******************************************************************************/
+
 /**
  * Use a visitor style pattern to work out weather two types, composite or
  * restricted, are "less than" one or not. In this case we define being
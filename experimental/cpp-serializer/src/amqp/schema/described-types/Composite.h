@@ -72,6 +72,8 @@ namespace amqp::internal::schema {
 
             Type type() const override;
 
+            void dependencies (std::vector<std::string_view> &) const override;
+
             int dependsOn (const OrderedTypeNotation &) const override;
             int dependsOnRHS (const class Restricted &) const override;
             int dependsOnRHS (const Composite &) const override;
@@ -29,8 +29,10 @@ operator << (
 amqp::internal::schema::
 Envelope::Envelope (
     uPtr<Schema> & schema_,
-    std::string descriptor_
-) : m_schema (std::move (schema_))
+    std::string descriptor_,
+    uPtr<Arena> arena_
+) : m_arena (std::move (arena_))
+  , m_schema (std::move (schema_))
   , m_descriptor (std::move (descriptor_))
 { }
 
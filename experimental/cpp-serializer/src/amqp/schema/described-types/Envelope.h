@@ -17,6 +17,12 @@ namespace amqp::internal::schema {
             friend std::ostream & operator << (std::ostream &, const Envelope &);
 
         private :
+            /**
+             * Everything below us was allocated from here, so it's
+             * declared first to be destroyed last
+             */
+            std::unique_ptr<Arena> m_arena;
+
             std::unique_ptr<Schema> m_schema;
             std::string m_descriptor;
 
@@ -25,7 +31,8 @@ namespace amqp::internal::schema {
 
             Envelope (
                 std::unique_ptr<Schema> & schema_,
-                std::string descriptor_);
+                std::string descriptor_,
+                std::unique_ptr<Arena> arena_ = nullptr);
 
             const ISchemaType & schema() const;
 
@@ -40,13 +40,18 @@ operator << (std::ostream & stream_, const Schema & schema_) {
 
 amqp::internal::schema::
 Schema::Schema (
-    OrderedTypeNotations<AMQPTypeNotation> types_
-) : m_types (std::move (types_)) {
+    OrderedTypeNotations<AMQPTypeNotation> types_,
+    uPtr<Arena> arena_
+) : m_arena (std::move (arena_))
+  , m_types (std::move (types_))
+{
     for (auto i { m_types.begin() } ; i != m_types.end() ; ++i) {
         for (auto & j : *i) {
             DBG ("Schema: " << j->descriptor() << " " << j->name() << std::endl); // NOLINT
-            m_descriptorToType.emplace (j->descriptor(), std::ref (j));
+            auto d = m_descriptorToType.emplace (j->descriptor(), std::ref (j));
             m_typeToDescriptor.emplace (j->name(), std::ref (j));
+
+            m_descriptors.intern (j->descriptor(), d.first);
         }
     }
 }
@@ -71,8 +76,10 @@ Schema::fromType (const std::string & type_) const {
 
 amqp::internal::schema::SchemaMap::const_iterator
 amqp::internal::schema::
-Schema::fromDescriptor (const std::string & descriptor_) const {
-    return m_descriptorToType.find (descriptor_);
+Schema::fromDescriptor (std::string_view descriptor_) const {
+    const auto * it = m_descriptors.find (descriptor_);
+
+    return it ? *it : m_descriptorToType.end();
 }
 
 /******************************************************************************/
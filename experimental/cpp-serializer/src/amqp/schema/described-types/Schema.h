@@ -9,6 +9,8 @@
 #include "types.h"
 #include "Composite.h"
 #include "Descriptor.h"
+#include "schema/Arena.h"
+#include "schema/SymbolTable.h"
 #include "schema/OrderedTypeNotations.h"
 
 #include "amqp/AMQPDescribed.h"
@@ -38,18 +40,33 @@ namespace amqp::internal::schema {
             friend std::ostream & operator << (std::ostream &, const Schema &);
 
         private :
+            /**
+             * Set when we were built on our own rather than as part of an
+             * Envelope, declared first so it outlives the types in it
+             */
+            uPtr<Arena> m_arena;
+
             OrderedTypeNotations<AMQPTypeNotation> m_types;
 
             SchemaMap m_descriptorToType;
             SchemaMap m_typeToDescriptor;
 
+            /**
+             * Descriptors are looked up for every described value we
+             * decode, so rather than walk the map with a string we have
+             * to build each time we probe this with the symbol's bytes
+             */
+            SymbolTable<SchemaMap::const_iterator> m_descriptors;
+
         public :
-            explicit Schema (OrderedTypeNotations<AMQPTypeNotation>);
+            explicit Schema (
+                OrderedTypeNotations<AMQPTypeNotation>,
+                uPtr<Arena> = nullptr);
 
             const OrderedTypeNotations<AMQPTypeNotation> & types() const;
 
             SchemaMap::const_iterator fromType (const std::string &) const override;
-            SchemaMap::const_iterator fromDescriptor (const std::string &) const override ;
+            SchemaMap::const_iterator fromDescriptor (std::string_view) const override;
 
             decltype (m_types.begin()) begin() const { return m_types.begin(); }
             decltype (m_types.end()) end() const { return m_types.end(); }
@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <iostream>
 
 #include "amqp/AMQPDescribed.h"
@@ -50,23 +51,32 @@ namespace amqp::internal::schema::descriptors {
 
     class AMQPDescriptor {
         protected :
-            std::string m_symbol;
+            /**
+             * Descriptors are only ever the static instances held in the
+             * AMQPDescriptorRegistory so the symbol can always be a literal
+             */
+            std::string_view m_symbol;
             int32_t m_val;
 
         public :
-            AMQPDescriptor()
+            constexpr AMQPDescriptor()
                 : m_symbol ("ERROR")
                 , m_val (-1)
             { }
 
-            AMQPDescriptor (std::string symbol_, int val_)
-                : m_symbol (std::move (symbol_))
+            constexpr AMQPDescriptor (std::string_view symbol_, int val_)
+                : m_symbol (symbol_)
                 , m_val (val_)
             { }
 
-            virtual ~AMQPDescriptor() = default;
+            /**
+             * Never owned through a base pointer so there's no need for
+             * a virtual destructor, leaving it trivial lets every
+             * descriptor be a constexpr instance
+             */
+            ~AMQPDescriptor() = default;
 
-            const std::string & symbol() const;
+            std::string_view symbol() const;
 
             void validateAndNext (pn_data_t *) const;
 
@@ -13,87 +13,70 @@
 
 #include <limits>
 #include <climits>
+#include <string>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::schema::descriptors;
+    namespace ids = ::amqp::schema::descriptors;
+
+    /**
+     * The qualified call binds to T's build directly rather than going
+     * through the vtable
+     */
+    template<class T>
+    uPtr<amqp::AMQPDescribed>
+    buildAs (const AMQPDescriptor & descriptor_, pn_data_t * data_) {
+        return static_cast<const T &>(descriptor_).T::build (data_);
+    }
+
+    constexpr AMQPDescriptor                describedDescriptor           { "DESCRIBED", -1 };
+    constexpr EnvelopeDescriptor            envelopeDescriptor            { "ENVELOPE", ids::ENVELOPE };
+    constexpr SchemaDescriptor              schemaDescriptor              { "SCHEMA", ids::SCHEMA };
+    constexpr ObjectDescriptor              objectDescriptor              { "OBJECT_DESCRIPTOR", ids::OBJECT };
+    constexpr FieldDescriptor               fieldDescriptor               { "FIELD", ids::FIELD };
+    constexpr CompositeDescriptor           compositeDescriptor           { "COMPOSITE_TYPE", ids::COMPOSITE_TYPE };
+    constexpr RestrictedDescriptor          restrictedDescriptor          { "RESTRICTED_TYPE", ids::RESTRICTED_TYPE };
+    constexpr ChoiceDescriptor              choiceDescriptor              { "CHOICE", ids::CHOICE };
+    constexpr ReferencedObjectDescriptor    referencedObjectDescriptor    { "REFERENCED_OBJECT", ids::REFERENCED_OBJECT };
+    constexpr TransformSchemaDescriptor     transformSchemaDescriptor     { "TRANSFORM_SCHEMA", ids::TRANSFORM_SCHEMA };
+    constexpr TransformElementDescriptor    transformElementDescriptor    { "TRANSFORM_ELEMENT", ids::TRANSFORM_ELEMENT };
+    constexpr TransformElementKeyDescriptor transformElementKeyDescriptor { "TRANSFORM_ELEMENT_KEY", ids::TRANSFORM_ELEMENT_KEY };
+
+}
 
 /******************************************************************************/
 
-/**
- *
- */
 namespace amqp::internal {
 
-    std::map<uint64_t, std::shared_ptr<internal::schema::descriptors::AMQPDescriptor>>
-    AMQPDescriptorRegistory = {
-        {
-            22UL,
-            std::make_shared<internal::schema::descriptors::AMQPDescriptor> ("DESCRIBED", -1)
-        },
-        {
-            1UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::EnvelopeDescriptor> (
-                    "ENVELOPE",
-                    ::amqp::schema::descriptors::ENVELOPE)
-        },
-        {
-            2UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::SchemaDescriptor> (
-                    "SCHEMA",
-                    ::amqp::schema::descriptors::SCHEMA)
-        },
-        {
-            3UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::ObjectDescriptor> (
-                    "OBJECT_DESCRIPTOR",
-                    ::amqp::schema::descriptors::OBJECT)
-        },
-        {
-            4UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::FieldDescriptor> (
-                    "FIELD",
-                    ::amqp::schema::descriptors::FIELD)
-        },
-        {
-            5UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::CompositeDescriptor> (
-                    "COMPOSITE_TYPE",
-                    ::amqp::schema::descriptors::COMPOSITE_TYPE)
-        },
-        {
-            6UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::RestrictedDescriptor> (
-                    "RESTRICTED_TYPE",
-                    ::amqp::schema::descriptors::RESTRICTED_TYPE)
-        },
-        {
-            7UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::ChoiceDescriptor> (
-                    "CHOICE",
-                    ::amqp::schema::descriptors::CHOICE)
-        },
-        {
-            8UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::ReferencedObjectDescriptor> (
-                    "REFERENCED_OBJECT",
-                    ::amqp::schema::descriptors::REFERENCED_OBJECT)
-        },
-        {
-            9UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::TransformSchemaDescriptor> (
-                    "TRANSFORM_SCHEMA",
-                    ::amqp::schema::descriptors::TRANSFORM_SCHEMA)
-        },
-        {
-            10UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::TransformElementDescriptor> (
-                    "TRANSFORM_ELEMENT",
-                    ::amqp::schema::descriptors::TRANSFORM_ELEMENT)
-        },
-        {
-            11UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::TransformElementKeyDescriptor> (
-                    "TRANSFORM_ELEMENT_KEY",
-                    ::amqp::schema::descriptors::TRANSFORM_ELEMENT_KEY)
-        }
-    };
+    constexpr DescriptorTable AMQPDescriptorRegistory {{{
+        { &describedDescriptor,           &buildAs<AMQPDescriptor> },
+        { &envelopeDescriptor,            &buildAs<EnvelopeDescriptor> },
+        { &schemaDescriptor,              &buildAs<SchemaDescriptor> },
+        { &objectDescriptor,              &buildAs<ObjectDescriptor> },
+        { &fieldDescriptor,               &buildAs<FieldDescriptor> },
+        { &compositeDescriptor,           &buildAs<CompositeDescriptor> },
+        { &restrictedDescriptor,          &buildAs<RestrictedDescriptor> },
+        { &choiceDescriptor,              &buildAs<ChoiceDescriptor> },
+        { &referencedObjectDescriptor,    &buildAs<ReferencedObjectDescriptor> },
+        { &transformSchemaDescriptor,     &buildAs<TransformSchemaDescriptor> },
+        { &transformElementDescriptor,    &buildAs<TransformElementDescriptor> },
+        { &transformElementKeyDescriptor, &buildAs<TransformElementKeyDescriptor> }
+    }}};
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+DescriptorTable::unknown (uint64_t id_) {
+    throw std::out_of_range (
+            "Unknown described type " + std::to_string (id_)
+            + " (" + describedToString (id_) + ")");
 }
 
 /******************************************************************************/
@@ -2,24 +2,97 @@
 
 /******************************************************************************/
 
-#include <map>
+#include <array>
 #include <memory>
+#include <cstdint>
 
 /******************************************************************************/
 
+#include "types.h"
 #include "AMQPDescriptor.h"
+#include "amqp/schema/Descriptors.h"
 
 /******************************************************************************/
 
+namespace amqp::internal {
 
-/******************************************************************************/
+    /**
+     * Maps the ID of a described type to the descriptor that knows how to
+     * read and build it.
+     *
+     * The IDs form a dense range, the Corda ones being 1 through 11 under
+     * DESCRIPTOR_TOP_32BITS with plain AMQP described types on 22, so this
+     * is a flat array indexed by the bottom bits rather than a map. Each
+     * entry pairs a descriptor with a builder bound at compile time to its
+     * concrete type so dispatching a build is an array index and a direct
+     * call. The table itself is constant initialised, there's nothing to
+     * construct at startup and it's safe to share between threads.
+     */
+    class DescriptorTable {
+        public :
+            using builder_t = uPtr<AMQPDescribed> (*)(
+                    const schema::descriptors::AMQPDescriptor &,
+                    pn_data_t *);
 
-/**
- *
- */
-namespace amqp::internal {
+            struct Entry {
+                const schema::descriptors::AMQPDescriptor * m_descriptor;
+                builder_t m_build;
+            };
+
+            /**
+             * Slot 0 holds the generic described type, the rest are the
+             * Corda types in ID order
+             */
+            static constexpr size_t DESCRIBED = 22;
+            static constexpr size_t SIZE = ::amqp::schema::descriptors::TRANSFORM_ELEMENT_KEY + 1;
+
+        private :
+            std::array<Entry, SIZE> m_entries;
+
+            [[noreturn]] static void unknown (uint64_t);
+
+            static constexpr size_t index (uint64_t id_) {
+                if (id_ == DESCRIBED) {
+                    return 0;
+                }
+
+                if ((id_ & ~0xFFFFFFFFULL) == ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS) {
+                    auto idx = static_cast<size_t>(id_ & 0xFFFFFFFFULL);
+
+                    if (idx != 0 && idx < SIZE) {
+                        return idx;
+                    }
+                }
+
+                return SIZE;
+            }
+
+        public :
+            explicit constexpr DescriptorTable (const std::array<Entry, SIZE> & entries_)
+                : m_entries (entries_)
+            { }
+
+            /**
+             * @throws std::out_of_range if id_ isn't a described type we know
+             */
+            const schema::descriptors::AMQPDescriptor * at (uint64_t id_) const {
+                auto idx = index (id_);
+
+                if (idx == SIZE) unknown (id_);
+
+                return m_entries[idx].m_descriptor;
+            }
+
+            uPtr<AMQPDescribed> build (uint64_t id_, pn_data_t * data_) const {
+                auto idx = index (id_);
+
+                if (idx == SIZE) unknown (id_);
+
+                return m_entries[idx].m_build (*m_entries[idx].m_descriptor, data_);
+            }
+    };
 
-    extern std::map<uint64_t, std::shared_ptr<internal::schema::descriptors::AMQPDescriptor>> AMQPDescriptorRegistory;
+    extern const DescriptorTable AMQPDescriptorRegistory;
 
 }
 
@@ -7,15 +7,6 @@
 
 /******************************************************************************/
 
-amqp::internal::schema::descriptors::
-ChoiceDescriptor::ChoiceDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-}
-
-/******************************************************************************/
-
 std::unique_ptr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 ChoiceDescriptor::build (pn_data_t * data_) const  {
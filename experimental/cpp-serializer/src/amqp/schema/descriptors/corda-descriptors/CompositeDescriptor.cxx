@@ -21,16 +21,6 @@
  *
  ******************************************************************************/
 
-amqp::internal::schema::descriptors::
-CompositeDescriptor::CompositeDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 CompositeDescriptor::build (pn_data_t * data_) const {
@@ -128,7 +118,7 @@ CompositeDescriptor::read (
 
         ss_ << ai << "4] Descriptor:" << std::endl;
 
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        AMQPDescriptorRegistory.at (pn_data_type(data_))->read (
             (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 
         ss_ << ai << "5] List: Fields: " << std::endl;
@@ -141,7 +131,7 @@ CompositeDescriptor::read (
                     << ale.elements() << "]"
                     << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                AMQPDescriptorRegistory.at (pn_data_type(data_))->read (
                         data_, ss_, AutoIndent { ai2 });
             }
         }
@@ -9,9 +9,11 @@ namespace amqp::internal::schema::descriptors {
     class CompositeDescriptor : public AMQPDescriptor {
         public :
             CompositeDescriptor() = delete;
-            CompositeDescriptor (std::string, int);
+            constexpr CompositeDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            ~CompositeDescriptor() final = default;
+            ~CompositeDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
@@ -2,6 +2,7 @@
 
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/Arena.h"
 #include "proton/proton_wrapper.h"
 
 #include "types.h"
@@ -49,12 +50,12 @@ EnvelopeDescriptor::read (
         proton::auto_enter p (data_);
 
         ss_ << ai << "1]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        AMQPDescriptorRegistory.at (pn_data_type(data_))->read (
                 (pn_data_t *)proton::auto_next (data_), ss_, AutoIndent { ai });
 
 
         ss_ << ai << "2]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        AMQPDescriptorRegistory.at (pn_data_type(data_))->read (
                 (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 
     }
@@ -62,16 +63,6 @@ EnvelopeDescriptor::read (
 
 /******************************************************************************/
 
-amqp::internal::schema::descriptors::
-EnvelopeDescriptor::EnvelopeDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 EnvelopeDescriptor::build (pn_data_t * data_) const {
@@ -79,32 +70,45 @@ EnvelopeDescriptor::build (pn_data_t * data_) const {
 
     validateAndNext(data_);
 
-    proton::auto_enter p (data_);
-
     /*
-     * The actual blob... if this was java we would use the type symbols
-     * in the blob to look up serialisers in the cache... but we don't
-     * have any so we are actually going to need to use the schema
-     * which we parse *after* this to be able to read any data!
+     * The schema, and everything in it, comes from an arena we own. The
+     * envelope itself mustn't, it's what frees the arena.
      */
-    std::string outerType = consumeBlob(data_);
+    auto arena = std::make_unique<schema::Arena>();
+    uPtr<schema::Schema> schema;
+    std::string outerType;
 
-    pn_data_next (data_);
+    {
+        schema::Arena::Scope scope (*arena);
 
-    /*
-     * The schema
-     */
-    auto schema = descriptors::dispatchDescribed<schema::Schema> (data_);
+        proton::auto_enter p (data_);
 
-    pn_data_next(data_);
+        /*
+         * The actual blob... if this was java we would use the type symbols
+         * in the blob to look up serialisers in the cache... but we don't
+         * have any so we are actually going to need to use the schema
+         * which we parse *after* this to be able to read any data!
+         */
+        outerType = consumeBlob(data_);
 
-    /*
-     * The transforms schema
-     */
-    // Skip for now
-    // dispatchDescribed (data_);
+        pn_data_next (data_);
+
+        /*
+         * The schema
+         */
+        schema = descriptors::dispatchDescribed<schema::Schema> (data_);
+
+        pn_data_next(data_);
+
+        /*
+         * The transforms schema
+         */
+        // Skip for now
+        // dispatchDescribed (data_);
+    }
 
-    return std::make_unique<schema::Envelope> (schema::Envelope (schema, outerType));
+    return std::make_unique<schema::Envelope> (
+            schema, std::move (outerType), std::move (arena));
 }
 
 /******************************************************************************/
@@ -24,9 +24,11 @@ namespace amqp::internal::schema::descriptors {
     class EnvelopeDescriptor : public AMQPDescriptor {
         public :
             EnvelopeDescriptor() = delete;
-            EnvelopeDescriptor (std::string, int);
+            constexpr EnvelopeDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            ~EnvelopeDescriptor() final = default;
+            ~EnvelopeDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
@@ -13,9 +13,11 @@ namespace amqp::internal::schema::descriptors {
     class FieldDescriptor : public AMQPDescriptor {
         public :
             FieldDescriptor() = delete;
-            FieldDescriptor (std::string, int);
+            constexpr FieldDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            ~FieldDescriptor() final = default;
+            ~FieldDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
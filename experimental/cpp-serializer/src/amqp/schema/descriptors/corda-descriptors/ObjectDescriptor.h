@@ -16,9 +16,11 @@ namespace amqp::internal::schema::descriptors {
     public :
         ObjectDescriptor() = delete;
 
-        ObjectDescriptor (std::string, int);
+        constexpr ObjectDescriptor (std::string_view symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
+        { }
 
-        ~ObjectDescriptor() final = default;
+        ~ObjectDescriptor() = default;
 
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
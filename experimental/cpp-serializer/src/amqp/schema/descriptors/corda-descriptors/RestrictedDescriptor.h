@@ -21,9 +21,11 @@ namespace amqp::internal::schema::descriptors {
 
     public :
         RestrictedDescriptor() = delete;
-        RestrictedDescriptor (std::string, int);
+        constexpr RestrictedDescriptor (std::string_view symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
+        { }
 
-        ~RestrictedDescriptor() final = default;
+        ~RestrictedDescriptor() = default;
 
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
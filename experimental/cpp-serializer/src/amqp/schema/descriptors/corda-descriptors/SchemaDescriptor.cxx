@@ -11,17 +11,10 @@
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/OrderedTypeNotations.h"
 #include "amqp/schema/AMQPTypeNotation.h"
+#include "amqp/schema/Arena.h"
 
 #include <sstream>
-
-/******************************************************************************/
-
-amqp::internal::schema::descriptors::
-SchemaDescriptor::SchemaDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-}
+#include <optional>
 
 /******************************************************************************/
 
@@ -32,6 +25,19 @@ SchemaDescriptor::build (pn_data_t * data_) const {
 
     validateAndNext(data_);
 
+    /*
+     * Unless we're part of an Envelope, which will already have put an
+     * arena in place, the types we build come from one of our own. It
+     * has to outlive them should we throw part way through.
+     */
+    uPtr<schema::Arena> arena;
+    std::optional<schema::Arena::Scope> scope;
+
+    if (!schema::Arena::current()) {
+        arena = std::make_unique<schema::Arena>();
+        scope.emplace (*arena);
+    }
+
     schema::OrderedTypeNotations<schema::AMQPTypeNotation> schemas;
 
     /*
@@ -53,7 +59,9 @@ SchemaDescriptor::build (pn_data_t * data_) const {
         }
     }
 
-    return std::make_unique<schema::Schema> (std::move (schemas));
+    scope.reset();
+
+    return std::make_unique<schema::Schema> (std::move (schemas), std::move (arena));
 }
 
 /******************************************************************************/
@@ -85,7 +93,7 @@ SchemaDescriptor::read (
                 ss_ << ai2 << i << ":" << j << "/" << ale2.elements()
                         << "] " << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                AMQPDescriptorRegistory.at (pn_data_type(data_))->read (
                         data_, ss_,
                         AutoIndent { ai2 });
             }
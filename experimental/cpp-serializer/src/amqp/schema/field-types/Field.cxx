@@ -122,7 +122,18 @@ Field::typeIsPrimitive (const std::string & type_) {
             type_ == "long" ||
             type_ == "boolean" ||
             type_ == "int" ||
-            type_ == "double");
+            type_ == "double" ||
+            type_ == "byte" ||
+            type_ == "short" ||
+            type_ == "char" ||
+            type_ == "float" ||
+            type_ == "timestamp" ||
+            type_ == "uuid" ||
+            type_ == "binary" ||
+            type_ == "symbol" ||
+            type_ == "decimal32" ||
+            type_ == "decimal64" ||
+            type_ == "decimal128");
 }
 
 /******************************************************************************/
@@ -82,8 +82,8 @@ namespace {
 
     std::map<std::string, std::string> boxedToUnboxed = {
             { "java.lang.Integer", "int" },
-            { "java.lang.Boolean", "bool" },
-            { "java.lang.Byte", "char" },
+            { "java.lang.Boolean", "boolean" },
+            { "java.lang.Byte", "byte" },
             { "java.lang.Short", "short" },
             { "java.lang.Character", "char" },
             { "java.lang.Float", "float" },
@@ -225,6 +225,20 @@ Restricted::restrictedType() const {
 
 /******************************************************************************/
 
+/**
+ * Whatever the restricted type is of, the element type of a list or the
+ * key and value types of a map for example
+ */
+void
+amqp::internal::schema::
+Restricted::dependencies (std::vector<std::string_view> & names_) const {
+    for (const auto & type : *this) {
+        names_.emplace_back (type);
+    }
+}
+
+/******************************************************************************/
+
 int
 amqp::internal::schema::
 Restricted::dependsOn (const OrderedTypeNotation & rhs_) const {
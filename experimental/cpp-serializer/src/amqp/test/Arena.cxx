@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory_resource>
+
+#include "types.h"
+
+#include "Arena.h"
+#include "field-types/Field.h"
+#include "described-types/Descriptor.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    class CountingResource : public std::pmr::memory_resource {
+        private :
+            size_t m_allocations { 0 };
+            size_t m_deallocations { 0 };
+
+            void * do_allocate (size_t bytes_, size_t align_) override {
+                ++m_allocations;
+                return std::pmr::new_delete_resource()->allocate (bytes_, align_);
+            }
+
+            void do_deallocate (void * p_, size_t bytes_, size_t align_) override {
+                ++m_deallocations;
+                std::pmr::new_delete_resource()->deallocate (p_, bytes_, align_);
+            }
+
+            bool do_is_equal (const memory_resource & other_) const noexcept override {
+                return this == &other_;
+            }
+
+        public :
+            size_t allocations() const { return m_allocations; }
+            size_t deallocations() const { return m_deallocations; }
+    };
+
+    uPtr<Field>
+    field() {
+        return Field::make ("a", "int", { }, "", "", true, false);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Arena, describedTypesComeFromArena) { // NOLINT
+    CountingResource upstream;
+
+    {
+        Arena arena (&upstream);
+        std::vector<uPtr<Field>> fields;
+
+        {
+            Arena::Scope scope (arena);
+
+            for (int i { 0 } ; i < 500 ; ++i) {
+                fields.emplace_back (field());
+            }
+        }
+
+        EXPECT_GT (upstream.allocations(), 0);
+        EXPECT_LT (upstream.allocations(), 8);
+
+        // handing them back to the arena is a no-op
+        fields.clear();
+        EXPECT_EQ (0, upstream.deallocations());
+    }
+
+    EXPECT_EQ (upstream.allocations(), upstream.deallocations());
+}
+
+/******************************************************************************/
+
+TEST (Arena, scopes) { // NOLINT
+    EXPECT_EQ (nullptr, Arena::current());
+
+    Arena outer;
+    Arena inner;
+
+    {
+        Arena::Scope s1 (outer);
+        EXPECT_EQ (outer.resource(), Arena::current());
+
+        {
+            Arena::Scope s2 (inner);
+            EXPECT_EQ (inner.resource(), Arena::current());
+        }
+
+        EXPECT_EQ (outer.resource(), Arena::current());
+    }
+
+    EXPECT_EQ (nullptr, Arena::current());
+
+    // without an arena we're on the heap and delete frees as normal
+    auto f = field();
+    EXPECT_EQ ("a", f->name());
+}
+
+/******************************************************************************/
@@ -0,0 +1,521 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+
+#include "decoder/Cursor.h"
+#include "decoder/Window.h"
+#include "encoder/Encoder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::decoder;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    bytes (std::initializer_list<int> bytes_) {
+        std::string rtn;
+        for (auto b : bytes_) rtn += static_cast<char>(b);
+        return rtn;
+    }
+
+    /**
+     * An array of [count_] elements encoded as [code_], the value of the
+     * i'th being [value_] (i) as [width_] big endian bytes
+     */
+    template<class F>
+    std::string
+    array (int code_, size_t count_, int width_, F && value_) {
+        std::string body;
+
+        for (size_t i { 0 } ; i < count_ ; ++i) {
+            auto v = static_cast<uint64_t>(value_ (i));
+
+            for (int shift { 8 * (width_ - 1) } ; shift >= 0 ; shift -= 8) {
+                body += static_cast<char>(v >> shift);
+            }
+        }
+
+        auto size = static_cast<uint32_t>(body.size() + 5);
+        auto count = static_cast<uint32_t>(count_);
+
+        std::string rtn (1, static_cast<char>(0xf0));
+        for (int shift { 24 } ; shift >= 0 ; shift -= 8) rtn += static_cast<char>(size >> shift);
+        for (int shift { 24 } ; shift >= 0 ; shift -= 8) rtn += static_cast<char>(count >> shift);
+        rtn += static_cast<char>(code_);
+
+        return rtn + body;
+    }
+
+    /**
+     * The elements of the list or array [b_] read with readRun, [chunk_]
+     * at a time, and with [one_] a value at a time, which must agree,
+     * a null being read as a default T either way. Both must leave
+     * the cursor on what follows the list.
+     */
+    template<class T, class F>
+    void
+    runs (const std::string & b_, Type type_, size_t chunk_, F && one_) {
+        std::vector<T> bulk;
+        std::vector<T> single;
+
+        const auto b = b_ + bytes ({ 0x54, 0x2a });
+
+        for (int pass { 0 } ; pass < 2 ; ++pass) {
+            Cursor c (b);
+            ASSERT_TRUE (c.next());
+
+            {
+                auto_list_enter ale (c, true);
+
+                std::array<T, 256> buffer { };
+
+                for (size_t i { 0 } ; i < ale.elements() ; ) {
+                    size_t n { 0 };
+
+                    if (pass == 0) {
+                        n = c.readRun (type_, buffer.data(), chunk_);
+                        bulk.insert (bulk.end(), buffer.begin(), buffer.begin() + n);
+                    }
+
+                    if (n == 0) {
+                        if (c.type() == Type::null_t) {
+                            (pass ? single : bulk).push_back (T { });
+                            c.next();
+                        } else {
+                            (pass ? single : bulk).push_back (static_cast<T>(one_ (c)));
+                        }
+                        n = 1;
+                    }
+
+                    i += n;
+                }
+            }
+
+            ASSERT_TRUE (c.next());
+            EXPECT_EQ (42, c.getInt());
+        }
+
+        EXPECT_EQ (single, bulk);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Cursor, scalars) { // NOLINT
+    auto b = bytes ({
+        0x41,                                   // true
+        0x54, 0xfe,                             // smallint -2
+        0x71, 0x00, 0x01, 0x00, 0x00,           // int 65536
+        0x55, 0x07,                             // smalllong 7
+        0x81, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd, // long -3
+        0x44,                                   // ulong0
+        0x82, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0,     // double 1.5
+        0xa1, 0x03, 'a', 'b', 'c',              // str8 abc
+        0xa3, 0x01, 'x',                        // sym8 x
+        0x40                                    // null
+    });
+
+    Cursor c (b);
+
+    EXPECT_EQ (Type::invalid_t, c.type());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (Type::bool_t, c.type());
+    EXPECT_TRUE (c.getBool());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (Type::int_t, c.type());
+    EXPECT_EQ (-2, c.getInt());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (65536, c.getInt());
+    EXPECT_EQ (0, c.getLong());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (7, c.getLong());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (-3, c.getLong());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (Type::ulong_t, c.type());
+    EXPECT_EQ (0UL, c.getUlong());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (1.5, c.getDouble());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ ("abc", c.getString());
+    EXPECT_EQ ("", c.getSymbol());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ ("x", c.getSymbol());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (Type::null_t, c.type());
+
+    // as with proton, running off the end leaves us where we were
+    EXPECT_FALSE (c.next());
+    EXPECT_EQ (Type::null_t, c.type());
+}
+
+/******************************************************************************/
+
+/**
+ * described (0x53 0x01, list [ 1, map { "k" : list0 } ])
+ */
+TEST (Cursor, compound) { // NOLINT
+    auto b = bytes ({
+        0x00, 0x53, 0x01,
+        0xc0, 0x0a, 0x02,
+            0x54, 0x01,
+            0xc1, 0x05, 0x02,
+                0xa1, 0x01, 'k',
+                0x45,
+        0x54, 0x09
+    });
+
+    Cursor c (b);
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (Type::described_t, c.type());
+    EXPECT_EQ (b.size() - 2, c.raw().size());
+
+    {
+        auto_enter ae (c);
+        EXPECT_EQ (1UL, c.getUlong());
+
+        ASSERT_TRUE (c.next());
+        EXPECT_EQ (2UL, c.listCount());
+
+        auto_list_enter ale (c, true);
+        EXPECT_EQ (2UL, ale.elements());
+        EXPECT_EQ (1, readAndNext<int32_t> (c));
+        EXPECT_EQ (2UL, c.mapCount());
+
+        {
+            auto_map_enter ame (c, true);
+            EXPECT_EQ ("k", readAndNext<std::string_view> (c));
+            EXPECT_EQ (Type::list_t, c.type());
+            EXPECT_EQ (0UL, c.listCount());
+            EXPECT_TRUE (c.enter());
+            EXPECT_FALSE (c.next());
+            EXPECT_TRUE (c.exit());
+            EXPECT_FALSE (c.next());
+        }
+
+        EXPECT_EQ (Type::map_t, c.type());
+        EXPECT_FALSE (c.next());
+    }
+
+    EXPECT_EQ (Type::described_t, c.type());
+    EXPECT_EQ (0UL, c.depth());
+
+    // the whole of the described value is stepped over in one go
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (9, c.getInt());
+}
+
+/******************************************************************************/
+
+/**
+ * Array elements share the constructor, described arrays have the
+ * descriptor as their first child
+ */
+TEST (Cursor, arrays) { // NOLINT
+    auto b = bytes ({
+        0xe0, 0x0a, 0x02, 0x71,
+            0x00, 0x00, 0x00, 0x05,
+            0x00, 0x00, 0x00, 0x06,
+        0xe0, 0x08, 0x02, 0x00, 0xa3, 0x01, 'd', 0x54,
+            0x01,
+            0x02,
+    });
+
+    Cursor c (b);
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (Type::array_t, c.type());
+    EXPECT_EQ (2UL, c.arrayCount());
+    EXPECT_EQ (Type::int_t, c.arrayType());
+    EXPECT_FALSE (c.isArrayDescribed());
+
+    {
+        auto_enter ae (c);
+        EXPECT_EQ (5, readAndNext<int32_t> (c));
+        EXPECT_EQ (6, c.getInt());
+        EXPECT_FALSE (c.next());
+    }
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (2UL, c.arrayCount());
+    EXPECT_TRUE (c.isArrayDescribed());
+
+    {
+        auto_enter ae (c);
+        EXPECT_EQ ("d", c.getSymbol());
+        ASSERT_TRUE (c.next());
+        EXPECT_EQ (1, c.getInt());
+        ASSERT_TRUE (c.next());
+        EXPECT_EQ (2, c.getInt());
+        EXPECT_FALSE (c.next());
+    }
+
+    EXPECT_FALSE (c.next());
+}
+
+/******************************************************************************/
+
+TEST (Cursor, rewind) { // NOLINT
+    auto b = bytes ({ 0xc0, 0x03, 0x01, 0x54, 0x04 });
+
+    Cursor c (b);
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        c.rewind();
+        ASSERT_TRUE (c.next());
+        auto_list_enter ale (c, true);
+        EXPECT_EQ (4, c.getInt());
+    }
+}
+
+/******************************************************************************/
+
+TEST (Cursor, malformed) { // NOLINT
+    {
+        // claims more bytes than there are
+        auto b = bytes ({ 0xa1, 0x05, 'a' });
+        Cursor c (b);
+        EXPECT_THROW (c.next(), std::runtime_error); // NOLINT
+    }
+
+    {
+        // an element overruns the list that holds it
+        auto b = bytes ({ 0xc0, 0x02, 0x01, 0x71, 0x00, 0x00, 0x00, 0x01 });
+        Cursor c (b);
+        ASSERT_TRUE (c.next());
+        ASSERT_TRUE (c.enter());
+        EXPECT_THROW (c.next(), std::runtime_error); // NOLINT
+    }
+
+    {
+        auto b = bytes ({ 0x1f });
+        Cursor c (b);
+        EXPECT_THROW (c.next(), std::runtime_error); // NOLINT
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Descriptors described in turn, far deeper than the stack could
+ * recurse, are a truncated value rather than a crash
+ */
+TEST (Cursor, deepDescriptors) { // NOLINT
+    std::string b (1 << 20, '\0');
+
+    Cursor c (b);
+    EXPECT_THROW (c.next(), std::runtime_error); // NOLINT
+
+    EXPECT_FALSE (Window::extent (b));
+
+    // and however deep, a complete one is measured to its end
+    b += bytes ({ 0x40, 0x41 });
+    b += std::string ((1 << 20) - 1, static_cast<char>(0x40));
+
+    EXPECT_EQ (b.size(), Window::extent (b));
+
+    Cursor d (b);
+    ASSERT_TRUE (d.next());
+    EXPECT_FALSE (d.next());
+}
+
+/******************************************************************************/
+
+/**
+ * A string, a reference back to it, and one to an object not yet read
+ */
+TEST (Cursor, references) { // NOLINT
+    auto b = bytes ({
+        0xa1, 0x01, 'x',
+        0x00, 0x80, 0xc5, 0x62, 0, 0, 0, 0, 0, 0x08, 0x43,
+        0x00, 0x80, 0xc5, 0x62, 0, 0, 0, 0, 0, 0x08, 0x52, 0x01
+    });
+
+    Cursor c (b);
+
+    ASSERT_TRUE (c.next());
+    EXPECT_FALSE (c.isReference());
+    c.remember (c.raw());
+
+    ASSERT_TRUE (c.next());
+    ASSERT_TRUE (c.isReference());
+    EXPECT_EQ (0U, c.reference());
+
+    Cursor replay (c.referenced(), c);
+    ASSERT_TRUE (replay.next());
+    EXPECT_EQ ("x", replay.getString());
+
+    // only the cursor a walk started from keeps the table
+    replay.remember (replay.raw());
+    EXPECT_EQ (1U, c.objects());
+    EXPECT_EQ (1U, replay.objects());
+
+    ASSERT_TRUE (c.next());
+    EXPECT_THROW (c.referenced(), std::runtime_error); // NOLINT
+
+    c.rewind();
+    EXPECT_EQ (0U, c.objects());
+
+    EXPECT_TRUE (mayReference (b));
+    EXPECT_FALSE (mayReference (std::string_view (b).substr (0, 12)));
+}
+
+/******************************************************************************/
+
+/**
+ * Runs of elements read into a buffer agree with reading them one by one,
+ * through the single byte encodings taken a block at a time, the mixed
+ * ones taken an element at a time, and the nulls that end a run
+ */
+TEST (Cursor, listRuns) { // NOLINT
+    std::string b;
+    amqp::internal::encoder::Encoder e (b);
+
+    e.beginList();
+    for (int i { 0 } ; i < 100 ; ++i) {
+        if (i % 37 == 36) {
+            e.putNull();
+        } else {
+            // mostly small enough for a smallint
+            e.putInt (i % 11 == 10 ? i * 100000 : 64 - i * 3);
+        }
+    }
+    e.endList();
+
+    for (size_t chunk : { 1, 7, 8, 64, 256 }) {
+        runs<int32_t> (b, Type::int_t, chunk, [](Cursor & c_) {
+            return readAndNext<int32_t> (c_);
+        });
+    }
+
+    b.clear();
+    e.beginList();
+    for (int i { 0 } ; i < 70 ; ++i) {
+        e.putLong (i % 13 == 12 ? -(int64_t { 1 } << 40) * i : 100 - 3 * i);
+    }
+    e.endList();
+
+    runs<int64_t> (b, Type::long_t, 64, [](Cursor & c_) {
+        return readAndNext<int64_t> (c_);
+    });
+
+    b.clear();
+    e.beginList();
+    for (int i { 0 } ; i < 50 ; ++i) {
+        if (i == 20) e.putNull();
+        e.putBool (i % 3 == 0);
+    }
+    e.endList();
+
+    runs<bool> (b, Type::bool_t, 64, [](Cursor & c_) {
+        return readAndNext<bool> (c_);
+    });
+
+    b.clear();
+    e.beginList();
+    for (int i { 0 } ; i < 40 ; ++i) {
+        if (i % 2) e.putByte (static_cast<int8_t>(-i)); else e.putShort (static_cast<int16_t>(-300 * i));
+    }
+    e.endList();
+
+    // a run of bytes ends at the first short, and of shorts at the first byte
+    runs<int32_t> (b, Type::byte_t, 64, [](Cursor & c_) {
+        return c_.type() == Type::byte_t ? readAndNext<int8_t> (c_) : readAndNext<int16_t> (c_);
+    });
+
+    b.clear();
+    e.beginList();
+    for (int i { 0 } ; i < 20 ; ++i) {
+        if (i % 5) e.putDouble (i / 3.0); else e.putFloat (static_cast<float>(i) / 4);
+    }
+    e.endList();
+
+    runs<double> (b, Type::double_t, 64, [](Cursor & c_) {
+        return c_.type() == Type::double_t
+            ? readAndNext<double> (c_)
+            : static_cast<double>(readAndNext<float> (c_));
+    });
+
+    // nothing in the list encodes a long
+    runs<int64_t> (b, Type::long_t, 64, [](Cursor & c_) {
+        return static_cast<int64_t>(readAndNext<double> (c_));
+    });
+}
+
+/******************************************************************************/
+
+/**
+ * Each encoding an array of primitives can hold, packed with enough of
+ * them to go through the block kernels and their tails
+ */
+TEST (Cursor, arrayRuns) { // NOLINT
+    for (size_t count : { 1, 3, 17, 35 }) {
+        for (size_t chunk : { 5, 256 }) {
+            runs<int32_t> (array (0x71, count, 4, [](size_t i) { return -70000 * int64_t (i); }),
+                Type::int_t, chunk, [](Cursor & c_) { return readAndNext<int32_t> (c_); });
+
+            runs<int32_t> (array (0x54, count, 1, [](size_t i) { return 100 - 7 * int64_t (i); }),
+                Type::int_t, chunk, [](Cursor & c_) { return readAndNext<int32_t> (c_); });
+
+            runs<int32_t> (array (0x61, count, 2, [](size_t i) { return -1000 * int64_t (i); }),
+                Type::short_t, chunk, [](Cursor & c_) { return readAndNext<int16_t> (c_); });
+
+            runs<int32_t> (array (0x51, count, 1, [](size_t i) { return 3 * int64_t (i) - 50; }),
+                Type::byte_t, chunk, [](Cursor & c_) { return readAndNext<int8_t> (c_); });
+
+            runs<int64_t> (array (0x81, count, 8, [](size_t i) { return -(int64_t { 1 } << 50) + int64_t (i); }),
+                Type::long_t, chunk, [](Cursor & c_) { return readAndNext<int64_t> (c_); });
+
+            runs<int64_t> (array (0x55, count, 1, [](size_t i) { return 60 - 9 * int64_t (i); }),
+                Type::long_t, chunk, [](Cursor & c_) { return readAndNext<int64_t> (c_); });
+
+            runs<double> (array (0x82, count, 8, [](size_t i) {
+                double d = -1.25 * double (i);
+                uint64_t bits;
+                std::memcpy (&bits, &d, sizeof (bits));
+                return bits;
+            }), Type::double_t, chunk, [](Cursor & c_) { return readAndNext<double> (c_); });
+
+            runs<double> (array (0x72, count, 4, [](size_t i) {
+                float f = 0.5f * float (i) - 3;
+                uint32_t bits;
+                std::memcpy (&bits, &f, sizeof (bits));
+                return bits;
+            }), Type::float_t, chunk, [](Cursor & c_) { return readAndNext<float> (c_); });
+
+            runs<float> (array (0x72, count, 4, [](size_t i) {
+                float f = 0.1f * float (i) - 3;
+                uint32_t bits;
+                std::memcpy (&bits, &f, sizeof (bits));
+                return bits;
+            }), Type::float_t, chunk, [](Cursor & c_) { return readAndNext<float> (c_); });
+
+            runs<bool> (array (0x56, count, 1, [](size_t i) { return i % 3 ? 0 : 1 + i; }),
+                Type::bool_t, chunk, [](Cursor & c_) { return readAndNext<bool> (c_); });
+
+            runs<bool> (array (0x41, count, 0, [](size_t) { return 0; }),
+                Type::bool_t, chunk, [](Cursor & c_) { return readAndNext<bool> (c_); });
+        }
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "amqp/schema/Descriptors.h"
+#include "AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+using namespace amqp::schema::descriptors;
+
+/******************************************************************************/
+
+TEST (DescriptorTable, denseLookup) { // NOLINT
+    const auto & table = amqp::internal::AMQPDescriptorRegistory;
+
+    EXPECT_EQ ("DESCRIBED", table.at (22UL)->symbol());
+    EXPECT_EQ ("ENVELOPE", table.at (DESCRIPTOR_TOP_32BITS | ENVELOPE)->symbol());
+    EXPECT_EQ ("RESTRICTED_TYPE", table.at (DESCRIPTOR_TOP_32BITS | RESTRICTED_TYPE)->symbol());
+    EXPECT_EQ (
+        "TRANSFORM_ELEMENT_KEY",
+        table.at (DESCRIPTOR_TOP_32BITS | TRANSFORM_ELEMENT_KEY)->symbol());
+}
+
+/******************************************************************************/
+
+TEST (DescriptorTable, unknownIdsThrow) { // NOLINT
+    const auto & table = amqp::internal::AMQPDescriptorRegistory;
+
+    // the bottom bits alone, without the Corda enterprise number, aren't ours
+    EXPECT_THROW (table.at (ENVELOPE), std::out_of_range);
+    EXPECT_THROW (table.at (DESCRIPTOR_TOP_32BITS), std::out_of_range);
+    EXPECT_THROW (table.at (DESCRIPTOR_TOP_32BITS | 12), std::out_of_range);
+    EXPECT_THROW (table.at (DESCRIPTOR_TOP_32BITS | 22), std::out_of_range);
+}
+
+/******************************************************************************/
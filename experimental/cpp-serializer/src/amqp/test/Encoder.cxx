@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "decoder/Cursor.h"
+#include "encoder/Encoder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    bytes (std::initializer_list<int> bytes_) {
+        std::string rtn;
+        for (auto b : bytes_) rtn += static_cast<char>(b);
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Encoder, smallestForm) { // NOLINT
+    std::string buffer;
+    encoder::Encoder e (buffer);
+
+    e.putInt (-2);
+    e.putInt (65536);
+    e.putLong (7);
+    e.putUlong (0);
+    e.putBool (true);
+    e.putString ("abc");
+    e.putNull();
+
+    EXPECT_EQ (bytes ({
+        0x54, 0xfe,
+        0x71, 0x00, 0x01, 0x00, 0x00,
+        0x55, 0x07,
+        0x44,
+        0x41,
+        0xa1, 0x03, 'a', 'b', 'c',
+        0x40
+    }), buffer);
+}
+
+/******************************************************************************/
+
+/**
+ * A described value is one element of its list, and lists small enough
+ * are shuffled down into their compact form once closed
+ */
+TEST (Encoder, compactLists) { // NOLINT
+    std::string buffer;
+    encoder::Encoder e (buffer);
+
+    e.beginList();
+    e.putDescriptor (std::string_view ("d"));
+    e.beginList();
+    e.putInt (1);
+    e.endList();
+    e.beginList();
+    e.endList();
+    e.endList();
+
+    EXPECT_EQ (0U, e.depth());
+    EXPECT_EQ (bytes ({
+        0xc0, 0x0b, 0x02,
+            0x00, 0xa3, 0x01, 'd',
+                0xc0, 0x03, 0x01, 0x54, 0x01,
+            0x45
+    }), buffer);
+}
+
+/******************************************************************************/
+
+TEST (Encoder, wideLists) { // NOLINT
+    std::string buffer;
+    encoder::Encoder e (buffer);
+
+    e.beginMap();
+    for (int i { 0 } ; i < 200 ; ++i) {
+        e.putInt (i);
+        e.putInt (1000);
+    }
+    e.endMap();
+
+    decoder::Cursor c (buffer);
+
+    ASSERT_TRUE (c.next());
+    EXPECT_EQ (decoder::Type::map_t, c.type());
+    EXPECT_EQ (400U, c.mapCount());
+    EXPECT_EQ (static_cast<char>(0xd1), buffer[0]);
+
+    decoder::auto_map_enter am (c, true);
+    EXPECT_EQ (0, decoder::readAndNext<int32_t> (c));
+    EXPECT_EQ (1000, decoder::readAndNext<int32_t> (c));
+}
+
+/******************************************************************************/
+
+TEST (Encoder, closingWhatsNotOpen) { // NOLINT
+    std::string buffer;
+    encoder::Encoder e (buffer);
+
+    e.beginList();
+    EXPECT_THROW (e.endMap(), std::logic_error); // NOLINT
+}
+
+/******************************************************************************/
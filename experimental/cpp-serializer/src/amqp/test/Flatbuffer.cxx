@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "columnar/Flatbuffer.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+namespace {
+
+    uint64_t
+    read (const std::string & buffer_, size_t at_, size_t size_) {
+        uint64_t rtn { 0 };
+        for (size_t i { 0 } ; i < size_ ; ++i) {
+            rtn |= static_cast<uint64_t>(static_cast<uint8_t>(buffer_[at_ + i])) << (8 * i);
+        }
+        return rtn;
+    }
+
+    /**
+     * Where field [id_] of the table at [table_] is, or 0 if it's absent
+     */
+    size_t
+    field (const std::string & buffer_, size_t table_, size_t id_) {
+        auto vtable = table_ - static_cast<int32_t>(read (buffer_, table_, 4));
+        auto size = read (buffer_, vtable, 2);
+
+        if (4 + 2 * id_ >= size) return 0;
+
+        auto offset = read (buffer_, vtable + 4 + 2 * id_, 2);
+        return offset ? table_ + offset : 0;
+    }
+
+    size_t
+    follow (const std::string & buffer_, size_t at_) {
+        return at_ + read (buffer_, at_, 4);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Read back as any FlatBuffers reader would, by way of the root offset
+ * and the table's vtable
+ */
+TEST (Flatbuffer, table) { // NOLINT
+    columnar::Flatbuffer fb;
+
+    auto name = fb.string ("hello");
+
+    fb.start();
+    fb.add (0, int16_t { 4 });
+    fb.offset (2, name);
+    fb.add (3, int64_t { -7 });
+    auto buffer = fb.finish (fb.end());
+
+    EXPECT_EQ (0U, buffer.size() % 8);
+
+    auto table = follow (buffer, 0);
+
+    EXPECT_EQ (4U, read (buffer, field (buffer, table, 0), 2));
+    EXPECT_EQ (0U, field (buffer, table, 1));
+    EXPECT_EQ (0U, field (buffer, table, 7));
+
+    auto at = field (buffer, table, 3);
+    EXPECT_EQ (0U, at % 8);
+    EXPECT_EQ (-7, static_cast<int64_t>(read (buffer, at, 8)));
+
+    auto str = follow (buffer, field (buffer, table, 2));
+    EXPECT_EQ (5U, read (buffer, str, 4));
+    EXPECT_EQ ("hello", buffer.substr (str + 4, 5));
+    EXPECT_EQ ('\0', buffer[str + 9]);
+}
+
+/******************************************************************************/
+
+/**
+ * Vectors of tables and of structs, the structs aligned as their widest
+ * member wants
+ */
+TEST (Flatbuffer, vectors) { // NOLINT
+    columnar::Flatbuffer fb;
+
+    std::vector<columnar::Flatbuffer::Offset> tables;
+    for (int32_t i { 0 } ; i < 3 ; ++i) {
+        fb.start();
+        fb.add (0, i);
+        tables.push_back (fb.end());
+    }
+
+    auto ofTables = fb.vector (tables);
+
+    std::string structs;
+    columnar::littleEndian (structs, 1, 8);
+    columnar::littleEndian (structs, 2, 8);
+    auto ofStructs = fb.vector (structs, 1, 8);
+
+    fb.start();
+    fb.offset (0, ofTables);
+    fb.offset (1, ofStructs);
+    auto buffer = fb.finish (fb.end());
+
+    auto root = follow (buffer, 0);
+
+    auto vector = follow (buffer, field (buffer, root, 0));
+    ASSERT_EQ (3U, read (buffer, vector, 4));
+
+    for (size_t i { 0 } ; i < 3 ; ++i) {
+        auto table = follow (buffer, vector + 4 + 4 * i);
+        EXPECT_EQ (i, read (buffer, field (buffer, table, 0), 4));
+    }
+
+    vector = follow (buffer, field (buffer, root, 1));
+    ASSERT_EQ (1U, read (buffer, vector, 4));
+    EXPECT_EQ (0U, (vector + 4) % 8);
+    EXPECT_EQ (1U, read (buffer, vector + 4, 8));
+    EXPECT_EQ (2U, read (buffer, vector + 12, 8));
+}
+
+/******************************************************************************/
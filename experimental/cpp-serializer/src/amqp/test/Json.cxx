@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+#include <cstdlib>
+
+#include "reader/Json.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+TEST (Json, escapes) { // NOLINT
+    EXPECT_EQ (R"("")", json::quote (""));
+    EXPECT_EQ (R"("plain")", json::quote ("plain"));
+    EXPECT_EQ (R"("a \"b\" c")", json::quote (R"(a "b" c)"));
+    EXPECT_EQ (R"("C:\\dir")", json::quote (R"(C:\dir)"));
+    EXPECT_EQ (R"("\b\f\n\r\t")", json::quote ("\b\f\n\r\t"));
+    EXPECT_EQ (R"("\u0000\u001f")", json::quote (std::string ("\0\x1f", 2)));
+
+    // DEL isn't a control character as far as JSON is concerned
+    EXPECT_EQ ("\"\x7f\"", json::quote ("\x7f"));
+}
+
+/******************************************************************************/
+
+/**
+ * Long enough that the escapes fall either side of, and on, the sixteen
+ * byte blocks the clean runs are found in
+ */
+TEST (Json, escapesInBlocks) { // NOLINT
+    for (size_t i { 0 } ; i < 40 ; ++i) {
+        std::string in (40, 'x');
+        in[i] = '"';
+
+        std::string expected = "\"" + std::string (i, 'x') + "\\\""
+            + std::string (39 - i, 'x') + "\"";
+
+        EXPECT_EQ (expected, json::quote (in)) << i;
+    }
+
+    std::string in;
+    std::string expected { "\"" };
+
+    for (int i { 0 } ; i < 64 ; ++i) {
+        in += "0123456789\n";
+        expected += "0123456789\\n";
+    }
+
+    EXPECT_EQ (expected + "\"", json::quote (in));
+}
+
+/******************************************************************************/
+
+TEST (Json, utf8) { // NOLINT
+    // two, three and four byte sequences pass straight through
+    EXPECT_EQ ("\"caf\xc3\xa9\"", json::quote ("caf\xc3\xa9"));
+    EXPECT_EQ ("\"\xe2\x82\xac 5\"", json::quote ("\xe2\x82\xac 5"));
+    EXPECT_EQ ("\"\xf0\x9f\x98\x80\"", json::quote ("\xf0\x9f\x98\x80"));
+    EXPECT_EQ ("\"\xef\xbf\xbf\xf4\x8f\xbf\xbf\"", json::quote ("\xef\xbf\xbf\xf4\x8f\xbf\xbf"));
+
+    // a lone continuation byte and a lead byte that can never appear
+    EXPECT_EQ (R"("a\ufffdb")", json::quote ("a\x80" "b"));
+    EXPECT_EQ (R"("\ufffd")", json::quote ("\xff"));
+
+    // overlong forms of '/' and of U+07FF
+    EXPECT_EQ (R"("\ufffd\ufffd")", json::quote ("\xc0\xaf"));
+    EXPECT_EQ (R"("\ufffd\ufffd\ufffd")", json::quote ("\xe0\x9f\xbf"));
+
+    // a surrogate and something past U+10FFFF
+    EXPECT_EQ (R"("\ufffd\ufffd\ufffd")", json::quote ("\xed\xa0\x80"));
+    EXPECT_EQ (R"("\ufffd\ufffd\ufffd\ufffd")", json::quote ("\xf4\x90\x80\x80"));
+
+    // cut short, both mid string and at its end
+    EXPECT_EQ (R"("\ufffd\ufffdx")", json::quote ("\xe2\x82x"));
+    EXPECT_EQ (R"("x\ufffd")", json::quote ("x\xc3"));
+}
+
+/******************************************************************************/
+
+TEST (Json, valid) { // NOLINT
+    EXPECT_TRUE (json::valid (""));
+    EXPECT_TRUE (json::valid ("plain ASCII, long enough to need two blocks"));
+    EXPECT_TRUE (json::valid ("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"));
+    EXPECT_TRUE (json::valid (std::string ("\0", 1)));
+
+    EXPECT_FALSE (json::valid ("\x80"));
+    EXPECT_FALSE (json::valid ("\xc0\xaf"));
+    EXPECT_FALSE (json::valid ("\xed\xa0\x80"));
+    EXPECT_FALSE (json::valid ("\xf4\x90\x80\x80"));
+    EXPECT_FALSE (json::valid ("sixteen bytes in\xe2\x82"));
+}
+
+/******************************************************************************/
+
+TEST (Json, integers) { // NOLINT
+    EXPECT_EQ ("0", json::number (0));
+    EXPECT_EQ ("-42", json::number (-42));
+    EXPECT_EQ ("-2147483648", json::number (std::numeric_limits<int32_t>::min()));
+    EXPECT_EQ ("-9223372036854775808", json::number (std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ ("-128", json::number (std::numeric_limits<int8_t>::min()));
+}
+
+/******************************************************************************/
+
+TEST (Json, doubles) { // NOLINT
+    EXPECT_EQ ("0.1", json::number (0.1));
+    EXPECT_EQ ("10", json::number (10.0));
+    EXPECT_EQ ("-0", json::number (-0.0));
+    EXPECT_EQ ("1e+300", json::number (1e300));
+    EXPECT_EQ ("5e-324", json::number (std::numeric_limits<double>::denorm_min()));
+
+    // std::to_string would have written this as 0.000000
+    EXPECT_EQ ("1e-07", json::number (1e-7));
+
+    EXPECT_EQ (R"("NaN")", json::number (std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ (R"("Infinity")", json::number (std::numeric_limits<double>::infinity()));
+    EXPECT_EQ (R"("-Infinity")", json::number (-std::numeric_limits<double>::infinity()));
+
+    for (double d : { 0.1, 1.0 / 3.0, 2.5e-310, 123456789.123456789,
+                      std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::min() }) {
+        EXPECT_EQ (d, std::strtod (json::number (d).c_str(), nullptr));
+    }
+}
+
+/******************************************************************************/
+
+TEST (Json, floats) { // NOLINT
+    // not 0.10000000149011612, the double 0.1f widens to
+    EXPECT_EQ ("0.1", json::number (0.1f));
+    EXPECT_EQ ("-2.5", json::number (-2.5f));
+    EXPECT_EQ ("3.4028235e+38", json::number (std::numeric_limits<float>::max()));
+    EXPECT_EQ ("1e-45", json::number (std::numeric_limits<float>::denorm_min()));
+
+    EXPECT_EQ (R"("NaN")", json::number (std::numeric_limits<float>::quiet_NaN()));
+    EXPECT_EQ (R"("-Infinity")", json::number (-std::numeric_limits<float>::infinity()));
+
+    for (float f : { 0.1f, 1.0f / 3.0f, 16777217.0f, std::numeric_limits<float>::min() }) {
+        EXPECT_EQ (f, std::strtof (json::number (f).c_str(), nullptr));
+    }
+}
+
+/******************************************************************************/
@@ -43,7 +43,11 @@ namespace {
                 return 0;
             }
 
-            const std::string & name() const { return m_name; }
+            const std::string & name() const override { return m_name; }
+
+            void dependencies (std::vector<std::string_view> & names_) const override {
+                names_.insert (names_.end(), m_dependsOn.begin(), m_dependsOn.end());
+            }
 
             decltype(m_dependsOn.cbegin()) begin() const {
                 return m_dependsOn.cbegin();
@@ -69,15 +73,13 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<OTN> &otn_
 ) {
     auto first { true };
-    for (const auto & i : otn_.m_schemas) {
-        for (const auto & j : i) {
-            if (first) {
-                first = false;
-            } else {
-                stream_ << " ";
-            }
-            stream_ << j->name();
+    for (const auto & i : otn_.types()) {
+        if (first) {
+            first = false;
+        } else {
+            stream_ << " ";
         }
+        stream_ << i->name();
     }
 
     return stream_;
@@ -114,11 +116,9 @@ TEST (OTNTest, twoInserts) { // NOLINT
     list.insert(std::make_unique<OTN>("A", std::vector<std::string>()));
     list.insert(std::make_unique<OTN>("B", std::vector<std::string>()));
 
-    // Inserting B after A with no dependencies between the two will force
-    // B to be recorded before A since elements added at the same
-    // level are always added to the front of the list to ensrue we can
-    // inspect the rest of that level
-    ASSERT_EQ ("B A", str (list));
+    // With no dependencies between the two they share a level and so
+    // keep the order they were inserted in
+    ASSERT_EQ ("A B", str (list));
 }
 
 /******************************************************************************/
@@ -129,7 +129,7 @@ TEST (OTNTest, A_depends_on_B) { // NOLINT
     std::vector<std::string> aDeps = { "B" };
     list.insert(std::make_unique<OTN>("A", aDeps));
     list.insert(std::make_unique<OTN>("B", std::vector<std::string>()));
-    ASSERT_EQ("A B", str (list));
+    ASSERT_EQ("B A", str (list));
 }
 
 /******************************************************************************/
@@ -143,7 +143,7 @@ TEST (OTNTest, B_depends_on_A) { // NOLINT
     list.insert(std::make_unique<OTN>("A", aDeps));
     list.insert(std::make_unique<OTN>("B", bDeps));
 
-    ASSERT_EQ ("B A", str (list));
+    ASSERT_EQ ("A B", str (list));
 }
 
 /******************************************************************************/
@@ -159,7 +159,7 @@ TEST (OTNTest, three_1) { // NOLINT
     list.insert(std::make_unique<OTN>("B", bDeps));
     list.insert(std::make_unique<OTN>("C", cDeps));
 
-    ASSERT_EQ ("B C A", str (list));
+    ASSERT_EQ ("A B C", str (list));
 }
 
 /******************************************************************************/
@@ -175,7 +175,7 @@ TEST (OTNTest, three_2) { // NOLINT
     list.insert(std::make_unique<OTN>("B", bDeps));
     list.insert(std::make_unique<OTN>("C", cDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
 }
 
 /******************************************************************************/
@@ -191,7 +191,7 @@ TEST (OTNTest, three_3) { // NOLINT
     list.insert(std::make_unique<OTN>("A", aDeps));
     list.insert(std::make_unique<OTN>("B", bDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
 }
 
 /******************************************************************************/
@@ -207,7 +207,7 @@ TEST (OTNTest, three_4) { // NOLINT
     list.insert(std::make_unique<OTN>("B", bDeps));
     list.insert(std::make_unique<OTN>("A", aDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
 }
 
 /******************************************************************************/
@@ -223,7 +223,42 @@ TEST (OTNTest, three_5) { // NOLINT
     list.insert(std::make_unique<OTN>("C", cDeps));
     list.insert(std::make_unique<OTN>("A", aDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
+}
+
+/******************************************************************************/
+
+TEST (OTNTest, levels) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    // D is as deep as the longest chain beneath it, not the shortest
+    list.insert(std::make_unique<OTN>("D", std::vector<std::string> { "A", "C" }));
+    list.insert(std::make_unique<OTN>("C", std::vector<std::string> { "B" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "A", "int" }));
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "A" }));
+    list.insert(std::make_unique<OTN>("E", std::vector<std::string> { }));
+
+    EXPECT_EQ ("A E B C D", str (list));
+
+    std::vector<size_t> sizes;
+    for (const auto & level : list) {
+        sizes.push_back (level.size());
+    }
+
+    EXPECT_EQ ((std::vector<size_t> { 2, 1, 1, 1 }), sizes);
+}
+
+/******************************************************************************/
+
+TEST (OTNTest, cycle) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "B" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "A" }));
+    list.insert(std::make_unique<OTN>("C", std::vector<std::string> { }));
+
+    // nothing can order the cycle so it's left in a final level
+    EXPECT_EQ ("C A B", str (list));
 }
 
 /******************************************************************************/
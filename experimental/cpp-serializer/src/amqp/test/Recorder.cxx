@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "reader/Sink.h"
+#include "reader/Recorder.h"
+#include "reader/JsonVisitor.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+/**
+ * An object replays as it was first visited, runs longer than the
+ * buffer they're replayed through included, and one holding a replayed
+ * object replays that too
+ */
+TEST (Recorder, replay) { // NOLINT
+    std::string out;
+    StringSink sink (out);
+    JsonVisitor json (sink);
+    Recorder recorder (json);
+
+    EXPECT_EQ (&recorder, Recorder::of (recorder));
+    EXPECT_EQ (nullptr, Recorder::of (json));
+
+    std::vector<int64_t> run (300);
+    for (size_t i { 0 } ; i < run.size() ; ++i) run[i] = static_cast<int64_t>(i) * 3;
+
+    EXPECT_FALSE (recorder.replay (0));
+
+    recorder.startList();
+
+    auto first = recorder.events();
+    recorder.startObject();
+    recorder.field ("a");
+    recorder.values (run.data(), run.size());
+    recorder.field ("b");
+    recorder.value (std::string_view ("bee"));
+    recorder.field ("c");
+    recorder.value (0.5);
+    recorder.endObject();
+    recorder.remember (0, first);
+
+    const auto once = out;
+
+    first = recorder.events();
+    recorder.startList();
+    EXPECT_TRUE (recorder.replay (0));
+    recorder.endList();
+    recorder.remember (2, first);
+
+    EXPECT_FALSE (recorder.replay (1));
+    EXPECT_TRUE (recorder.replay (2));
+
+    recorder.endList();
+
+    std::string object = once.substr (2);
+
+    EXPECT_EQ ("[ " + object + ", [ " + object + " ], [ " + object + " ] ]", out);
+}
+
+/******************************************************************************/
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "decoder/Scalars.h"
+#include "encoder/Encoder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::decoder;
+
+/******************************************************************************/
+
+TEST (Scalars, chars) { // NOLINT
+    EXPECT_EQ ("a", text (U'a').view());
+    EXPECT_EQ ("\xc3\xa9", text (U'é').view());
+    EXPECT_EQ ("\xe2\x82\xac", text (U'€').view());
+    EXPECT_EQ ("\xf0\x9f\x98\x80", text (U'\U0001f600').view());
+
+    // lone surrogates and anything past the last code point
+    EXPECT_EQ ("\xef\xbf\xbd", text (static_cast<char32_t>(0xd800)).view());
+    EXPECT_EQ ("\xef\xbf\xbd", text (static_cast<char32_t>(0x110000)).view());
+}
+
+/******************************************************************************/
+
+TEST (Scalars, uuids) { // NOLINT
+    Uuid uuid { {
+        0x12, 0x3e, 0x45, 0x67, 0xe8, 0x9b, 0x12, 0xd3,
+        0xa4, 0x56, 0x42, 0x66, 0x14, 0x17, 0x40, 0x00 } };
+
+    EXPECT_EQ ("123e4567-e89b-12d3-a456-426614174000", text (uuid).view());
+}
+
+/******************************************************************************/
+
+/**
+ * As BigDecimal.toString writes them
+ */
+TEST (Scalars, decimals) { // NOLINT
+    auto d32 = [](uint32_t bits_) {
+        return std::string (text (Decimal { Type::decimal32_t, 0, bits_ }).view());
+    };
+
+    auto d64 = [](uint64_t bits_) {
+        return std::string (text (Decimal { Type::decimal64_t, 0, bits_ }).view());
+    };
+
+    // the exponent biased by 101 above the sign, the coefficient below it
+    EXPECT_EQ ("7", d32 ((101u << 23u) | 7u));
+    EXPECT_EQ ("-1.25", d32 (0x80000000u | (99u << 23u) | 125u));
+    EXPECT_EQ ("0.000123", d32 ((95u << 23u) | 123u));
+    EXPECT_EQ ("1.23E-7", d32 ((92u << 23u) | 123u));
+    EXPECT_EQ ("1.2E+3", d32 ((103u << 23u) | 12u));
+    EXPECT_EQ ("0", d32 (101u << 23u));
+    EXPECT_EQ ("0.00", d32 (99u << 23u));
+
+    // 9999999, the largest coefficient, needs the implicit 100 prefix
+    EXPECT_EQ ("9999999", d32 (0x60000000u | (101u << 21u) | (9999999u & 0x1fffffu)));
+
+    EXPECT_EQ ("Infinity", d32 (0x78000000u));
+    EXPECT_EQ ("-Infinity", d32 (0xf8000000u));
+    EXPECT_EQ ("NaN", d32 (0x7c000000u));
+
+    EXPECT_EQ ("3.14159", d64 ((uint64_t { 393 } << 53u) | 314159u));
+
+    // decimal128 1E-2 as the JVM writes BigDecimal 0.01
+    EXPECT_EQ ("0.01", std::string (text (Decimal {
+        Type::decimal128_t, uint64_t { 6174 } << 49u, 1 }).view()));
+
+    EXPECT_EQ ("0", std::string (text (Decimal { Type::null_t, 0, 0 }).view()));
+}
+
+/******************************************************************************/
+
+/**
+ * Each reads back what the encoder wrote
+ */
+TEST (Scalars, readAndNext) { // NOLINT
+    std::string b;
+    encoder::Encoder e (b);
+
+    Uuid uuid { { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 } };
+
+    e.putTimestamp (-1234567);
+    e.putUuid (uuid.m_bytes);
+    e.putDecimal32 (0x32800007u);
+    e.putDecimal128 (0x3040000000000000u, 42);
+    e.putBinary (std::string ("\x00\x01\xff", 3));
+    e.putNull();
+
+    Cursor c (b);
+    c.next();
+
+    EXPECT_EQ (-1234567, readAndNext<Timestamp> (c).time_since_epoch().count());
+    EXPECT_EQ (uuid, readAndNext<Uuid> (c));
+    EXPECT_EQ ((Decimal { Type::decimal32_t, 0, 0x32800007u }), readAndNext<Decimal> (c));
+    EXPECT_EQ ((Decimal { Type::decimal128_t, 0x3040000000000000u, 42 }), readAndNext<Decimal> (c));
+    EXPECT_EQ ("0001ff", hex (readAndNext<Binary> (c).m_bytes));
+    EXPECT_EQ ((Decimal { Type::null_t, 0, 0 }), readAndNext<Decimal> (c));
+}
+
+/******************************************************************************/
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include <unistd.h>
+
+#include "Reader.h"
+#include "Sink.h"
+
+/******************************************************************************/
+
+using namespace amqp::reader;
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * { a : [ 1, 2 ], b : { x : str } }
+     */
+    uPtr<IValue>
+    nested() {
+        sList<uPtr<IValue>> list;
+        list.emplace_back (std::make_unique<TypedSingle<int>> (1));
+        list.emplace_back (std::make_unique<TypedSingle<int>> (2));
+
+        sVec<uPtr<IValue>> inner;
+        inner.emplace_back (std::make_unique<TypedPair<std::string>> ("x", "str"));
+
+        sVec<uPtr<IValue>> outer;
+        outer.emplace_back (
+            std::make_unique<TypedPair<sList<uPtr<IValue>>>> ("a", std::move (list)));
+        outer.emplace_back (
+            std::make_unique<TypedPair<sVec<uPtr<IValue>>>> ("b", std::move (inner)));
+
+        return std::make_unique<TypedSingle<sVec<uPtr<IValue>>>> (std::move (outer));
+    }
+
+    std::string
+    contents (FILE * file_) {
+        std::rewind (file_);
+
+        std::string rtn;
+        char buffer[256];
+
+        for (size_t n ; (n = std::fread (buffer, 1, sizeof (buffer), file_)) > 0 ; ) {
+            rtn.append (buffer, n);
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Sink, string) { // NOLINT
+    auto value = nested();
+
+    std::string out { "prefix " };
+    StringSink sink (out);
+    value->dump (sink);
+
+    EXPECT_EQ ("prefix { a : [ 1, 2 ], b : { x : str } }", out);
+    EXPECT_EQ ("{ a : [ 1, 2 ], b : { x : str } }", value->dump());
+}
+
+/******************************************************************************/
+
+TEST (Sink, file) { // NOLINT
+    auto value = nested();
+    auto file = std::tmpfile();
+    ASSERT_NE (nullptr, file);
+
+    {
+        FileSink sink (file);
+        value->dump (sink);
+    }
+
+    EXPECT_EQ (value->dump(), contents (file));
+
+    std::fclose (file);
+}
+
+/******************************************************************************/
+
+TEST (Sink, fd) { // NOLINT
+    auto value = nested();
+    auto file = std::tmpfile();
+    ASSERT_NE (nullptr, file);
+
+    std::string big (100 * 1024, 'x');
+
+    {
+        FdSink sink (fileno (file));
+        value->dump (sink);
+
+        // larger than the internal buffer, written straight through
+        sink << big;
+        value->dump (sink);
+    }
+
+    EXPECT_EQ (value->dump() + big + value->dump(), contents (file));
+
+    std::fclose (file);
+}
+
+/******************************************************************************/
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "SymbolTable.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+TEST (SymbolTable, internsOnce) { // NOLINT
+    SymbolTable<int> table;
+
+    auto a = table.intern ("net.corda:abc==", 1);
+    auto b = table.intern (std::string ("net.corda:abc=="), 2);
+
+    // same symbol, same storage, first value wins
+    EXPECT_EQ (a.data(), b.data());
+    EXPECT_EQ (1UL, table.size());
+    EXPECT_EQ (1, *table.find ("net.corda:abc=="));
+}
+
+/******************************************************************************/
+
+TEST (SymbolTable, findByView) { // NOLINT
+    SymbolTable<size_t> table;
+
+    // enough to force the table to grow a few times
+    for (size_t i { 0 } ; i < 100 ; ++i) {
+        table.intern ("net.corda:" + std::to_string (i), i);
+    }
+
+    EXPECT_EQ (100UL, table.size());
+
+    // a view into a larger buffer, as we'd get from an encoded blob
+    std::string blob { "xxnet.corda:42yy" };
+    std::string_view symbol { blob.data() + 2, 12 };
+
+    ASSERT_NE (nullptr, table.find (symbol));
+    EXPECT_EQ (42UL, *table.find (symbol));
+
+    for (size_t i { 0 } ; i < 100 ; ++i) {
+        EXPECT_EQ (i, *table.find ("net.corda:" + std::to_string (i)));
+    }
+
+    EXPECT_EQ (nullptr, table.find ("net.corda:100"));
+    EXPECT_EQ (nullptr, table.find ("net.corda"));
+    EXPECT_EQ (nullptr, table.find (""));
+}
+
+/******************************************************************************/
@@ -312,6 +312,31 @@ readAndNext<std::string> (
 
 /******************************************************************************/
 
+template<>
+std::string_view
+proton::
+readAndNext<std::string_view> (
+    pn_data_t * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    if (pn_data_type(data_) == PN_STRING) {
+        auto str = pn_data_get_string(data_);
+        return std::string_view (str.start, str.size);
+    } else if (pn_data_type(data_) == PN_SYMBOL) {
+        auto symbol = pn_data_get_symbol(data_);
+        return std::string_view (symbol.start, symbol.size);
+    } else  if (tolerateDeviance_ && pn_data_type(data_) == PN_NULL) {
+        return { };
+    }
+    std::stringstream ss;
+    ss << "Expected a String but found [" << data_ << "]";
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
+
 template<>
 bool
 proton::
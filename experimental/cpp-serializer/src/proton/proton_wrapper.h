@@ -4,6 +4,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 
 #include <proton/types.h>
 #include <proton/codec.h>
@@ -39,6 +40,16 @@ namespace proton {
         return T {};
     }
 
+    /*
+     * The specialisations must be visible at the call site, otherwise an
+     * optimising compiler is free to inline the default above
+     */
+    template<>
+    std::string get_symbol<std::string> (pn_data_t *);
+
+    template<>
+    pn_bytes_t get_symbol<pn_bytes_t> (pn_data_t *);
+
     std::string get_symbol (pn_data_t *);
 
     bool get_boolean (pn_data_t *);
@@ -104,6 +115,31 @@ namespace proton {
         return T{};
     }
 
+    template<>
+    int32_t readAndNext<int32_t> (pn_data_t *, bool);
+
+    template<>
+    std::string readAndNext<std::string> (pn_data_t *, bool);
+
+    /**
+     * A view onto the string or symbol held by the tree, only valid for
+     * as long as the tree is
+     */
+    template<>
+    std::string_view readAndNext<std::string_view> (pn_data_t *, bool);
+
+    template<>
+    bool readAndNext<bool> (pn_data_t *, bool);
+
+    template<>
+    double readAndNext<double> (pn_data_t *, bool);
+
+    template<>
+    long readAndNext<long> (pn_data_t *, bool);
+
+    template<>
+    u_long readAndNext<u_long> (pn_data_t *, bool);
+
 }
 
 /******************************************************************************/